@@ -4017,6 +4017,15 @@ const infomap videoplayer[] =    {{ "title",            VIDEOPLAYER_TITLE },
 ///     @skinning_v18 **[New Infolabel]** \link RetroPlayer_VideoRotation `RetroPlayer.VideoRotation`\endlink
 ///     <p>
 ///   }
+///   \table_row3{   <b>`RetroPlayer.SavestateStats`</b>,
+///                  \anchor RetroPlayer_SavestateStats
+///                  _string_,
+///     @return The time it took to create the last savestate of the
+///     currently-playing game, or empty if none was created yet.
+///     <p><hr>
+///     @skinning_v21 **[New Infolabel]** \link RetroPlayer_SavestateStats `RetroPlayer.SavestateStats`\endlink
+///     <p>
+///   }
 /// \table_end
 ///
 /// -----------------------------------------------------------------------------
@@ -4025,6 +4034,7 @@ const infomap retroplayer[] =
   { "videofilter",            RETROPLAYER_VIDEO_FILTER},
   { "stretchmode",            RETROPLAYER_STRETCH_MODE},
   { "videorotation",          RETROPLAYER_VIDEO_ROTATION},
+  { "savestatestats",         RETROPLAYER_SAVESTATE_STATS},
 };
 
 /// \page modules__infolabels_boolean_conditions
@@ -377,6 +377,22 @@ std::shared_ptr<CTextureCache> CServiceBroker::GetTextureCache()
   return g_serviceBroker.m_textureCache;
 }
 
+void CServiceBroker::RegisterContentChangeJournal(
+    const std::shared_ptr<CContentChangeJournal>& journal)
+{
+  g_serviceBroker.m_contentChangeJournal = journal;
+}
+
+void CServiceBroker::UnregisterContentChangeJournal()
+{
+  g_serviceBroker.m_contentChangeJournal.reset();
+}
+
+std::shared_ptr<CContentChangeJournal> CServiceBroker::GetContentChangeJournal()
+{
+  return g_serviceBroker.m_contentChangeJournal;
+}
+
 void CServiceBroker::RegisterJobManager(const std::shared_ptr<CJobManager>& jobManager)
 {
   g_serviceBroker.m_jobManager = jobManager;
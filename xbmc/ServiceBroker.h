@@ -78,6 +78,7 @@ class CCPUInfo;
 class CLog;
 class CPlatform;
 class CTextureCache;
+class CContentChangeJournal;
 class CJobManager;
 class CKeyboardLayoutManager;
 
@@ -200,6 +201,10 @@ public:
   static void UnregisterTextureCache();
   static std::shared_ptr<CTextureCache> GetTextureCache();
 
+  static void RegisterContentChangeJournal(const std::shared_ptr<CContentChangeJournal>& journal);
+  static void UnregisterContentChangeJournal();
+  static std::shared_ptr<CContentChangeJournal> GetContentChangeJournal();
+
   static void RegisterJobManager(const std::shared_ptr<CJobManager>& jobManager);
   static void UnregisterJobManager();
   static std::shared_ptr<CJobManager> GetJobManager();
@@ -231,6 +236,7 @@ private:
   CDecoderFilterManager* m_decoderFilterManager;
   std::shared_ptr<CCPUInfo> m_cpuInfo;
   std::shared_ptr<CTextureCache> m_textureCache;
+  std::shared_ptr<CContentChangeJournal> m_contentChangeJournal;
   std::shared_ptr<CJobManager> m_jobManager;
   std::shared_ptr<KODI::MESSAGING::CApplicationMessenger> m_appMessenger;
   std::shared_ptr<CKeyboardLayoutManager> m_keyboardLayoutManager;
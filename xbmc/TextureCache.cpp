@@ -165,16 +165,8 @@ std::string CTextureCache::CacheImage(const std::string& image,
   }
   lock.unlock();
 
-  // wait for currently processing job to end.
-  while (true)
-  {
-    m_completeEvent.Wait(1000ms);
-    {
-      std::unique_lock<CCriticalSection> lock(m_processingSection);
-      if (m_processinglist.find(url) == m_processinglist.end())
-        break;
-    }
-  }
+  WaitForCaching(url);
+
   CTextureDetails tempDetails;
   if (!details)
     details = &tempDetails;
@@ -194,6 +186,54 @@ std::string CTextureCache::CacheImage(const std::string& image,
   return cachedpath;
 }
 
+std::string CTextureCache::CacheResizedImage(const std::string& image, const std::string& format)
+{
+  if (image.empty())
+    return "";
+
+  // resized images are stored in the format of the original image rather than the one of the
+  // textures cached for the GUI, so the format is part of the key
+  CURL url(image);
+  url.SetOption("format", format);
+  const std::string key = url.Get();
+
+  CTextureDetails details;
+  std::string path = GetCachedImage(key, details, true);
+  if (!path.empty() && details.hash.empty())
+  {
+    UpdateResizedImageStats(key, true, 0ms);
+    return path;
+  }
+
+  std::unique_lock<CCriticalSection> lock(m_processingSection);
+  if (m_processinglist.find(key) != m_processinglist.end())
+  {
+    lock.unlock();
+
+    // another request of the same image is resizing it
+    WaitForCaching(key);
+    path = GetCachedImage(key, details);
+    UpdateResizedImageStats(key, !path.empty(), 0ms);
+    return path;
+  }
+  m_processinglist.insert(key);
+  lock.unlock();
+
+  const auto start = std::chrono::steady_clock::now();
+
+  // resize the image unless it didn't change since it was resized
+  CTextureCacheJob job(key, details.hash);
+  bool success = job.CacheResizedTexture();
+  OnCachingComplete(success, &job);
+
+  const bool unchanged = success && job.m_details.hash == details.hash;
+  UpdateResizedImageStats(key, unchanged,
+                          std::chrono::duration_cast<std::chrono::milliseconds>(
+                              std::chrono::steady_clock::now() - start));
+
+  return success ? GetCachedPath(job.m_details.file) : "";
+}
+
 bool CTextureCache::CacheImage(const std::string &image, CTextureDetails &details)
 {
   std::string path = GetCachedImage(image, details);
@@ -291,6 +331,39 @@ std::string CTextureCache::GetCachedPath(const std::string &file)
   return URIUtils::AddFileToFolder(profileManager->GetThumbnailsFolder(), file);
 }
 
+void CTextureCache::WaitForCaching(const std::string& url)
+{
+  // wait for currently processing job to end.
+  while (true)
+  {
+    m_completeEvent.Wait(1000ms);
+    {
+      std::unique_lock<CCriticalSection> lock(m_processingSection);
+      if (m_processinglist.find(url) == m_processinglist.end())
+        break;
+    }
+  }
+}
+
+void CTextureCache::UpdateResizedImageStats(const std::string& image,
+                                            bool cached,
+                                            std::chrono::milliseconds duration)
+{
+  std::unique_lock<CCriticalSection> lock(m_processingSection);
+  m_resizedImageRequests++;
+  if (cached)
+  {
+    m_resizedImageHits++;
+    return;
+  }
+
+  CLog::Log(LOGDEBUG,
+            "CTextureCache::{} - Resized '{}' in {} ms, {} of {} resized images served from the "
+            "cache ({:.1f}%)",
+            __FUNCTION__, CURL::GetRedacted(image), duration.count(), m_resizedImageHits,
+            m_resizedImageRequests, 100.0 * m_resizedImageHits / m_resizedImageRequests);
+}
+
 void CTextureCache::OnCachingComplete(bool success, CTextureCacheJob *job)
 {
   if (success)
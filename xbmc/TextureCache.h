@@ -14,6 +14,7 @@
 #include "threads/Event.h"
 #include "utils/JobManager.h"
 
+#include <chrono>
 #include <memory>
 #include <set>
 #include <string>
@@ -103,6 +104,15 @@ public:
    */
   bool CacheImage(const std::string &image, CTextureDetails &details);
 
+  /*! \brief Resize an image and cache it, if not already cached, for serving it to web clients.
+   Concurrent requests of the same resized image wait for a single resize.
+   \param image url of the image with the width, height and scaling algorithm options.
+   \param format extension of the format of the original image, used for the resized image.
+   \return cached url of the resized image, empty if it couldn't be resized.
+   \sa CTextureCacheJob::CacheResizedTexture
+   */
+  std::string CacheResizedImage(const std::string& image, const std::string& format);
+
   /*! \brief Check whether an image is in the cache
    Note: If the image url won't normally be cached (eg a skin image) this function will return false.
    \param image url of the image
@@ -211,6 +221,20 @@ private:
 
   void OnJobComplete(unsigned int jobID, bool success, CJob *job) override;
 
+  /*! \brief Wait for the image in the processing list to be cached.
+   \param url url of the image
+   */
+  void WaitForCaching(const std::string& url);
+
+  /*! \brief Count a request of a resized image and log the hit rate after resizing it.
+   \param image url of the resized image
+   \param cached whether the resized image was served from the cache
+   \param duration how long resizing the image took
+   */
+  void UpdateResizedImageStats(const std::string& image,
+                               bool cached,
+                               std::chrono::milliseconds duration);
+
   /*! \brief Called when a caching job has completed.
    Removes the job from our processing list, updates the database
    and fires a DDS job if appropriate.
@@ -224,6 +248,8 @@ private:
   std::set<std::string> m_processinglist; ///< currently processing list to avoid 2 jobs being processed at once
   CCriticalSection     m_processingSection;
   CEvent               m_completeEvent; ///< Set whenever a job has finished
+  uint64_t m_resizedImageRequests = 0; ///< Requests of resized images, see CacheResizedImage
+  uint64_t m_resizedImageHits = 0; ///< Resized images served from the cache
   std::vector<CTextureDetails> m_useCounts; ///< Use count tracking
   CCriticalSection             m_useCountSection;
 };
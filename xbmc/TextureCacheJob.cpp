@@ -137,6 +137,55 @@ bool CTextureCacheJob::ResizeTexture(const std::string &url, uint8_t* &result, s
   return success;
 }
 
+bool CTextureCacheJob::CacheResizedTexture()
+{
+  // unwrap the URL as required
+  std::string additional_info;
+  unsigned int width, height;
+  CPictureScalingAlgorithm::Algorithm scalingAlgorithm;
+  std::string image = DecodeImageURL(m_url, width, height, scalingAlgorithm, additional_info);
+  if (image.empty())
+    return false;
+
+  m_details.updateable = additional_info != "music" && UpdateableURL(image);
+
+  const std::string format = CURL(m_url).GetOption("format");
+  m_details.file = format.empty() ? m_cachePath : m_cachePath + "." + format;
+
+  // generate the hash
+  m_details.hash = GetImageHash(image);
+  if (m_details.hash.empty())
+    return false;
+  else if (m_details.hash == m_oldHash)
+    return true;
+
+  std::unique_ptr<CTexture> texture = LoadImage(image, width, height, additional_info, true);
+  if (texture == NULL)
+    return false;
+
+  uint8_t* result = NULL;
+  size_t result_size = 0;
+  if (!CPicture::ResizeTexture(image, texture.get(), width, height, result, result_size,
+                               scalingAlgorithm))
+    return false;
+
+  CLog::Log(LOGDEBUG, "Caching resized image '{}' to '{}'", CURL::GetRedacted(image),
+            m_details.file);
+
+  XFILE::CFile file;
+  bool success = file.OpenForWrite(CTextureCache::GetCachedPath(m_details.file), true) &&
+                 file.Write(result, result_size) == static_cast<ssize_t>(result_size);
+  file.Close();
+  delete[] result;
+
+  if (!success)
+    return false;
+
+  m_details.width = width;
+  m_details.height = height;
+  return true;
+}
+
 std::string CTextureCacheJob::DecodeImageURL(const std::string &url, unsigned int &width, unsigned int &height, CPictureScalingAlgorithm::Algorithm& scalingAlgorithm, std::string &additional_info)
 {
   // unwrap the URL as required
@@ -71,6 +71,15 @@ public:
 
   static bool ResizeTexture(const std::string &url, uint8_t* &result, size_t &result_size);
 
+  /*! \brief Resize an image and store it in the image cache
+   Unlike CacheTexture the image is resized like ResizeTexture does, i.e. it isn't limited
+   to the resolution of the GUI, and stored in the format given by the "format" option of
+   the URL.
+   \return true if the image was resized or didn't change since it was resized
+   \sa ResizeTexture, CTextureCache::CacheResizedImage
+   */
+  bool CacheResizedTexture();
+
   std::string m_url;
   std::string m_oldHash;
   CTextureDetails m_details;
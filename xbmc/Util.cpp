@@ -392,7 +392,7 @@ void CUtil::CleanString(const std::string& strFileName,
   CRegExp reTags(true, CRegExp::autoUtf8);
   CRegExp reYear(false, CRegExp::autoUtf8);
 
-  if (!reYear.RegComp(advancedSettings->m_videoCleanDateTimeRegExp))
+  if (!reYear.RegComp(advancedSettings->m_videoCleanDateTimeRegExp, CRegExp::StudyWithJitComp))
   {
     CLog::Log(LOGERROR, "{}: Invalid datetime clean RegExp:'{}'", __FUNCTION__,
               advancedSettings->m_videoCleanDateTimeRegExp);
@@ -410,7 +410,7 @@ void CUtil::CleanString(const std::string& strFileName,
 
   for (const auto &regexp : regexps)
   {
-    if (!reTags.RegComp(regexp.c_str()))
+    if (!reTags.RegComp(regexp, CRegExp::StudyWithJitComp))
     { // invalid regexp - complain in logs
       CLog::Log(LOGERROR, "{}: Invalid string clean RegExp:'{}'", __FUNCTION__, regexp);
       continue;
@@ -530,7 +530,7 @@ bool CUtil::ExcludeFileOrFolder(const std::string& strFileOrFolder, const std::v
 
   for (const auto &regexp : regexps)
   {
-    if (!regExExcludes.RegComp(regexp.c_str()))
+    if (!regExExcludes.RegComp(regexp, CRegExp::StudyWithJitComp))
     { // invalid regexp - complain in logs
       CLog::Log(LOGERROR, "{}: Invalid exclude RegExp:'{}'", __FUNCTION__, regexp);
       continue;
@@ -55,6 +55,7 @@
 #include "platform/Environment.h"
 #include "playlists/PlayListFactory.h"
 #include "threads/SystemClock.h"
+#include "utils/ContentChangeJournal.h"
 #include "utils/ContentUtils.h"
 #include "utils/JobManager.h"
 #include "utils/LangCodeExpander.h"
@@ -98,6 +99,7 @@
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
 #include "speech/ISpeechRecognition.h"
+#include "threads/LockStatistics.h"
 #include "threads/SingleLock.h"
 #include "utils/CPUInfo.h"
 #include "utils/FileExtensionProvider.h"
@@ -353,6 +355,11 @@ bool CApplication::Create()
   // Register JobManager service
   CServiceBroker::RegisterJobManager(std::make_shared<CJobManager>());
 
+  // Content change journal of the library scanners
+  const auto contentChangeJournal = std::make_shared<CContentChangeJournal>();
+  contentChangeJournal->Start();
+  CServiceBroker::RegisterContentChangeJournal(contentChangeJournal);
+
   // Announcement service
   m_pAnnouncementManager = std::make_shared<ANNOUNCEMENT::CAnnouncementManager>();
   m_pAnnouncementManager->Start();
@@ -2044,6 +2051,10 @@ bool CApplication::Cleanup()
     m_pAnnouncementManager->Deinitialize();
     m_pAnnouncementManager.reset();
 
+    if (const auto contentChangeJournal = CServiceBroker::GetContentChangeJournal())
+      contentChangeJournal->Stop();
+    CServiceBroker::UnregisterContentChangeJournal();
+
     CServiceBroker::UnregisterJobManager();
     CServiceBroker::UnregisterCPUInfo();
 
@@ -3149,6 +3160,9 @@ void CApplication::ProcessSlow()
 
   CServiceBroker::GetPowerManager().ProcessEvents();
 
+  // log lock contention statistics, if enabled
+  XbmcThreads::CLockStatistics::Process();
+
 #if defined(TARGET_DARWIN_OSX) && defined(SDL_FOUND)
   // There is an issue on OS X that several system services ask the cursor to become visible
   // during their startup routines.  Given that we can't control this, we hack it in by
@@ -289,6 +289,8 @@ CActiveAE::CActiveAE() :
   m_streamIdGen = 0;
 
   m_settingsHandler.reset(new CActiveAESettings(*this));
+
+  SetRole(ThreadRole::REALTIME);
 }
 
 CActiveAE::~CActiveAE()
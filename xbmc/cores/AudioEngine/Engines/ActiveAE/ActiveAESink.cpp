@@ -36,6 +36,8 @@ CActiveAESink::CActiveAESink(CEvent *inMsgEvent) :
   m_volume = 0.0;
   m_packer = nullptr;
   m_streamNoise = true;
+
+  SetRole(ThreadRole::REALTIME);
 }
 
 CActiveAESink::~CActiveAESink() = default;
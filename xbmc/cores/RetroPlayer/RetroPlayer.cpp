@@ -552,6 +552,14 @@ void CRetroPlayer::FreeSavestateResources(const std::string& savestatePath)
     m_renderManager->ClearVideoFrame(savestatePath);
 }
 
+std::string CRetroPlayer::GetSavestateStats() const
+{
+  if (m_playback)
+    return m_playback->GetSavestateStats();
+
+  return "";
+}
+
 void CRetroPlayer::CloseOSDCallback()
 {
   CloseOSD();
@@ -621,7 +629,7 @@ void CRetroPlayer::CreatePlayback(const std::string& savestatePath)
   {
     m_playback->Deinitialize();
     m_playback = std::make_unique<CReversiblePlayback>(
-        m_gameClient.get(), *m_renderManager, m_cheevos.get(), *m_guiMessenger,
+        m_gameClient.get(), *m_renderManager, *m_streamManager, m_cheevos.get(), *m_guiMessenger,
         m_gameClient->GetFrameRate(), m_gameClient->GetSerializeSize());
   }
   else
@@ -77,6 +77,7 @@ public:
   bool UpdateSavestate(const std::string& savestatePath) override;
   bool LoadSavestate(const std::string& savestatePath) override;
   void FreeSavestateResources(const std::string& savestatePath) override;
+  std::string GetSavestateStats() const override;
   void CloseOSDCallback() override;
 
   // Implementation of IPlaybackCallback
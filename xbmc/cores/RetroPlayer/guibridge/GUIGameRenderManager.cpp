@@ -259,6 +259,16 @@ void CGUIGameRenderManager::FreeSavestateResources(const std::string& savestateP
     m_gameCallback->FreeSavestateResources(savestatePath);
 }
 
+std::string CGUIGameRenderManager::GetSavestateStats()
+{
+  std::unique_lock<CCriticalSection> lock(m_callbackMutex);
+
+  if (m_gameCallback != nullptr)
+    return m_gameCallback->GetSavestateStats();
+
+  return "";
+}
+
 void CGUIGameRenderManager::CloseOSD()
 {
   std::unique_lock<CCriticalSection> lock(m_callbackMutex);
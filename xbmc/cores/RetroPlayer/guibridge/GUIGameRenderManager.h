@@ -150,6 +150,7 @@ protected:
   bool UpdateSavestate(const std::string& savestatePath);
   bool LoadSavestate(const std::string& savestatePath);
   void FreeSavestateResources(const std::string& savestatePath);
+  std::string GetSavestateStats();
   void CloseOSD();
 
 private:
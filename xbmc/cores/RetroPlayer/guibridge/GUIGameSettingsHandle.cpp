@@ -53,6 +53,11 @@ void CGUIGameSettingsHandle::FreeSavestateResources(const std::string& savestate
   return m_renderManager.FreeSavestateResources(savestatePath);
 }
 
+std::string CGUIGameSettingsHandle::GetSavestateStats()
+{
+  return m_renderManager.GetSavestateStats();
+}
+
 void CGUIGameSettingsHandle::CloseOSD()
 {
   m_renderManager.CloseOSD();
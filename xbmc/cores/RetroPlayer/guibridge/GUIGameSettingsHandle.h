@@ -78,6 +78,14 @@ public:
    */
   void FreeSavestateResources(const std::string& savestatePath);
 
+  /*!
+   * \brief Get the time it took to create the last savestate
+   *
+   * \return A description of the timing, or empty if no savestate was
+   * created or a game is not playing
+   */
+  std::string GetSavestateStats();
+
   /*!
    * \brief Close the in-game OSD
    */
@@ -69,6 +69,13 @@ public:
    */
   virtual void FreeSavestateResources(const std::string& savestatePath) = 0;
 
+  /*!
+   * \brief Get the time it took to create the last savestate
+   *
+   * \return A description of the timing, or empty if no savestate was created
+   */
+  virtual std::string GetSavestateStats() const = 0;
+
   /*!
    * \brief Closes the OSD
    */
@@ -0,0 +1,143 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "FramePacer.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace KODI;
+using namespace RETRO;
+
+namespace
+{
+// Frames later than this many frame times are not caught up on
+constexpr double MAX_LATE_FRAMES = 2.0;
+
+// Bounds of the time spent spinning before a deadline
+constexpr double MIN_SPIN_MS = 0.25;
+constexpr double MAX_SPIN_MS = 3.0;
+
+// Weight of a new sample in the moving averages
+constexpr double SLEEP_SMOOTHING = 0.1;
+constexpr double AUDIO_SMOOTHING = 0.02;
+
+// Frames until the audio delay has settled and becomes the target
+constexpr unsigned int AUDIO_SETTLE_FRAMES = 120;
+
+// Frame time correction per relative deviation from the target audio delay
+constexpr double AUDIO_CORRECTION_GAIN = 0.01;
+
+// Maximum frame time correction. This is below what's audible as a pitch
+// change, and large enough for the drift between real-world clocks.
+constexpr double MAX_AUDIO_CORRECTION = 0.005;
+
+// Audio delay used as a floor when comparing against the target
+constexpr double MIN_AUDIO_DELAY_MS = 10.0;
+} // namespace
+
+void CFramePacer::Reset()
+{
+  m_bScheduled = false;
+  ResetAudioDelay();
+}
+
+void CFramePacer::ResetStats()
+{
+  m_stats = FramePacingStats{};
+  m_jitterCount = 0;
+}
+
+void CFramePacer::BeginFrame(double nowMs, double frameTimeMs)
+{
+  if (m_bScheduled)
+  {
+    const double dueMs = NextFrameMs(frameTimeMs);
+    const double jitterMs = std::abs(nowMs - dueMs);
+
+    m_jitterCount++;
+    m_stats.averageJitterMs += (jitterMs - m_stats.averageJitterMs) / m_jitterCount;
+    m_stats.maxJitterMs = std::max(m_stats.maxJitterMs, jitterMs);
+
+    if (nowMs - dueMs > MAX_LATE_FRAMES * frameTimeMs)
+    {
+      // Too late to catch up, start over from now
+      m_stats.lateFrameCount++;
+      m_scheduledMs = nowMs;
+    }
+    else
+      m_scheduledMs = dueMs;
+  }
+  else
+  {
+    m_bScheduled = true;
+    m_scheduledMs = nowMs;
+  }
+
+  m_frameStartMs = nowMs;
+}
+
+void CFramePacer::EndFrame(double nowMs)
+{
+  const double costMs = nowMs - m_frameStartMs;
+
+  m_stats.frameCount++;
+  m_stats.averageFrameTimeMs += (costMs - m_stats.averageFrameTimeMs) / m_stats.frameCount;
+  m_stats.maxFrameTimeMs = std::max(m_stats.maxFrameTimeMs, costMs);
+  m_stats.rateCorrection = m_rateCorrection;
+}
+
+double CFramePacer::NextFrameMs(double frameTimeMs) const
+{
+  if (!m_bScheduled)
+    return 0.0;
+
+  return m_scheduledMs + frameTimeMs * m_rateCorrection;
+}
+
+double CFramePacer::SpinThresholdMs() const
+{
+  return std::clamp(2.0 * m_sleepOvershootMs, MIN_SPIN_MS, MAX_SPIN_MS);
+}
+
+void CFramePacer::OnWakeup(double targetMs, double nowMs)
+{
+  const double overshootMs = std::max(nowMs - targetMs, 0.0);
+
+  m_sleepOvershootMs += (overshootMs - m_sleepOvershootMs) * SLEEP_SMOOTHING;
+}
+
+void CFramePacer::SetAudioDelay(double delayMs)
+{
+  if (m_audioDelayCount == 0)
+    m_audioDelayMs = delayMs;
+  else
+    m_audioDelayMs += (delayMs - m_audioDelayMs) * AUDIO_SMOOTHING;
+
+  if (m_audioDelayCount < AUDIO_SETTLE_FRAMES)
+  {
+    if (++m_audioDelayCount == AUDIO_SETTLE_FRAMES)
+      m_targetAudioDelayMs = m_audioDelayMs;
+    return;
+  }
+
+  // Audio piling up means frames come too fast, so they are made longer
+  const double deviation = (m_audioDelayMs - m_targetAudioDelayMs) /
+                           std::max(m_targetAudioDelayMs, MIN_AUDIO_DELAY_MS);
+
+  m_rateCorrection = 1.0 + std::clamp(deviation * AUDIO_CORRECTION_GAIN, -MAX_AUDIO_CORRECTION,
+                                      MAX_AUDIO_CORRECTION);
+}
+
+void CFramePacer::ResetAudioDelay()
+{
+  m_audioDelayCount = 0;
+  m_audioDelayMs = 0.0;
+  m_targetAudioDelayMs = 0.0;
+  m_rateCorrection = 1.0;
+}
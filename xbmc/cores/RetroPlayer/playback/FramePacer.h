@@ -0,0 +1,130 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+namespace KODI
+{
+namespace RETRO
+{
+/*!
+ * \brief Frame timing measured by the frame pacer
+ */
+struct FramePacingStats
+{
+  uint64_t frameCount = 0;
+  uint64_t lateFrameCount = 0; // Frames started too late to catch up
+  double averageFrameTimeMs = 0.0; // Time spent running a frame
+  double maxFrameTimeMs = 0.0;
+  double averageJitterMs = 0.0; // Distance between scheduled and actual frame start
+  double maxJitterMs = 0.0;
+  double rateCorrection = 1.0; // Frame time factor applied to follow the audio clock
+};
+
+/*!
+ * \brief Schedules frames of the game loop
+ *
+ * Frames are scheduled against absolute deadlines, so the time lost when
+ * waking up late doesn't accumulate. The loop is expected to sleep until
+ * shortly before the deadline and spin for the remainder. How long before is
+ * learned from the measured sleep overshoot.
+ *
+ * When the audio delay is reported, the frame time is corrected slightly to
+ * keep the delay at the level it settled at. This compensates for the drift
+ * between the game's nominal frame rate and the audio clock, which otherwise
+ * lets the audio buffer underrun or grow until it's flushed.
+ *
+ * All times are in milliseconds on a monotonic clock.
+ */
+class CFramePacer
+{
+public:
+  CFramePacer() = default;
+
+  /*!
+   * \brief Start the next frame immediately and forget the audio delay
+   *
+   * Called after the game loop was paused.
+   */
+  void Reset();
+
+  /*!
+   * \brief Reset the frame statistics
+   */
+  void ResetStats();
+
+  /*!
+   * \brief Called when a frame is started
+   *
+   * \param nowMs The current time
+   * \param frameTimeMs The nominal time between frames at the current speed
+   */
+  void BeginFrame(double nowMs, double frameTimeMs);
+
+  /*!
+   * \brief Called when a frame is finished
+   *
+   * \param nowMs The current time
+   */
+  void EndFrame(double nowMs);
+
+  /*!
+   * \brief Get the time the next frame should start
+   *
+   * \param frameTimeMs The nominal time between frames at the current speed
+   */
+  double NextFrameMs(double frameTimeMs) const;
+
+  /*!
+   * \brief Get the time before a deadline at which to stop sleeping and spin
+   */
+  double SpinThresholdMs() const;
+
+  /*!
+   * \brief Report how precise a sleep was
+   *
+   * \param targetMs The time the loop wanted to wake up
+   * \param nowMs The time it woke up
+   */
+  void OnWakeup(double targetMs, double nowMs);
+
+  /*!
+   * \brief Report the audio delay after a frame
+   *
+   * \param delayMs The time until the audio of the frame is heard
+   */
+  void SetAudioDelay(double delayMs);
+
+  /*!
+   * \brief Stop correcting the frame time, e.g. while audio is disabled
+   */
+  void ResetAudioDelay();
+
+  const FramePacingStats& Stats() const { return m_stats; }
+
+private:
+  // Scheduling
+  bool m_bScheduled = false;
+  double m_scheduledMs = 0.0; // Time the current frame was due
+  double m_frameStartMs = 0.0;
+  double m_sleepOvershootMs = 0.0;
+
+  // Drift correction
+  unsigned int m_audioDelayCount = 0;
+  double m_audioDelayMs = 0.0;
+  double m_targetAudioDelayMs = 0.0;
+  double m_rateCorrection = 1.0;
+
+  // Instrumentation
+  FramePacingStats m_stats;
+  uint64_t m_jitterCount = 0;
+};
+} // namespace RETRO
+} // namespace KODI
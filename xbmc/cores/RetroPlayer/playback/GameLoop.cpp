@@ -8,8 +8,11 @@
 
 #include "GameLoop.h"
 
+#include "utils/log.h"
+
 #include <chrono>
 #include <cmath>
+#include <thread>
 
 using namespace KODI;
 using namespace RETRO;
@@ -22,9 +25,7 @@ CGameLoop::CGameLoop(IGameLoopCallback* callback, double fps)
   : CThread("GameLoop"),
     m_callback(callback),
     m_fps(fps ? fps : DEFAULT_FPS),
-    m_speedFactor(0.0),
-    m_lastFrameMs(0.0),
-    m_adjustTime(0.0)
+    m_speedFactor(0.0)
 {
 }
 
@@ -63,45 +64,73 @@ void CGameLoop::Process(void)
   {
     if (m_speedFactor == 0.0)
     {
-      m_lastFrameMs = 0.0;
+      LogStats();
+      m_pacer.Reset();
       m_sleepEvent.Wait(5000ms);
     }
     else
     {
+      m_pacer.BeginFrame(NowMs(), FrameTimeMs());
+
       if (m_speedFactor > 0.0)
         m_callback->FrameEvent();
       else if (m_speedFactor < 0.0)
         m_callback->RewindEvent();
 
-      if (m_lastFrameMs > 0.0)
-      {
-        m_lastFrameMs += FrameTimeMs();
-        m_adjustTime = m_lastFrameMs - NowMs();
-      }
-      else
-      {
-        m_lastFrameMs = NowMs();
-        m_adjustTime = 0.0;
-      }
+      m_pacer.EndFrame(NowMs());
 
-      // Calculate sleep time
-      double sleepTimeMs = SleepTimeMs();
+      // Follow the audio clock while playing at normal speed
+      double audioDelaySecs;
+      if (m_speedFactor == 1.0 && m_callback->GetAudioDelay(audioDelaySecs))
+        m_pacer.SetAudioDelay(audioDelaySecs * 1000.0);
+      else
+        m_pacer.ResetAudioDelay();
 
-      // Sleep at least 1 ms to avoid sleeping forever
-      while (sleepTimeMs > 1.0)
-      {
-        m_sleepEvent.Wait(std::chrono::milliseconds(static_cast<unsigned int>(sleepTimeMs)));
+      WaitForNextFrame();
+    }
+  }
 
-        if (m_bStop)
-          break;
+  LogStats();
+}
 
-        // Speed may have changed, update sleep time
-        sleepTimeMs = SleepTimeMs();
-      }
+void CGameLoop::WaitForNextFrame()
+{
+  while (!m_bStop && m_speedFactor != 0.0)
+  {
+    // Speed may have changed, so the deadline is calculated on every pass
+    const double nowMs = NowMs();
+    const double remainingMs = m_pacer.NextFrameMs(FrameTimeMs()) - nowMs;
+    if (remainingMs <= 0.0)
+      break;
+
+    // Sleeping isn't precise, so the last part of the wait is spent spinning
+    const double sleepTimeMs = remainingMs - m_pacer.SpinThresholdMs();
+    if (sleepTimeMs > 0.0)
+    {
+      const auto sleepTime = std::chrono::microseconds(static_cast<int64_t>(sleepTimeMs * 1000.0));
+      if (!m_sleepEvent.Wait(sleepTime))
+        m_pacer.OnWakeup(nowMs + sleepTimeMs, NowMs());
     }
+    else
+      std::this_thread::yield();
   }
 }
 
+void CGameLoop::LogStats()
+{
+  const FramePacingStats& stats = m_pacer.Stats();
+  if (stats.frameCount == 0)
+    return;
+
+  CLog::Log(LOGDEBUG,
+            "GameLoop: {} frames, frame time {:.2f} ms (max {:.2f} ms), jitter {:.3f} ms (max "
+            "{:.3f} ms), {} late frames, rate correction {:.4f}",
+            stats.frameCount, stats.averageFrameTimeMs, stats.maxFrameTimeMs,
+            stats.averageJitterMs, stats.maxJitterMs, stats.lateFrameCount, stats.rateCorrection);
+
+  m_pacer.ResetStats();
+}
+
 double CGameLoop::FrameTimeMs() const
 {
   if (m_speedFactor != 0.0)
@@ -110,23 +139,6 @@ double CGameLoop::FrameTimeMs() const
     return 1000.0 / m_fps / 1.0;
 }
 
-double CGameLoop::SleepTimeMs() const
-{
-  // Calculate next frame time
-  const double nextFrameMs = m_lastFrameMs + FrameTimeMs();
-
-  // Calculate sleep time
-  double sleepTimeMs = (nextFrameMs - NowMs()) + m_adjustTime;
-
-  // Reset adjust time
-  m_adjustTime = 0.0;
-
-  // Positive or zero
-  sleepTimeMs = (sleepTimeMs >= 0.0 ? sleepTimeMs : 0.0);
-
-  return sleepTimeMs;
-}
-
 double CGameLoop::NowMs() const
 {
   return std::chrono::duration<double, std::milli>(
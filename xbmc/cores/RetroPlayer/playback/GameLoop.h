@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include "FramePacer.h"
 #include "threads/Event.h"
 #include "threads/Thread.h"
 
@@ -31,6 +32,15 @@ public:
    * \brief The prior frame is being shown
    */
   virtual void RewindEvent() = 0;
+
+  /*!
+   * \brief Get the time until audio produced now will be heard
+   *
+   * \param[out] delaySecs The audio delay, in seconds
+   *
+   * \return True if audio is playing, false otherwise
+   */
+  virtual bool GetAudioDelay(double& delaySecs) = 0;
 };
 
 class CGameLoop : protected CThread
@@ -54,15 +64,15 @@ protected:
   void Process() override;
 
 private:
+  void WaitForNextFrame();
+  void LogStats();
   double FrameTimeMs() const;
-  double SleepTimeMs() const;
   double NowMs() const;
 
   IGameLoopCallback* const m_callback;
   const double m_fps;
   std::atomic<double> m_speedFactor;
-  double m_lastFrameMs;
-  mutable double m_adjustTime;
+  CFramePacer m_pacer;
   CEvent m_sleepEvent;
 };
 } // namespace RETRO
@@ -41,6 +41,7 @@ public:
       bool autosave,
       const std::string& savestatePath = "") = 0; // Returns the path of savestate on success
   virtual bool LoadSavestate(const std::string& savestatePath) = 0;
+  virtual std::string GetSavestateStats() const = 0; // Timing of the last savestate
 };
 } // namespace RETRO
 } // namespace KODI
@@ -36,6 +36,7 @@ public:
     return "";
   }
   bool LoadSavestate(const std::string& savestatePath) override { return false; }
+  std::string GetSavestateStats() const override { return ""; }
 };
 } // namespace RETRO
 } // namespace KODI
@@ -16,16 +16,22 @@
 #include "cores/RetroPlayer/rendering/RPRenderManager.h"
 #include "cores/RetroPlayer/savestates/ISavestate.h"
 #include "cores/RetroPlayer/savestates/SavestateDatabase.h"
-#include "cores/RetroPlayer/streams/memory/DeltaPairMemoryStream.h"
+#include "cores/RetroPlayer/streams/RPStreamManager.h"
+#include "cores/RetroPlayer/streams/memory/KeyframeMemoryStream.h"
 #include "filesystem/File.h"
 #include "games/GameServices.h"
 #include "games/GameSettings.h"
 #include "games/addons/GameClient.h"
+#include "settings/AdvancedSettings.h"
+#include "settings/SettingsComponent.h"
 #include "utils/MathUtils.h"
+#include "utils/StringUtils.h"
 #include "utils/URIUtils.h"
 #include "utils/log.h"
 
 #include <algorithm>
+#include <chrono>
+#include <cstring>
 #include <mutex>
 
 using namespace KODI;
@@ -33,14 +39,25 @@ using namespace RETRO;
 
 #define REWIND_FACTOR 0.25 // Rewind at 25% of gameplay speed
 
+namespace
+{
+double DurationMs(std::chrono::steady_clock::time_point start)
+{
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+      .count();
+}
+} // namespace
+
 CReversiblePlayback::CReversiblePlayback(GAME::CGameClient* gameClient,
                                          CRPRenderManager& renderManager,
+                                         CRPStreamManager& streamManager,
                                          CCheevos* cheevos,
                                          CGUIGameMessenger& guiMessenger,
                                          double fps,
                                          size_t serializeSize)
   : m_gameClient(gameClient),
     m_renderManager(renderManager),
+    m_streamManager(streamManager),
     m_cheevos(cheevos),
     m_guiMessenger(guiMessenger),
     m_gameLoop(this, fps),
@@ -54,6 +71,17 @@ CReversiblePlayback::CReversiblePlayback(GAME::CGameClient* gameClient,
 {
   UpdateMemoryStream();
 
+  if (serializeSize > 0)
+  {
+    m_runAheadFrames =
+        CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_gamesRunAheadFrames;
+    if (m_runAheadFrames > 0)
+    {
+      CLog::Log(LOGDEBUG, "RetroPlayer[PLAYBACK]: Running {} frame(s) ahead", m_runAheadFrames);
+      m_runAheadState.resize(serializeSize);
+    }
+  }
+
   GAME::CGameSettings& gameSettings = CServiceBroker::GetGameServices().GameSettings();
   gameSettings.RegisterObserver(this);
 }
@@ -141,11 +169,18 @@ std::string CReversiblePlayback::CreateSavestate(bool autosave,
     return "";
   }
 
+  const auto snapshotStart = std::chrono::steady_clock::now();
+
   // Take a timestamp of the system clock
   const CDateTime nowUTC = CDateTime::GetUTCDateTime();
 
-  // Record the frame count
-  const uint64_t timestampFrames = m_totalFrameCount;
+  // Take a snapshot of the memory, recording the frame count it belongs to.
+  // The savestate is built and written in the background, but the snapshot
+  // has to be taken now so that it matches the timestamp and video frame.
+  std::unique_ptr<ISavestate> savestate = CSavestateDatabase::AllocateSavestate();
+  uint64_t timestampFrames;
+  if (!SnapshotMemory(*savestate, memorySize, timestampFrames))
+    return "";
 
   // Get the savestate path
   std::string savePath(savestatePath);
@@ -175,6 +210,8 @@ std::string CReversiblePlayback::CreateSavestate(bool autosave,
   {
     std::unique_lock<CCriticalSection> lock(m_savestateMutex);
 
+    m_savestateStats.snapshotMs = DurationMs(snapshotStart);
+
     // Prune any finished autosave threads
     m_savestateThreads.erase(std::remove_if(m_savestateThreads.begin(), m_savestateThreads.end(),
                                             [](std::future<void>& task) {
@@ -185,8 +222,9 @@ std::string CReversiblePlayback::CreateSavestate(bool autosave,
 
     // Save async to not block game loop
     std::future<void> task =
-        std::async(std::launch::async, [this, autosave, savePath, nowUTC, timestampFrames]() {
-          CommitSavestate(autosave, savePath, nowUTC, timestampFrames);
+        std::async(std::launch::async, [this, savestate = std::move(savestate), autosave, savePath,
+                                        nowUTC, timestampFrames]() mutable {
+          CommitSavestate(std::move(savestate), autosave, savePath, nowUTC, timestampFrames);
         });
 
     m_savestateThreads.emplace_back(std::move(task));
@@ -195,32 +233,51 @@ std::string CReversiblePlayback::CreateSavestate(bool autosave,
   return savePath;
 }
 
-void CReversiblePlayback::CommitSavestate(bool autosave,
-                                          const std::string& savePath,
-                                          const CDateTime& nowUTC,
-                                          uint64_t timestampFrames)
+std::string CReversiblePlayback::GetSavestateStats() const
 {
-  std::unique_ptr<ISavestate> savestate = CSavestateDatabase::AllocateSavestate();
-  std::unique_ptr<ISavestate> loadedSavestate;
+  std::unique_lock<CCriticalSection> lock(m_savestateMutex);
 
-  const size_t memorySize = m_gameClient->SerializeSize();
-  uint8_t* const memoryData = savestate->GetMemoryBuffer(memorySize);
+  if (m_savestateStats.commitMs == 0.0)
+    return "";
 
-  // Copy the savestate memory
+  return StringUtils::Format("snapshot {:.1f} ms, commit {:.1f} ms, thumbnail {:.1f} ms",
+                             m_savestateStats.snapshotMs, m_savestateStats.commitMs,
+                             m_savestateStats.thumbnailMs);
+}
+
+bool CReversiblePlayback::SnapshotMemory(ISavestate& savestate,
+                                         size_t memorySize,
+                                         uint64_t& timestampFrames)
+{
+  uint8_t* const memoryData = savestate.GetMemoryBuffer(memorySize);
+
+  std::unique_lock<CCriticalSection> lock(m_mutex);
+
+  // The rewind buffer holds a copy of the state after the last frame, which
+  // saves serializing it again while the game loop waits
+  if (m_memoryStream && m_memoryStream->CurrentFrame() != nullptr)
   {
-    std::unique_lock<CCriticalSection> lock(m_mutex);
-    if (m_memoryStream && m_memoryStream->CurrentFrame() != nullptr)
-    {
-      std::memcpy(memoryData, m_memoryStream->CurrentFrame(), memorySize);
-    }
-    else
-    {
-      lock.unlock();
-      if (!m_gameClient->Serialize(memoryData, memorySize))
-        return;
-    }
+    std::memcpy(memoryData, m_memoryStream->CurrentFrame(), memorySize);
+    timestampFrames = m_totalFrameCount;
+    return true;
   }
 
+  timestampFrames = m_totalFrameCount;
+  lock.unlock();
+
+  return m_gameClient->Serialize(memoryData, memorySize);
+}
+
+void CReversiblePlayback::CommitSavestate(std::unique_ptr<ISavestate> savestate,
+                                          bool autosave,
+                                          const std::string& savePath,
+                                          const CDateTime& nowUTC,
+                                          uint64_t timestampFrames)
+{
+  const auto commitStart = std::chrono::steady_clock::now();
+
+  std::unique_ptr<ISavestate> loadedSavestate;
+
   // Attempt to get existing properties
   {
     std::unique_lock<CCriticalSection> lock(m_savestateMutex);
@@ -252,6 +309,16 @@ void CReversiblePlayback::CommitSavestate(bool autosave,
 
   m_renderManager.SaveVideoFrame(savePath, *savestate);
 
+  // Scaling and encoding the thumbnail is independent of building and
+  // writing the savestate, so both run at the same time
+  const std::string thumbnailPath = CSavestateDatabase::MakeThumbnailPath(savePath);
+  std::future<double> thumbnailTask =
+      std::async(std::launch::async, [this, &savePath, &thumbnailPath]() {
+        const auto thumbnailStart = std::chrono::steady_clock::now();
+        m_renderManager.SaveThumbnail(savePath, thumbnailPath);
+        return DurationMs(thumbnailStart);
+      });
+
   savestate->Finalize();
 
   bool success;
@@ -260,10 +327,17 @@ void CReversiblePlayback::CommitSavestate(bool autosave,
     success = m_savestateDatabase->AddSavestate(savePath, m_gameClient->GetGamePath(), *savestate);
   }
 
-  if (success)
+  const double thumbnailMs = thumbnailTask.get();
+
+  if (!success)
+    XFILE::CFile::Delete(thumbnailPath);
+
   {
-    std::string thumbnailPath = CSavestateDatabase::MakeThumbnailPath(savePath);
-    m_renderManager.SaveThumbnail(thumbnailPath);
+    std::unique_lock<CCriticalSection> lock(m_savestateMutex);
+    m_savestateStats.commitMs = DurationMs(commitStart);
+    m_savestateStats.thumbnailMs = thumbnailMs;
+
+    CLog::Log(LOGDEBUG, "RetroPlayer[SAVE]: Savestate took {}", GetSavestateStats());
   }
 
   // Notify the GUI that the metadata for this savestate should be refreshed
@@ -317,6 +391,13 @@ bool CReversiblePlayback::LoadSavestate(const std::string& savestatePath)
 
 void CReversiblePlayback::FrameEvent()
 {
+  // Running ahead is pointless when not playing at normal speed
+  if (m_runAheadFrames > 0 && m_gameLoop.GetSpeed() == 1.0)
+  {
+    RunAhead();
+    return;
+  }
+
   m_gameClient->RunFrame();
 
   AddFrame();
@@ -329,13 +410,60 @@ void CReversiblePlayback::RewindEvent()
   m_gameClient->RunFrame();
 }
 
-void CReversiblePlayback::AddFrame()
+bool CReversiblePlayback::GetAudioDelay(double& delaySecs)
+{
+  return m_streamManager.GetAudioDelay(delaySecs);
+}
+
+void CReversiblePlayback::RunAhead()
+{
+  // The frame that is kept is heard, but not seen
+  m_streamManager.SuppressVideo(true);
+  m_gameClient->RunFrame();
+
+  if (!m_gameClient->Serialize(m_runAheadState.data(), m_runAheadState.size()))
+  {
+    CLog::Log(LOGERROR, "RetroPlayer[PLAYBACK]: Failed to serialize, disabling run-ahead");
+    m_runAheadFrames = 0;
+    m_streamManager.SuppressVideo(false);
+    AddFrame();
+    return;
+  }
+
+  AddFrame(m_runAheadState.data());
+
+  // The frames ahead are discarded, only the last one is seen
+  m_streamManager.SuppressAudio(true);
+  for (unsigned int i = 1; i < m_runAheadFrames; i++)
+    m_gameClient->RunFrame();
+  m_streamManager.SuppressVideo(false);
+  m_gameClient->RunFrame();
+  m_streamManager.SuppressAudio(false);
+
+  // The game stays ahead by the frames that were run if it can't go back
+  if (!m_gameClient->Deserialize(m_runAheadState.data(), m_runAheadState.size()))
+  {
+    CLog::Log(LOGERROR, "RetroPlayer[PLAYBACK]: Failed to deserialize, disabling run-ahead");
+    m_runAheadFrames = 0;
+  }
+}
+
+void CReversiblePlayback::AddFrame(const uint8_t* state /* = nullptr */)
 {
   std::unique_lock<CCriticalSection> lock(m_mutex);
 
   if (m_memoryStream)
   {
-    if (m_gameClient->Serialize(m_memoryStream->BeginFrame(), m_memoryStream->FrameSize()))
+    bool bSuccess;
+    if (state != nullptr)
+    {
+      std::memcpy(m_memoryStream->BeginFrame(), state, m_memoryStream->FrameSize());
+      bSuccess = true;
+    }
+    else
+      bSuccess = m_gameClient->Serialize(m_memoryStream->BeginFrame(), m_memoryStream->FrameSize());
+
+    if (bSuccess)
     {
       m_memoryStream->SubmitFrame();
       UpdatePlaybackStats();
@@ -420,7 +548,11 @@ void CReversiblePlayback::UpdateMemoryStream()
 
     if (!m_memoryStream)
     {
-      m_memoryStream.reset(new CDeltaPairMemoryStream);
+      const size_t maxMemory = static_cast<size_t>(CServiceBroker::GetSettingsComponent()
+                                                       ->GetAdvancedSettings()
+                                                       ->m_gamesRewindMemory) *
+                               1024 * 1024;
+      m_memoryStream.reset(new CKeyframeMemoryStream(maxMemory));
       m_memoryStream->Init(m_gameClient->SerializeSize(), frameCount);
     }
 
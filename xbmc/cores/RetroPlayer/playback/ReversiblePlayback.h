@@ -17,6 +17,7 @@
 #include <memory>
 #include <stddef.h>
 #include <stdint.h>
+#include <vector>
 
 class CDateTime;
 
@@ -32,7 +33,9 @@ namespace RETRO
 class CCheevos;
 class CGUIGameMessenger;
 class CRPRenderManager;
+class CRPStreamManager;
 class CSavestateDatabase;
+class ISavestate;
 class IMemoryStream;
 
 class CReversiblePlayback : public IPlayback, public IGameLoopCallback, public Observer
@@ -40,6 +43,7 @@ class CReversiblePlayback : public IPlayback, public IGameLoopCallback, public O
 public:
   CReversiblePlayback(GAME::CGameClient* gameClient,
                       CRPRenderManager& renderManager,
+                      CRPStreamManager& streamManager,
                       CCheevos* cheevos,
                       CGUIGameMessenger& guiMessenger,
                       double fps,
@@ -61,21 +65,26 @@ public:
   void PauseAsync() override;
   std::string CreateSavestate(bool autosave, const std::string& savestatePath = "") override;
   bool LoadSavestate(const std::string& savestatePath) override;
+  std::string GetSavestateStats() const override;
 
   // implementation of IGameLoopCallback
   void FrameEvent() override;
   void RewindEvent() override;
+  bool GetAudioDelay(double& delaySecs) override;
 
   // implementation of Observer
   void Notify(const Observable& obs, const ObservableMessage msg) override;
 
 private:
-  void AddFrame();
+  void RunAhead();
+  void AddFrame(const uint8_t* state = nullptr);
   void RewindFrames(uint64_t frames);
   void AdvanceFrames(uint64_t frames);
   void UpdatePlaybackStats();
   void UpdateMemoryStream();
-  void CommitSavestate(bool autosave,
+  bool SnapshotMemory(ISavestate& savestate, size_t memorySize, uint64_t& timestampFrames);
+  void CommitSavestate(std::unique_ptr<ISavestate> savestate,
+                       bool autosave,
                        const std::string& savePath,
                        const CDateTime& nowUTC,
                        uint64_t timestampFrames);
@@ -83,6 +92,7 @@ private:
   // Construction parameter
   GAME::CGameClient* const m_gameClient;
   CRPRenderManager& m_renderManager;
+  CRPStreamManager& m_streamManager;
   CCheevos* const m_cheevos;
   CGUIGameMessenger& m_guiMessenger;
 
@@ -91,11 +101,24 @@ private:
   std::unique_ptr<IMemoryStream> m_memoryStream;
   CCriticalSection m_mutex;
 
+  // Run-ahead functionality
+  unsigned int m_runAheadFrames = 0;
+  std::vector<uint8_t> m_runAheadState;
+
   // Savestate functionality
   std::unique_ptr<CSavestateDatabase> m_savestateDatabase;
   std::string m_autosavePath{};
   std::vector<std::future<void>> m_savestateThreads;
-  CCriticalSection m_savestateMutex;
+  mutable CCriticalSection m_savestateMutex;
+
+  // Savestate timing, of the last savestate
+  struct SavestateStats
+  {
+    double snapshotMs = 0.0; // Time the caller was blocked
+    double commitMs = 0.0; // Time spent building and writing the savestate
+    double thumbnailMs = 0.0; // Time spent creating the thumbnail, during commit
+  };
+  SavestateStats m_savestateStats;
 
   // Playback stats
   uint64_t m_totalFrameCount;
@@ -0,0 +1,98 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/RetroPlayer/playback/FramePacer.h"
+
+#include <gtest/gtest.h>
+
+using namespace KODI;
+using namespace RETRO;
+
+namespace
+{
+constexpr double FRAME_TIME_MS = 1000.0 / 60.0;
+} // namespace
+
+TEST(TestFramePacer, AbsoluteDeadlines)
+{
+  CFramePacer pacer;
+
+  // Waking up late doesn't delay the following frames
+  double nowMs = 1000.0;
+  for (unsigned int i = 0; i < 10; i++)
+  {
+    pacer.BeginFrame(nowMs + (i % 2 == 1 ? 0.5 : 0.0), FRAME_TIME_MS);
+    pacer.EndFrame(nowMs + 2.0);
+    nowMs += FRAME_TIME_MS;
+    EXPECT_NEAR(nowMs, pacer.NextFrameMs(FRAME_TIME_MS), 1e-9);
+  }
+
+  const FramePacingStats& stats = pacer.Stats();
+  EXPECT_EQ(10u, stats.frameCount);
+  EXPECT_EQ(0u, stats.lateFrameCount);
+  EXPECT_NEAR(0.5, stats.maxJitterMs, 1e-9);
+  EXPECT_NEAR(0.25, stats.averageJitterMs, 0.05);
+  EXPECT_NEAR(2.0, stats.maxFrameTimeMs, 0.5);
+}
+
+TEST(TestFramePacer, LateFramesAreNotCaughtUp)
+{
+  CFramePacer pacer;
+
+  pacer.BeginFrame(0.0, FRAME_TIME_MS);
+  pacer.EndFrame(1.0);
+
+  // A stall of several frames
+  pacer.BeginFrame(100.0, FRAME_TIME_MS);
+  pacer.EndFrame(101.0);
+
+  EXPECT_EQ(1u, pacer.Stats().lateFrameCount);
+  EXPECT_NEAR(100.0 + FRAME_TIME_MS, pacer.NextFrameMs(FRAME_TIME_MS), 1e-9);
+
+  // Starting over after a pause
+  pacer.Reset();
+  EXPECT_EQ(0.0, pacer.NextFrameMs(FRAME_TIME_MS));
+}
+
+TEST(TestFramePacer, SpinThresholdFollowsOvershoot)
+{
+  CFramePacer pacer;
+  const double minThresholdMs = pacer.SpinThresholdMs();
+
+  for (unsigned int i = 0; i < 100; i++)
+    pacer.OnWakeup(10.0 * i, 10.0 * i + 1.0);
+
+  EXPECT_GT(pacer.SpinThresholdMs(), minThresholdMs);
+  EXPECT_NEAR(2.0, pacer.SpinThresholdMs(), 0.1);
+}
+
+TEST(TestFramePacer, DriftCorrection)
+{
+  CFramePacer pacer;
+
+  // Settle at 60 ms of audio
+  for (unsigned int i = 0; i < 200; i++)
+    pacer.SetAudioDelay(60.0);
+  pacer.BeginFrame(0.0, FRAME_TIME_MS);
+  EXPECT_NEAR(FRAME_TIME_MS, pacer.NextFrameMs(FRAME_TIME_MS), 1e-9);
+
+  // Audio piling up slows down the frames, but not beyond the limit
+  for (unsigned int i = 0; i < 500; i++)
+    pacer.SetAudioDelay(120.0);
+  const double slowFrameMs = pacer.NextFrameMs(FRAME_TIME_MS);
+  EXPECT_GT(slowFrameMs, FRAME_TIME_MS);
+  EXPECT_LE(slowFrameMs, FRAME_TIME_MS * 1.005 + 1e-9);
+
+  // Audio running low speeds them up
+  for (unsigned int i = 0; i < 500; i++)
+    pacer.SetAudioDelay(30.0);
+  EXPECT_LT(pacer.NextFrameMs(FRAME_TIME_MS), FRAME_TIME_MS);
+
+  pacer.ResetAudioDelay();
+  EXPECT_NEAR(FRAME_TIME_MS, pacer.NextFrameMs(FRAME_TIME_MS), 1e-9);
+}
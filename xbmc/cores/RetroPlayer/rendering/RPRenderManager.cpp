@@ -787,14 +787,15 @@ CRenderVideoSettings CRPRenderManager::GetEffectiveSettings(
   return effectiveSettings;
 }
 
-void CRPRenderManager::SaveThumbnail(const std::string& thumbnailPath)
+void CRPRenderManager::SaveThumbnail(const std::string& savestatePath,
+                                     const std::string& thumbnailPath)
 {
   // Get a suitable render buffer for capturing the video data, or use the
   // cached frame if a readable buffer can't be found
   IRenderBuffer* renderBuffer = nullptr;
   std::vector<uint8_t> cachedFrame;
 
-  GetVideoFrame(renderBuffer, cachedFrame);
+  GetVideoFrame(savestatePath, renderBuffer, cachedFrame);
 
   // Video frame properties
   AVPixelFormat sourceFormat = AV_PIX_FMT_NONE;
@@ -816,8 +817,8 @@ void CRPRenderManager::SaveThumbnail(const std::string& thumbnailPath)
   else if (!cachedFrame.empty())
   {
     sourceFormat = m_format;
-    sourceData = m_cachedFrame.data();
-    sourceSize = m_cachedFrame.size();
+    sourceData = cachedFrame.data();
+    sourceSize = cachedFrame.size();
     width = m_cachedWidth;
     height = m_cachedHeight;
     rotationCCW = m_cachedRotationCCW;
@@ -887,7 +888,7 @@ void CRPRenderManager::SaveVideoFrame(const std::string& savestatePath, ISavesta
   IRenderBuffer* readableBuffer = nullptr;
   std::vector<uint8_t> cachedFrame;
 
-  GetVideoFrame(readableBuffer, cachedFrame);
+  GetVideoFrame(savestatePath, readableBuffer, cachedFrame);
 
   // Video frame properties
   AVPixelFormat targetFormat = AV_PIX_FMT_NONE;
@@ -912,8 +913,8 @@ void CRPRenderManager::SaveVideoFrame(const std::string& savestatePath, ISavesta
     width = m_cachedWidth;
     height = m_cachedHeight;
     rotationCCW = m_cachedRotationCCW;
-    sourceSize = m_cachedFrame.size();
-    sourceData = m_cachedFrame.data();
+    sourceSize = cachedFrame.size();
+    sourceData = cachedFrame.data();
   }
 
   if (targetFormat == AV_PIX_FMT_NONE)
@@ -954,19 +955,29 @@ void CRPRenderManager::ClearVideoFrame(const std::string& savestatePath)
   }
 }
 
-void CRPRenderManager::GetVideoFrame(IRenderBuffer*& readableBuffer,
+void CRPRenderManager::GetVideoFrame(const std::string& savestatePath,
+                                     IRenderBuffer*& readableBuffer,
                                      std::vector<uint8_t>& cachedFrame)
 {
   std::unique_lock<CCriticalSection> lock(m_bufferMutex);
 
+  const auto isReadable = [](const IRenderBuffer* renderBuffer) {
+    return renderBuffer->GetMemoryAccess() != DataAccess::WRITE_ONLY;
+  };
+
+  // Prefer the frame captured when the savestate was created, as the game
+  // has moved on since
+  std::vector<IRenderBuffer*>* renderBuffers = &m_renderBuffers;
+  auto savestateBuffers = m_savestateBuffers.find(savestatePath);
+  if (savestateBuffers != m_savestateBuffers.end() &&
+      std::any_of(savestateBuffers->second.begin(), savestateBuffers->second.end(), isReadable))
+    renderBuffers = &savestateBuffers->second;
+
   // Get a readable render buffer
-  auto it = std::find_if(m_renderBuffers.begin(), m_renderBuffers.end(),
-                         [](const IRenderBuffer* renderBuffer) {
-                           return renderBuffer->GetMemoryAccess() != DataAccess::WRITE_ONLY;
-                         });
+  auto it = std::find_if(renderBuffers->begin(), renderBuffers->end(), isReadable);
 
   // Aquire buffer if one was found
-  if (it != m_renderBuffers.end())
+  if (it != renderBuffers->end())
   {
     readableBuffer = *it;
     readableBuffer->Acquire();
@@ -120,7 +120,7 @@ public:
   bool SupportsScalingMethod(SCALINGMETHOD method) const override;
 
   // Savestate functions
-  void SaveThumbnail(const std::string& thumbnailPath);
+  void SaveThumbnail(const std::string& savestatePath, const std::string& thumbnailPath);
 
   // Savestate functions
   void CacheVideoFrame(const std::string& savestatePath);
@@ -211,7 +211,9 @@ private:
 
   void CheckFlush();
 
-  void GetVideoFrame(IRenderBuffer*& readableBuffer, std::vector<uint8_t>& cachedFrame);
+  void GetVideoFrame(const std::string& savestatePath,
+                     IRenderBuffer*& readableBuffer,
+                     std::vector<uint8_t>& cachedFrame);
   void FreeVideoFrame(IRenderBuffer* readableBuffer, std::vector<uint8_t> cachedFrame);
   void LoadVideoFrameAsync(const std::string& savestatePath);
   void LoadVideoFrameSync(const std::string& savestatePath);
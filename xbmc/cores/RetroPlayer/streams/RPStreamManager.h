@@ -15,6 +15,7 @@ namespace KODI
 namespace RETRO
 {
 class CRetroPlayerAudio;
+class CRetroPlayerVideo;
 class CRPProcessInfo;
 class CRPRenderManager;
 
@@ -26,6 +27,24 @@ public:
 
   void EnableAudio(bool bEnable);
 
+  /*!
+   * \brief Drop the output of the following frames
+   *
+   * Used to run frames which are discarded later, like the frames run ahead
+   * of the emulated state.
+   */
+  void SuppressAudio(bool bSuppress);
+  void SuppressVideo(bool bSuppress);
+
+  /*!
+   * \brief Get the delay of the audio stream
+   *
+   * \param[out] delaySecs The delay, in seconds
+   *
+   * \return True if audio is playing, false otherwise
+   */
+  bool GetAudioDelay(double& delaySecs) const;
+
   // Implementation of IStreamManager
   StreamPtr CreateStream(StreamType streamType) override;
   void CloseStream(StreamPtr stream) override;
@@ -37,6 +56,7 @@ private:
 
   // Stream parameters
   CRetroPlayerAudio* m_audioStream = nullptr;
+  CRetroPlayerVideo* m_videoStream = nullptr;
 };
 } // namespace RETRO
 } // namespace KODI
@@ -108,7 +108,7 @@ void CRetroPlayerAudio::AddStreamData(const StreamPacket& packet)
 {
   const AudioStreamPacket& audioPacket = static_cast<const AudioStreamPacket&>(packet);
 
-  if (m_bAudioEnabled)
+  if (m_bAudioEnabled && !m_bSuppressed)
   {
     if (m_pAudioStream)
     {
@@ -131,6 +131,15 @@ void CRetroPlayerAudio::AddStreamData(const StreamPacket& packet)
   }
 }
 
+bool CRetroPlayerAudio::GetDelay(double& delaySecs) const
+{
+  if (!m_bAudioEnabled || !m_pAudioStream)
+    return false;
+
+  delaySecs = m_pAudioStream->GetDelay();
+  return true;
+}
+
 void CRetroPlayerAudio::CloseStream()
 {
   if (m_pAudioStream)
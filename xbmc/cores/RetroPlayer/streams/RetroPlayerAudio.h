@@ -49,6 +49,21 @@ public:
 
   void Enable(bool bEnabled) { m_bAudioEnabled = bEnabled; }
 
+  /*!
+   * \brief Drop audio while frames are run that aren't meant to be heard,
+   *        e.g. when running ahead
+   */
+  void Suppress(bool bSuppressed) { m_bSuppressed = bSuppressed; }
+
+  /*!
+   * \brief Get the time until audio added now will be heard
+   *
+   * \param[out] delaySecs The delay, in seconds
+   *
+   * \return True if audio is playing, false otherwise
+   */
+  bool GetDelay(double& delaySecs) const;
+
   // implementation of IRetroPlayerStream
   bool OpenStream(const StreamProperties& properties) override;
   bool GetStreamBuffer(unsigned int width, unsigned int height, StreamBuffer& buffer) override
@@ -62,6 +77,7 @@ private:
   CRPProcessInfo& m_processInfo;
   IAE::StreamPtr m_pAudioStream;
   bool m_bAudioEnabled;
+  bool m_bSuppressed = false;
 };
 } // namespace RETRO
 } // namespace KODI
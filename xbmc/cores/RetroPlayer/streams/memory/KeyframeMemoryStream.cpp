@@ -0,0 +1,374 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "KeyframeMemoryStream.h"
+
+#include "utils/log.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include <lzo/lzo1x.h>
+#include <lzo/lzoconf.h>
+
+using namespace KODI;
+using namespace RETRO;
+
+namespace
+{
+// Size of the blocks compared between frames. Only changed blocks are stored,
+// each costing an entry in the changed block list.
+constexpr size_t BLOCK_SIZE = 256;
+
+// Worst case size of LZO compressed data
+constexpr size_t CompressBound(size_t size)
+{
+  return size + size / 16 + 64 + 3;
+}
+
+/*
+ * The XOR loops work on 64 bits at a time, which compilers vectorize for the
+ * target's SIMD instruction set. Comparing the blocks is left to memcmp(),
+ * which is vectorized by the C library and stops at the first difference.
+ */
+void XorBlock(const uint8_t* a, const uint8_t* b, uint8_t* result, size_t size)
+{
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t))
+  {
+    uint64_t x;
+    uint64_t y;
+    std::memcpy(&x, a + i, sizeof(x));
+    std::memcpy(&y, b + i, sizeof(y));
+    x ^= y;
+    std::memcpy(result + i, &x, sizeof(x));
+  }
+  for (; i < size; i++)
+    result[i] = a[i] ^ b[i];
+}
+
+void ApplyXor(uint8_t* state, const uint8_t* delta, size_t size)
+{
+  XorBlock(state, delta, state, size);
+}
+} // namespace
+
+CKeyframeMemoryStream::CKeyframeMemoryStream(size_t maxMemory /* = 0 */,
+                                             unsigned int keyframeInterval /* = 60 */)
+  : m_keyframeInterval(std::max(keyframeInterval, 1u)), m_maxMemory(maxMemory)
+{
+}
+
+void CKeyframeMemoryStream::Init(size_t frameSize, uint64_t maxFrameCount)
+{
+  CLinearMemoryStream::Init(frameSize, maxFrameCount);
+
+  if (lzo_init() != LZO_E_OK)
+    CLog::Log(LOGERROR, "CKeyframeMemoryStream: Failed to initialize LZO");
+
+  m_deltaBuffer.resize(frameSize);
+  m_compressBuffer.resize(CompressBound(frameSize));
+  m_compressWorkMemory.resize(LZO1X_1_MEM_COMPRESS);
+
+  // a keyframe is complete by the time the next one is due
+  m_keyframeChunkSize = std::max<size_t>(
+      (frameSize + m_keyframeInterval - 1) / m_keyframeInterval, 1);
+  m_keyframeChunkCount = (frameSize + m_keyframeChunkSize - 1) / m_keyframeChunkSize;
+}
+
+void CKeyframeMemoryStream::Reset()
+{
+  CLinearMemoryStream::Reset();
+
+  m_frames.clear();
+  m_culledFrames = 0;
+  m_memoryUsage = 0;
+  m_pendingKeyframe.clear();
+  m_deltaBuffer.clear();
+  m_compressBuffer.clear();
+  m_compressWorkMemory.clear();
+}
+
+uint64_t CKeyframeMemoryStream::PastFramesAvailable() const
+{
+  return static_cast<uint64_t>(m_frames.size());
+}
+
+void CKeyframeMemoryStream::SetMaxMemory(size_t maxMemory)
+{
+  m_maxMemory = maxMemory;
+  CullToMemoryBudget();
+}
+
+void CKeyframeMemoryStream::SubmitFrameInternal()
+{
+  const uint8_t* currentFrame = reinterpret_cast<const uint8_t*>(m_currentFrame.get());
+  const uint8_t* nextFrame = reinterpret_cast<const uint8_t*>(m_nextFrame.get());
+  const size_t frameSize = FrameSize();
+
+  m_frames.emplace_back();
+  MemoryFrame& frame = m_frames.back();
+
+  // Record frame history
+  frame.frameHistoryCount = m_currentFrameHistory++;
+
+  if (IsKeyframe(m_frames.size() - 1))
+  {
+    // only happens if frames were rewound meanwhile
+    while (!m_pendingKeyframe.empty())
+      CompressKeyframeChunk();
+
+    m_pendingKeyframe.assign(currentFrame, currentFrame + frameSize);
+    m_pendingKeyframeSequence = m_culledFrames + m_frames.size() - 1;
+  }
+
+  // Gather the XOR of the changed blocks
+  size_t deltaSize = 0;
+  for (size_t offset = 0; offset < frameSize; offset += BLOCK_SIZE)
+  {
+    const size_t blockSize = std::min(BLOCK_SIZE, frameSize - offset);
+    if (std::memcmp(currentFrame + offset, nextFrame + offset, blockSize) != 0)
+    {
+      XorBlock(currentFrame + offset, nextFrame + offset, m_deltaBuffer.data() + deltaSize,
+               blockSize);
+      frame.changedBlocks.push_back(static_cast<uint32_t>(offset / BLOCK_SIZE));
+      deltaSize += blockSize;
+    }
+  }
+
+  if (deltaSize > 0)
+    Compress(m_deltaBuffer.data(), deltaSize, frame.delta);
+
+  m_memoryUsage += MemoryUsage(frame);
+
+  CompressKeyframeChunk();
+
+  // Delta is generated, bring the new frame forward (m_nextFrame is now disposable)
+  std::swap(m_currentFrame, m_nextFrame);
+
+  m_bHasNextFrame = false;
+
+  if (PastFramesAvailable() + 1 > MaxFrameCount())
+    CullPastFrames(1);
+
+  CullToMemoryBudget();
+}
+
+uint64_t CKeyframeMemoryStream::RewindFrames(uint64_t frameCount)
+{
+  const uint64_t rewound = std::min(frameCount, PastFramesAvailable());
+  if (rewound == 0)
+    return 0;
+
+  const size_t pastFrames = m_frames.size();
+  const size_t target = pastFrames - static_cast<size_t>(rewound);
+  size_t position = pastFrames;
+
+  // Start from the first keyframe at or after the target instead of the
+  // current frame if decompressing it costs less than the deltas it skips
+  const uint64_t targetSequence = m_culledFrames + target;
+  const uint64_t keyframeSequence =
+      (targetSequence + m_keyframeInterval - 1) / m_keyframeInterval * m_keyframeInterval;
+  const size_t keyframe = static_cast<size_t>(keyframeSequence - m_culledFrames);
+  if (keyframe < pastFrames && HasKeyframe(m_frames[keyframe]))
+  {
+    size_t skippedDeltaSize = 0;
+    for (size_t i = keyframe; i < pastFrames; i++)
+      skippedDeltaSize += m_frames[i].delta.size();
+
+    // the keyframe is decompressed aside, so a failure leaves the current frame intact
+    uint8_t* keyframeState = reinterpret_cast<uint8_t*>(m_nextFrame.get());
+    if (KeyframeSize(m_frames[keyframe]) < skippedDeltaSize && keyframeState != nullptr &&
+        DecompressKeyframe(m_frames[keyframe], keyframeState))
+    {
+      std::swap(m_currentFrame, m_nextFrame);
+      position = keyframe;
+    }
+  }
+
+  // Deltas turn a frame into the one before it. A delta which can't be
+  // applied leaves the state as it was, so the rewind stops at that frame.
+  uint8_t* state = reinterpret_cast<uint8_t*>(m_currentFrame.get());
+  while (position > target && ApplyDelta(m_frames[position - 1], state))
+    position--;
+
+  if (position == pastFrames)
+    return 0;
+
+  // Restore frame history
+  m_currentFrameHistory = m_frames[position].frameHistoryCount;
+
+  while (m_frames.size() > position)
+    PopBack();
+
+  return pastFrames - position;
+}
+
+void CKeyframeMemoryStream::CullPastFrames(uint64_t frameCount)
+{
+  for (uint64_t removedCount = 0; removedCount < frameCount; removedCount++)
+  {
+    if (m_frames.empty())
+    {
+      CLog::Log(LOGDEBUG,
+                "CKeyframeMemoryStream: Tried to cull {} frames too many. Check your math!",
+                frameCount - removedCount);
+      break;
+    }
+    PopFront();
+  }
+}
+
+bool CKeyframeMemoryStream::IsKeyframe(size_t index) const
+{
+  return (m_culledFrames + index) % m_keyframeInterval == 0;
+}
+
+bool CKeyframeMemoryStream::HasKeyframe(const MemoryFrame& frame) const
+{
+  return frame.keyframe.size() == m_keyframeChunkCount;
+}
+
+void CKeyframeMemoryStream::CompressKeyframeChunk()
+{
+  if (m_pendingKeyframe.empty())
+    return;
+
+  MemoryFrame& frame = m_frames[static_cast<size_t>(m_pendingKeyframeSequence - m_culledFrames)];
+  const size_t offset = frame.keyframe.size() * m_keyframeChunkSize;
+  const size_t chunkSize = std::min(m_keyframeChunkSize, m_pendingKeyframe.size() - offset);
+
+  frame.keyframe.emplace_back();
+  if (!Compress(m_pendingKeyframe.data() + offset, chunkSize, frame.keyframe.back()))
+  {
+    // without all of its chunks the keyframe is useless
+    m_memoryUsage -= KeyframeSize(frame);
+    frame.keyframe.clear();
+    m_pendingKeyframe.clear();
+    return;
+  }
+  m_memoryUsage += frame.keyframe.back().size();
+
+  if (HasKeyframe(frame))
+    m_pendingKeyframe.clear();
+}
+
+bool CKeyframeMemoryStream::Compress(const uint8_t* data,
+                                     size_t size,
+                                     std::vector<uint8_t>& compressed)
+{
+  lzo_uint compressedSize = static_cast<lzo_uint>(m_compressBuffer.size());
+  if (lzo1x_1_compress(data, static_cast<lzo_uint>(size), m_compressBuffer.data(),
+                       &compressedSize, m_compressWorkMemory.data()) != LZO_E_OK)
+  {
+    CLog::Log(LOGERROR, "CKeyframeMemoryStream: Failed to compress frame");
+    return false;
+  }
+
+  compressed.assign(m_compressBuffer.begin(), m_compressBuffer.begin() + compressedSize);
+  return true;
+}
+
+bool CKeyframeMemoryStream::Decompress(const std::vector<uint8_t>& compressed,
+                                       uint8_t* data,
+                                       size_t size)
+{
+  lzo_uint decompressedSize = static_cast<lzo_uint>(size);
+  if (lzo1x_decompress_safe(compressed.data(), static_cast<lzo_uint>(compressed.size()), data,
+                            &decompressedSize, nullptr) != LZO_E_OK ||
+      decompressedSize != size)
+  {
+    CLog::Log(LOGERROR, "CKeyframeMemoryStream: Failed to decompress frame");
+    return false;
+  }
+
+  return true;
+}
+
+bool CKeyframeMemoryStream::DecompressKeyframe(const MemoryFrame& frame, uint8_t* state)
+{
+  const size_t frameSize = FrameSize();
+
+  size_t offset = 0;
+  for (const auto& chunk : frame.keyframe)
+  {
+    const size_t chunkSize = std::min(m_keyframeChunkSize, frameSize - offset);
+    if (!Decompress(chunk, state + offset, chunkSize))
+      return false;
+    offset += chunkSize;
+  }
+
+  return true;
+}
+
+bool CKeyframeMemoryStream::ApplyDelta(const MemoryFrame& frame, uint8_t* state)
+{
+  if (frame.changedBlocks.empty())
+    return true;
+
+  const size_t frameSize = FrameSize();
+
+  size_t deltaSize = 0;
+  for (const uint32_t block : frame.changedBlocks)
+    deltaSize += std::min(BLOCK_SIZE, frameSize - block * BLOCK_SIZE);
+
+  if (!Decompress(frame.delta, m_deltaBuffer.data(), deltaSize))
+    return false;
+
+  const uint8_t* delta = m_deltaBuffer.data();
+  for (const uint32_t block : frame.changedBlocks)
+  {
+    const size_t offset = block * BLOCK_SIZE;
+    const size_t blockSize = std::min(BLOCK_SIZE, frameSize - offset);
+    ApplyXor(state + offset, delta, blockSize);
+    delta += blockSize;
+  }
+
+  return true;
+}
+
+void CKeyframeMemoryStream::PopFront()
+{
+  if (!m_pendingKeyframe.empty() && m_pendingKeyframeSequence == m_culledFrames)
+    m_pendingKeyframe.clear();
+
+  m_memoryUsage -= MemoryUsage(m_frames.front());
+  m_frames.pop_front();
+  m_culledFrames++;
+}
+
+void CKeyframeMemoryStream::PopBack()
+{
+  m_memoryUsage -= MemoryUsage(m_frames.back());
+  m_frames.pop_back();
+
+  if (!m_pendingKeyframe.empty() &&
+      m_pendingKeyframeSequence == m_culledFrames + m_frames.size())
+    m_pendingKeyframe.clear();
+}
+
+void CKeyframeMemoryStream::CullToMemoryBudget()
+{
+  while (m_maxMemory > 0 && m_memoryUsage > m_maxMemory && !m_frames.empty())
+    PopFront();
+}
+
+size_t CKeyframeMemoryStream::MemoryUsage(const MemoryFrame& frame)
+{
+  return sizeof(MemoryFrame) + frame.changedBlocks.size() * sizeof(uint32_t) +
+         frame.delta.size() + KeyframeSize(frame);
+}
+
+size_t CKeyframeMemoryStream::KeyframeSize(const MemoryFrame& frame)
+{
+  size_t size = 0;
+  for (const auto& chunk : frame.keyframe)
+    size += chunk.size();
+  return size;
+}
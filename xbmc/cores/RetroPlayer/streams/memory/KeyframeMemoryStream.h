@@ -0,0 +1,117 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "LinearMemoryStream.h"
+
+#include <deque>
+#include <stdint.h>
+#include <vector>
+
+namespace KODI
+{
+namespace RETRO
+{
+/*!
+ * \brief Implementation of a linear memory stream using compressed XOR deltas
+ *        and periodic keyframes
+ *
+ * The savestate is split into blocks. For every frame the blocks which
+ * changed are XORed with the following frame and compressed with LZO. Every
+ * keyframe interval'th frame is additionally stored as a whole, compressed.
+ * To keep the cost of a frame constant, keyframes are compressed in chunks,
+ * one per submitted frame, so they become usable one interval later.
+ *
+ * As XOR deltas can be applied in both directions, any frame can be restored
+ * from the keyframe following it, so rewinding any number of frames applies
+ * at most one keyframe interval of deltas. The keyframe is used whenever
+ * decompressing it and its deltas costs less than the deltas from the current
+ * frame.
+ *
+ * Besides the max frame count the history can be limited to a memory budget,
+ * in which case the oldest frames are dropped first.
+ */
+class CKeyframeMemoryStream : public CLinearMemoryStream
+{
+public:
+  /*!
+   * \param maxMemory Maximum size of the compressed history in bytes, or 0
+   *        for no limit
+   * \param keyframeInterval Number of frames between two keyframes
+   */
+  explicit CKeyframeMemoryStream(size_t maxMemory = 0, unsigned int keyframeInterval = 60);
+
+  ~CKeyframeMemoryStream() override = default;
+
+  // implementation of IMemoryStream via CLinearMemoryStream
+  void Init(size_t frameSize, uint64_t maxFrameCount) override;
+  void Reset() override;
+  uint64_t PastFramesAvailable() const override;
+  uint64_t RewindFrames(uint64_t frameCount) override;
+
+  /*!
+   * \brief Update the memory budget, dropping old frames if necessary
+   *
+   * \param maxMemory Maximum size of the compressed history in bytes, or 0
+   *        for no limit
+   */
+  void SetMaxMemory(size_t maxMemory);
+
+  /*!
+   * \brief Return the size of the compressed history in bytes
+   */
+  size_t MemoryUsage() const { return m_memoryUsage; }
+
+protected:
+  // implementation of CLinearMemoryStream
+  void SubmitFrameInternal() override;
+  void CullPastFrames(uint64_t frameCount) override;
+
+private:
+  struct MemoryFrame
+  {
+    std::vector<uint32_t> changedBlocks; // blocks which differ from the following frame
+    std::vector<uint8_t> delta; // compressed XOR of the changed blocks
+    std::vector<std::vector<uint8_t>> keyframe; // compressed chunks of the frame if a keyframe
+    uint64_t frameHistoryCount;
+  };
+
+  bool IsKeyframe(size_t index) const;
+  bool HasKeyframe(const MemoryFrame& frame) const;
+  void CompressKeyframeChunk();
+  bool Compress(const uint8_t* data, size_t size, std::vector<uint8_t>& compressed);
+  bool Decompress(const std::vector<uint8_t>& compressed, uint8_t* data, size_t size);
+  bool DecompressKeyframe(const MemoryFrame& frame, uint8_t* state);
+  bool ApplyDelta(const MemoryFrame& frame, uint8_t* state);
+  void PopFront();
+  void PopBack();
+  void CullToMemoryBudget();
+
+  static size_t MemoryUsage(const MemoryFrame& frame);
+  static size_t KeyframeSize(const MemoryFrame& frame);
+
+  const unsigned int m_keyframeInterval;
+  size_t m_maxMemory;
+
+  std::deque<MemoryFrame> m_frames;
+  uint64_t m_culledFrames = 0; // frames dropped from the front, to tell keyframes apart
+  size_t m_memoryUsage = 0;
+
+  // Copy of the keyframe whose chunks are still being compressed, empty if none
+  std::vector<uint8_t> m_pendingKeyframe;
+  uint64_t m_pendingKeyframeSequence = 0;
+  size_t m_keyframeChunkSize = 0;
+  size_t m_keyframeChunkCount = 0;
+
+  std::vector<uint8_t> m_deltaBuffer;
+  std::vector<uint8_t> m_compressBuffer;
+  std::vector<uint8_t> m_compressWorkMemory;
+};
+} // namespace RETRO
+} // namespace KODI
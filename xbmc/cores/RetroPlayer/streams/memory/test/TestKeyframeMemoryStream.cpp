@@ -0,0 +1,229 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/RetroPlayer/streams/memory/DeltaPairMemoryStream.h"
+#include "cores/RetroPlayer/streams/memory/KeyframeMemoryStream.h"
+
+#include <chrono>
+#include <cstring>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace KODI;
+using namespace RETRO;
+
+namespace
+{
+/*!
+ * \brief Generates savestates shaped like an emulator's: mostly static
+ *        memory, with a few regions changing every frame
+ */
+class CStateGenerator
+{
+public:
+  CStateGenerator(size_t frameSize, size_t changesPerFrame)
+    : m_state(frameSize), m_changesPerFrame(changesPerFrame)
+  {
+    for (size_t i = 0; i < frameSize; i++)
+      m_state[i] = static_cast<uint8_t>(i / 4096);
+  }
+
+  const std::vector<uint8_t>& NextFrame()
+  {
+    for (size_t i = 0; i < m_changesPerFrame; i++)
+    {
+      m_seed = m_seed * 6364136223846793005ULL + 1442695040888963407ULL;
+      m_state[(m_seed >> 33) % m_state.size()] = static_cast<uint8_t>(m_seed >> 56);
+    }
+    // a counter in a fixed place, like a frame timer
+    m_state[100]++;
+    return m_state;
+  }
+
+private:
+  std::vector<uint8_t> m_state;
+  size_t m_changesPerFrame;
+  uint64_t m_seed = 1;
+};
+
+void SubmitFrame(IMemoryStream& stream, const std::vector<uint8_t>& state)
+{
+  std::memcpy(stream.BeginFrame(), state.data(), state.size());
+  stream.SubmitFrame();
+}
+
+bool CurrentFrameEquals(const IMemoryStream& stream, const std::vector<uint8_t>& state)
+{
+  return stream.CurrentFrame() != nullptr &&
+         std::memcmp(stream.CurrentFrame(), state.data(), state.size()) == 0;
+}
+
+class CDeltaPairMemoryStreamUsage : public CDeltaPairMemoryStream
+{
+public:
+  size_t MemoryUsage() const
+  {
+    size_t usage = 0;
+    for (const auto& frame : m_rewindBuffer)
+      usage += sizeof(frame) + frame.buffer.size() * sizeof(DeltaPair);
+    return usage;
+  }
+};
+} // namespace
+
+TEST(TestKeyframeMemoryStream, RewindRestoresFrames)
+{
+  // not a multiple of the block size
+  const size_t frameSize = 100 * 1000 + 3;
+  CStateGenerator generator(frameSize, 50);
+
+  CKeyframeMemoryStream stream(0, 16);
+  stream.Init(frameSize, 1000);
+
+  std::vector<std::vector<uint8_t>> frames;
+  for (unsigned int i = 0; i < 300; i++)
+  {
+    frames.push_back(generator.NextFrame());
+    SubmitFrame(stream, frames.back());
+  }
+  ASSERT_EQ(299u, stream.PastFramesAvailable());
+  ASSERT_TRUE(CurrentFrameEquals(stream, frames.back()));
+
+  for (const uint64_t rewind : {1, 5, 37, 16, 100})
+  {
+    EXPECT_EQ(rewind, stream.RewindFrames(rewind));
+    frames.resize(frames.size() - rewind);
+    EXPECT_EQ(frames.size() - 1, stream.PastFramesAvailable());
+    EXPECT_EQ(frames.size() - 1, stream.GetFrameCounter());
+    EXPECT_TRUE(CurrentFrameEquals(stream, frames.back())) << "after rewinding " << rewind;
+  }
+
+  // play on from the rewound frame
+  for (unsigned int i = 0; i < 20; i++)
+  {
+    frames.push_back(generator.NextFrame());
+    SubmitFrame(stream, frames.back());
+  }
+  EXPECT_EQ(frames.size() - 1, stream.PastFramesAvailable());
+
+  const uint64_t available = stream.PastFramesAvailable();
+  EXPECT_EQ(available, stream.RewindFrames(available + 10));
+  EXPECT_TRUE(CurrentFrameEquals(stream, frames.front()));
+}
+
+TEST(TestKeyframeMemoryStream, RewindWhileKeyframesArePending)
+{
+  const size_t frameSize = 50 * 1000;
+  CStateGenerator generator(frameSize, 20);
+
+  // keyframes are completed over the 16 frames following them
+  CKeyframeMemoryStream stream(0, 16);
+  stream.Init(frameSize, 1000);
+
+  std::vector<std::vector<uint8_t>> frames;
+  const auto play = [&](unsigned int count) {
+    for (unsigned int i = 0; i < count; i++)
+    {
+      frames.push_back(generator.NextFrame());
+      SubmitFrame(stream, frames.back());
+    }
+  };
+  const auto rewind = [&](uint64_t count) {
+    EXPECT_EQ(count, stream.RewindFrames(count));
+    frames.resize(frames.size() - count);
+    EXPECT_TRUE(CurrentFrameEquals(stream, frames.back())) << "after rewinding " << count;
+  };
+
+  // rewind within the frames of a pending keyframe, then past it
+  play(20);
+  rewind(2);
+  play(5);
+  rewind(10);
+  play(40);
+  rewind(30);
+  play(3);
+  rewind(1);
+  rewind(stream.PastFramesAvailable());
+  EXPECT_TRUE(CurrentFrameEquals(stream, frames.front()));
+}
+
+TEST(TestKeyframeMemoryStream, CulledFrames)
+{
+  const size_t frameSize = 20000;
+  CStateGenerator generator(frameSize, 10);
+
+  CKeyframeMemoryStream stream(0, 8);
+  stream.Init(frameSize, 50);
+
+  std::vector<std::vector<uint8_t>> frames;
+  for (unsigned int i = 0; i < 123; i++)
+  {
+    frames.push_back(generator.NextFrame());
+    SubmitFrame(stream, frames.back());
+  }
+  EXPECT_EQ(49u, stream.PastFramesAvailable());
+
+  // the oldest frame remaining doesn't need to be a keyframe
+  EXPECT_EQ(49u, stream.RewindFrames(100));
+  EXPECT_TRUE(CurrentFrameEquals(stream, frames[frames.size() - 50]));
+}
+
+TEST(TestKeyframeMemoryStream, MemoryBudget)
+{
+  const size_t frameSize = 64 * 1024;
+  const size_t budget = 256 * 1024;
+  CStateGenerator generator(frameSize, 100);
+
+  CKeyframeMemoryStream stream(budget);
+  stream.Init(frameSize, 10000);
+
+  for (unsigned int i = 0; i < 1000; i++)
+    SubmitFrame(stream, generator.NextFrame());
+
+  EXPECT_LE(stream.MemoryUsage(), budget);
+  EXPECT_GT(stream.PastFramesAvailable(), 0u);
+  EXPECT_LT(stream.PastFramesAvailable(), 1000u);
+
+  stream.SetMaxMemory(budget / 4);
+  EXPECT_LE(stream.MemoryUsage(), budget / 4);
+}
+
+TEST(TestKeyframeMemoryStream, Benchmark)
+{
+  using namespace std::chrono;
+
+  // a large savestate like the ones of N64 and PSX cores
+  const size_t frameSize = 16 * 1024 * 1024;
+  const unsigned int frameCount = 120;
+  const uint64_t rewind = 100;
+
+  const auto measure = [&](IMemoryStream& stream, const std::string& name, auto memoryUsage) {
+    CStateGenerator generator(frameSize, 2000);
+    stream.Init(frameSize, frameCount);
+
+    auto start = steady_clock::now();
+    for (unsigned int i = 0; i < frameCount; i++)
+      SubmitFrame(stream, generator.NextFrame());
+    RecordProperty(name + "SubmitUsPerFrame",
+                   static_cast<int>(duration_cast<microseconds>(steady_clock::now() - start).count() /
+                                    frameCount));
+    RecordProperty(name + "MemoryKiB", static_cast<int>(memoryUsage() / 1024));
+
+    start = steady_clock::now();
+    EXPECT_EQ(rewind, stream.RewindFrames(rewind));
+    RecordProperty(name + "RewindUs",
+                   static_cast<int>(duration_cast<microseconds>(steady_clock::now() - start).count()));
+  };
+
+  CDeltaPairMemoryStreamUsage deltaPairStream;
+  measure(deltaPairStream, "DeltaPair", [&]() { return deltaPairStream.MemoryUsage(); });
+
+  CKeyframeMemoryStream keyframeStream;
+  measure(keyframeStream, "Keyframe", [&]() { return keyframeStream.MemoryUsage(); });
+}
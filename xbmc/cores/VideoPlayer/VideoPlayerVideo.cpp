@@ -77,6 +77,8 @@ CVideoPlayerVideo::CVideoPlayerVideo(CDVDClock* pClock
   m_iFrameRateErr = 0;
   m_iFrameRateLength = 0;
   m_bFpsInvalid = false;
+
+  SetRole(ThreadRole::INTERACTIVE);
 }
 
 CVideoPlayerVideo::~CVideoPlayerVideo()
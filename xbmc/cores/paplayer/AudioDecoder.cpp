@@ -8,17 +8,21 @@
 
 #include "AudioDecoder.h"
 
+#include "CachedPCMCodec.h"
 #include "CodecFactory.h"
+#include "DecodedAudioCache.h"
 #include "FileItem.h"
 #include "ICodec.h"
 #include "ServiceBroker.h"
 #include "application/ApplicationComponents.h"
 #include "application/ApplicationVolumeHandling.h"
 #include "music/tags/MusicInfoTag.h"
+#include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
 #include "utils/log.h"
 
+#include <algorithm>
 #include <cmath>
 #include <mutex>
 
@@ -81,6 +85,10 @@ bool CAudioDecoder::Create(const CFileItem &file, int64_t seekOffset)
   // create our codec
   m_codec=CodecFactory::CreateCodecDemux(file, filecache * 1024);
 
+  // play from, or decode into, the decoded audio cache if it's enabled
+  if (m_codec && CDecodedAudioCache::GetInstance().IsEnabled())
+    m_codec = new CachedPCMCodec(std::unique_ptr<ICodec>(m_codec));
+
   if (!m_codec || !m_codec->Init(file, filecache * 1024))
   {
     CLog::Log(LOGERROR, "CAudioDecoder: Unable to Init Codec while loading file {}",
@@ -97,8 +105,19 @@ bool CAudioDecoder::Create(const CFileItem &file, int64_t seekOffset)
     return false;
   }
 
-  /* allocate the pcmBuffer for 2 seconds of audio */
-  m_pcmBuffer.Create(2 * blockSize * m_codec->m_format.m_sampleRate);
+  /* allocate the pcmBuffer for the configured time of audio. The size is bounded, as the time
+     is worth a lot of memory with high resolution formats */
+  const std::shared_ptr<CAdvancedSettings> advancedSettings =
+      CServiceBroker::GetSettingsComponent()->GetAdvancedSettings();
+  uint64_t bufferSize = static_cast<uint64_t>(blockSize) * m_codec->m_format.m_sampleRate *
+                        advancedSettings->m_musicDecodeBufferTime / 1000;
+  bufferSize = std::min<uint64_t>(bufferSize, advancedSettings->m_musicDecodeBufferSize * 1024ULL);
+  bufferSize = std::max<uint64_t>(bufferSize, 4 * INPUT_SIZE);
+  bufferSize -= bufferSize % blockSize;
+  m_pcmBuffer.Create(static_cast<unsigned int>(bufferSize));
+
+  CLog::Log(LOGDEBUG, "CAudioDecoder: Decode buffer of {} KiB for {} ms of audio", bufferSize / 1024,
+            bufferSize * 1000 / (static_cast<uint64_t>(blockSize) * m_codec->m_format.m_sampleRate));
 
   if (file.HasMusicInfoTag())
   {
@@ -227,6 +246,21 @@ void *CAudioDecoder::GetData(unsigned int samples)
   return NULL;
 }
 
+unsigned int CAudioDecoder::GetBufferLevel()
+{
+  if (!m_codec)
+    return 0;
+
+  if (m_codec->m_format.m_dataFormat == AE_FMT_RAW)
+    return m_rawBufferSize ? 100 : 0;
+
+  if (m_pcmBuffer.getSize() == 0)
+    return 0;
+
+  return static_cast<unsigned int>(static_cast<uint64_t>(m_pcmBuffer.getMaxReadSize()) * 100 /
+                                   m_pcmBuffer.getSize());
+}
+
 uint8_t *CAudioDecoder::GetRawData(int &size)
 {
   if (m_status == STATUS_ENDING)
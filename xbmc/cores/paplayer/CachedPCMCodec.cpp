@@ -0,0 +1,315 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "CachedPCMCodec.h"
+
+#include "utils/log.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include <lzo/lzo1x.h>
+#include <lzo/lzoconf.h>
+
+namespace
+{
+// Worst case size of LZO compressed data
+constexpr size_t CompressBound(size_t size)
+{
+  return size + size / 16 + 64 + 3;
+}
+} // namespace
+
+CachedPCMCodec::CachedPCMCodec(std::unique_ptr<ICodec> codec) : m_codec(std::move(codec))
+{
+  m_CodecName = m_codec->m_CodecName;
+}
+
+CachedPCMCodec::~CachedPCMCodec()
+{
+  AbortRecording();
+}
+
+bool CachedPCMCodec::Init(const CFileItem &file, unsigned int filecache)
+{
+  CDecodedAudioCache& cache = CDecodedAudioCache::GetInstance();
+
+  m_key = CDecodedAudioCache::GetKey(file);
+  if (!m_key.empty())
+    m_entry = cache.Get(m_key);
+
+  if (m_entry)
+  {
+    // the file doesn't need to be opened
+    m_codec.reset();
+
+    m_format = m_entry->format;
+    m_bitsPerSample = m_entry->bitsPerSample;
+    m_bitsPerCodedSample = m_entry->bitsPerCodedSample;
+    m_bitRate = m_entry->bitRate;
+    m_CodecName = m_entry->codecName;
+    m_tag = m_entry->tag;
+    m_TotalTime = static_cast<int64_t>(m_entry->totalBytes / FrameSize() * 1000 /
+                                       m_format.m_sampleRate);
+    return true;
+  }
+
+  if (!m_codec->Init(file, filecache))
+    return false;
+
+  m_format = m_codec->m_format;
+  m_bitsPerSample = m_codec->m_bitsPerSample;
+  m_bitsPerCodedSample = m_codec->m_bitsPerCodedSample;
+  m_bitRate = m_codec->m_bitRate;
+  m_CodecName = m_codec->m_CodecName;
+  m_tag = m_codec->m_tag;
+  m_TotalTime = m_codec->m_TotalTime;
+
+  // passthrough streams and streams which can't be seeked in aren't cached
+  if (m_key.empty() || m_format.m_dataFormat == AE_FMT_RAW || !m_codec->CanSeek() ||
+      FrameSize() == 0 || m_format.m_sampleRate == 0)
+    return true;
+
+  if (lzo_init() != LZO_E_OK)
+  {
+    CLog::Log(LOGERROR, "CachedPCMCodec: Failed to initialize LZO");
+    return true;
+  }
+
+  m_recording = std::make_shared<CDecodedAudioCache::Entry>();
+  m_pending.reserve(CDecodedAudioCache::BLOCK_SIZE);
+  m_compressBuffer.resize(CompressBound(CDecodedAudioCache::BLOCK_SIZE));
+  m_compressWorkMemory.resize(LZO1X_1_MEM_COMPRESS);
+
+  return true;
+}
+
+bool CachedPCMCodec::Seek(int64_t iSeekTime)
+{
+  if (m_entry)
+  {
+    const uint64_t frame = static_cast<uint64_t>(std::max<int64_t>(iSeekTime, 0)) *
+                           m_format.m_sampleRate / 1000;
+    m_position = std::min(frame * FrameSize(), m_entry->totalBytes);
+    return true;
+  }
+
+  // only a file decoded from start to end is complete
+  if (m_recording && (iSeekTime != 0 || m_recording->totalBytes + m_pending.size() != 0))
+    AbortRecording();
+
+  return m_codec->Seek(iSeekTime);
+}
+
+int CachedPCMCodec::ReadPCM(uint8_t* pBuffer, size_t size, size_t* actualsize)
+{
+  if (m_entry)
+    return ReadCached(pBuffer, size, actualsize);
+
+  const int result = m_codec->ReadPCM(pBuffer, size, actualsize);
+
+  if (m_recording)
+  {
+    if (result == READ_ERROR)
+      AbortRecording();
+    else if (!Record(pBuffer, *actualsize))
+      AbortRecording();
+    else if (result == READ_EOF)
+      FinishRecording();
+  }
+
+  return result;
+}
+
+int CachedPCMCodec::ReadRaw(uint8_t **pBuffer, int *bufferSize)
+{
+  if (!m_codec)
+    return READ_ERROR;
+
+  return m_codec->ReadRaw(pBuffer, bufferSize);
+}
+
+bool CachedPCMCodec::CanInit()
+{
+  return !m_codec || m_codec->CanInit();
+}
+
+bool CachedPCMCodec::CanSeek()
+{
+  return !m_codec || m_codec->CanSeek();
+}
+
+void CachedPCMCodec::SetTotalTime(int64_t totaltime)
+{
+  // the length of cached audio is exact
+  if (m_codec)
+  {
+    m_codec->SetTotalTime(totaltime);
+    m_TotalTime = m_codec->m_TotalTime;
+  }
+}
+
+bool CachedPCMCodec::IsCaching() const
+{
+  return m_codec && m_codec->IsCaching();
+}
+
+int CachedPCMCodec::GetCacheLevel() const
+{
+  return m_codec ? m_codec->GetCacheLevel() : -1;
+}
+
+unsigned int CachedPCMCodec::FrameSize() const
+{
+  return (m_bitsPerSample >> 3) * m_format.m_channelLayout.Count();
+}
+
+int CachedPCMCodec::ReadCached(uint8_t* pBuffer, size_t size, size_t* actualsize)
+{
+  *actualsize = 0;
+
+  while (size > 0 && m_position < m_entry->totalBytes)
+  {
+    const size_t index = static_cast<size_t>(m_position / CDecodedAudioCache::BLOCK_SIZE);
+    const uint64_t blockStart = static_cast<uint64_t>(index) * CDecodedAudioCache::BLOCK_SIZE;
+    const size_t blockSize = static_cast<size_t>(std::min<uint64_t>(
+        CDecodedAudioCache::BLOCK_SIZE, m_entry->totalBytes - blockStart));
+
+    // blocks which didn't compress are read in place
+    const uint8_t* block = m_entry->blocks[index].data();
+    if (m_entry->blocks[index].size() != blockSize)
+    {
+      if ((!m_blockLoaded || index != m_blockIndex) && !LoadBlock(index))
+        return READ_ERROR;
+      block = m_block.data();
+    }
+
+    const size_t offset = static_cast<size_t>(m_position - blockStart);
+    const size_t copySize = std::min(size, blockSize - offset);
+    std::memcpy(pBuffer, block + offset, copySize);
+
+    pBuffer += copySize;
+    size -= copySize;
+    *actualsize += copySize;
+    m_position += copySize;
+  }
+
+  return m_position < m_entry->totalBytes ? READ_SUCCESS : READ_EOF;
+}
+
+bool CachedPCMCodec::LoadBlock(size_t index)
+{
+  const uint64_t blockStart = static_cast<uint64_t>(index) * CDecodedAudioCache::BLOCK_SIZE;
+  const size_t blockSize = static_cast<size_t>(std::min<uint64_t>(
+      CDecodedAudioCache::BLOCK_SIZE, m_entry->totalBytes - blockStart));
+  const std::vector<uint8_t>& compressed = m_entry->blocks[index];
+
+  m_block.resize(blockSize);
+  lzo_uint decompressedSize = static_cast<lzo_uint>(blockSize);
+  if (lzo1x_decompress_safe(compressed.data(), static_cast<lzo_uint>(compressed.size()),
+                            m_block.data(), &decompressedSize, nullptr) != LZO_E_OK ||
+      decompressedSize != blockSize)
+  {
+    CLog::Log(LOGERROR, "CachedPCMCodec: Failed to decompress block {}", index);
+    m_blockLoaded = false;
+    return false;
+  }
+
+  m_blockIndex = index;
+  m_blockLoaded = true;
+  return true;
+}
+
+bool CachedPCMCodec::Record(const uint8_t* data, size_t size)
+{
+  while (size > 0)
+  {
+    const size_t copySize = std::min(size, CDecodedAudioCache::BLOCK_SIZE - m_pending.size());
+    m_pending.insert(m_pending.end(), data, data + copySize);
+    data += copySize;
+    size -= copySize;
+
+    if (m_pending.size() == CDecodedAudioCache::BLOCK_SIZE && !CompressPending())
+      return false;
+  }
+
+  return true;
+}
+
+bool CachedPCMCodec::CompressPending()
+{
+  lzo_uint compressedSize = static_cast<lzo_uint>(m_compressBuffer.size());
+  if (lzo1x_1_compress(m_pending.data(), static_cast<lzo_uint>(m_pending.size()),
+                       m_compressBuffer.data(), &compressedSize,
+                       m_compressWorkMemory.data()) != LZO_E_OK)
+  {
+    CLog::Log(LOGERROR, "CachedPCMCodec: Failed to compress block");
+    return false;
+  }
+
+  // keep the block as it is if compressing doesn't pay, which saves decompressing it on reads
+  const bool compressed = compressedSize < m_pending.size();
+  const size_t storedSize = compressed ? compressedSize : m_pending.size();
+
+  // give up on files which wouldn't fit next to the other recordings
+  const size_t memoryUsage = storedSize + sizeof(std::vector<uint8_t>);
+  if (!CDecodedAudioCache::GetInstance().Reserve(memoryUsage))
+    return false;
+  m_recording->memoryUsage += memoryUsage;
+
+  if (compressed)
+    m_recording->blocks.emplace_back(m_compressBuffer.begin(),
+                                     m_compressBuffer.begin() + compressedSize);
+  else
+    m_recording->blocks.emplace_back(m_pending.begin(), m_pending.end());
+  m_recording->totalBytes += m_pending.size();
+  m_pending.clear();
+
+  return true;
+}
+
+void CachedPCMCodec::FinishRecording()
+{
+  if (!m_pending.empty() && !CompressPending())
+  {
+    AbortRecording();
+    return;
+  }
+
+  if (m_recording->totalBytes > 0)
+  {
+    m_recording->format = m_format;
+    m_recording->bitsPerSample = m_bitsPerSample;
+    m_recording->bitsPerCodedSample = m_bitsPerCodedSample;
+    m_recording->bitRate = m_bitRate;
+    m_recording->codecName = m_CodecName;
+    m_recording->tag = m_tag;
+
+    // the entry takes over the reserved memory
+    CDecodedAudioCache& cache = CDecodedAudioCache::GetInstance();
+    cache.Release(m_recording->memoryUsage);
+    cache.Add(m_key, std::move(m_recording));
+  }
+
+  AbortRecording();
+}
+
+void CachedPCMCodec::AbortRecording()
+{
+  if (m_recording)
+    CDecodedAudioCache::GetInstance().Release(m_recording->memoryUsage);
+
+  m_recording.reset();
+  m_pending.clear();
+  m_pending.shrink_to_fit();
+  m_compressBuffer.clear();
+  m_compressBuffer.shrink_to_fit();
+  m_compressWorkMemory.clear();
+  m_compressWorkMemory.shrink_to_fit();
+}
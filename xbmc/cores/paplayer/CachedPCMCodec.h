@@ -0,0 +1,66 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "DecodedAudioCache.h"
+#include "ICodec.h"
+
+#include <memory>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+/*!
+ * \brief Codec playing files from the decoded audio cache
+ *
+ * On a cache hit the file isn't opened at all and the decoded audio is read
+ * from the cache. Otherwise the wrapped codec is used, and the audio it
+ * decodes is recorded into the cache if the file is played from start to end.
+ */
+class CachedPCMCodec : public ICodec
+{
+public:
+  explicit CachedPCMCodec(std::unique_ptr<ICodec> codec);
+  ~CachedPCMCodec() override;
+
+  bool Init(const CFileItem &file, unsigned int filecache) override;
+  bool Seek(int64_t iSeekTime) override;
+  int ReadPCM(uint8_t* pBuffer, size_t size, size_t* actualsize) override;
+  int ReadRaw(uint8_t **pBuffer, int *bufferSize) override;
+  bool CanInit() override;
+  bool CanSeek() override;
+  void SetTotalTime(int64_t totaltime) override;
+  bool IsCaching() const override;
+  int GetCacheLevel() const override;
+
+private:
+  unsigned int FrameSize() const;
+  int ReadCached(uint8_t* pBuffer, size_t size, size_t* actualsize);
+  bool LoadBlock(size_t index);
+  bool Record(const uint8_t* data, size_t size);
+  bool CompressPending();
+  void FinishRecording();
+  void AbortRecording();
+
+  std::unique_ptr<ICodec> m_codec; // the wrapped codec, reset on a cache hit
+  std::string m_key;
+
+  // Playing from the cache
+  std::shared_ptr<const CDecodedAudioCache::Entry> m_entry;
+  uint64_t m_position = 0; // decoded bytes
+  std::vector<uint8_t> m_block; // the decompressed block at m_blockIndex
+  size_t m_blockIndex = 0;
+  bool m_blockLoaded = false;
+
+  // Recording into the cache
+  std::shared_ptr<CDecodedAudioCache::Entry> m_recording; // its memory is reserved in the cache
+  std::vector<uint8_t> m_pending; // decoded audio of the block being recorded
+  std::vector<uint8_t> m_compressBuffer;
+  std::vector<uint8_t> m_compressWorkMemory;
+};
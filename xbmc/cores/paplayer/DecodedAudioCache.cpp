@@ -0,0 +1,153 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "DecodedAudioCache.h"
+
+#include "FileItem.h"
+#include "URL.h"
+#include "filesystem/File.h"
+#include "utils/StringUtils.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <mutex>
+
+CDecodedAudioCache& CDecodedAudioCache::GetInstance()
+{
+  static CDecodedAudioCache cache;
+  return cache;
+}
+
+std::string CDecodedAudioCache::GetKey(const CFileItem& file)
+{
+  // streams can't be decoded up front and aren't played the same twice
+  if (file.IsInternetStream() || file.IsCDDA())
+    return "";
+
+  const std::string& path = file.GetDynPath();
+
+  struct __stat64 buffer;
+  if (XFILE::CFile::Stat(path, &buffer) != 0 || buffer.st_mtime == 0)
+    return "";
+
+  return StringUtils::Format("{}|{}|{}", path, static_cast<int64_t>(buffer.st_mtime),
+                             static_cast<int64_t>(buffer.st_size));
+}
+
+void CDecodedAudioCache::SetMaxMemory(size_t maxMemory)
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  m_maxMemory = maxMemory;
+  Evict();
+}
+
+size_t CDecodedAudioCache::GetMaxMemory() const
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  return m_maxMemory;
+}
+
+std::shared_ptr<const CDecodedAudioCache::Entry> CDecodedAudioCache::Get(const std::string& key)
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+
+  auto it = m_index.find(key);
+  if (it == m_index.end())
+  {
+    m_misses++;
+    return {};
+  }
+
+  // move to the front of the LRU list
+  m_entries.splice(m_entries.begin(), m_entries, it->second);
+
+  m_hits++;
+  return it->second->second;
+}
+
+void CDecodedAudioCache::Add(const std::string& key, std::shared_ptr<const Entry> entry)
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+
+  if (entry->memoryUsage > m_maxMemory)
+    return;
+
+  auto it = m_index.find(key);
+  if (it != m_index.end())
+  {
+    m_memoryUsage -= it->second->second->memoryUsage;
+    m_entries.erase(it->second);
+    m_index.erase(it);
+  }
+
+  m_memoryUsage += entry->memoryUsage;
+  m_entries.emplace_front(key, std::move(entry));
+  m_index[key] = m_entries.begin();
+
+  CLog::Log(LOGDEBUG, "CDecodedAudioCache: Added {} ({} KiB)",
+            CURL::GetRedacted(key.substr(0, key.find('|'))),
+            m_entries.front().second->memoryUsage / 1024);
+
+  Evict();
+}
+
+bool CDecodedAudioCache::Reserve(size_t size)
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+
+  if (m_reserved + size > m_maxMemory)
+    return false;
+
+  m_reserved += size;
+  Evict();
+  return true;
+}
+
+void CDecodedAudioCache::Release(size_t size)
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  m_reserved -= std::min(size, m_reserved);
+}
+
+void CDecodedAudioCache::LogStats() const
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  LogStatsInternal();
+}
+
+void CDecodedAudioCache::Evict()
+{
+  if (m_memoryUsage + m_reserved <= m_maxMemory)
+    return;
+
+  while (m_memoryUsage + m_reserved > m_maxMemory && !m_entries.empty())
+  {
+    const auto& oldest = m_entries.back();
+    CLog::Log(LOGDEBUG, "CDecodedAudioCache: Evicting {}",
+              CURL::GetRedacted(oldest.first.substr(0, oldest.first.find('|'))));
+    m_memoryUsage -= oldest.second->memoryUsage;
+    m_index.erase(oldest.first);
+    m_entries.pop_back();
+    m_evictions++;
+  }
+
+  LogStatsInternal();
+}
+
+void CDecodedAudioCache::LogStatsInternal() const
+{
+  const uint64_t lookups = m_hits + m_misses;
+  if (lookups == 0)
+    return;
+
+  CLog::Log(LOGDEBUG,
+            "CDecodedAudioCache: Hit rate {:.1f}% ({} of {}), {} entries, {} of {} KiB, "
+            "{} KiB reserved, {} evicted",
+            100.0 * m_hits / lookups, m_hits, lookups, m_entries.size(), m_memoryUsage / 1024,
+            m_maxMemory / 1024, m_reserved / 1024, m_evictions);
+}
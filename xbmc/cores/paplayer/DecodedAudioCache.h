@@ -0,0 +1,123 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "cores/AudioEngine/Utils/AEAudioFormat.h"
+#include "music/tags/MusicInfoTag.h"
+#include "threads/CriticalSection.h"
+
+#include <list>
+#include <memory>
+#include <stdint.h>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class CFileItem;
+
+/*!
+ * \brief Cache of decoded audio of recently played files
+ *
+ * Files are decoded once and kept as PCM, split into blocks of a fixed size,
+ * so any position is found in the block index without scanning and the
+ * recorded audio is never reallocated as it grows. Blocks are LZO compressed
+ * unless that doesn't make them smaller. Entries are keyed by path and
+ * modification time, and the least recently used entries are evicted when
+ * the memory budget is exceeded.
+ *
+ * Files being recorded reserve their memory as they grow, so entries and
+ * recordings together stay within the budget.
+ */
+class CDecodedAudioCache
+{
+public:
+  // Decoded bytes per block
+  static constexpr size_t BLOCK_SIZE = 256 * 1024;
+
+  struct Entry
+  {
+    AEAudioFormat format;
+    int bitsPerSample = 0;
+    int bitsPerCodedSample = 0;
+    int bitRate = 0;
+    std::string codecName;
+    MUSIC_INFO::CMusicInfoTag tag;
+    uint64_t totalBytes = 0; // decoded size
+    // BLOCK_SIZE decoded bytes each, but the last. A block as large as its
+    // decoded size is stored uncompressed.
+    std::vector<std::vector<uint8_t>> blocks;
+    size_t memoryUsage = 0;
+  };
+
+  static CDecodedAudioCache& GetInstance();
+
+  /*!
+   * \brief Get the key of a file, or an empty string if it can't be cached
+   */
+  static std::string GetKey(const CFileItem& file);
+
+  /*!
+   * \brief Update the memory budget, evicting entries if necessary
+   *
+   * \param maxMemory Maximum size of the entries in bytes, or 0 to disable the
+   *        cache
+   */
+  void SetMaxMemory(size_t maxMemory);
+  size_t GetMaxMemory() const;
+  bool IsEnabled() const { return GetMaxMemory() > 0; }
+
+  /*!
+   * \brief Look up an entry, counting a hit or miss
+   */
+  std::shared_ptr<const Entry> Get(const std::string& key);
+
+  /*!
+   * \brief Add a completely decoded file
+   */
+  void Add(const std::string& key, std::shared_ptr<const Entry> entry);
+
+  /*!
+   * \brief Reserve memory for a file being recorded, evicting entries if
+   *        necessary
+   *
+   * \return false if the recordings would exceed the budget
+   */
+  bool Reserve(size_t size);
+
+  /*!
+   * \brief Release memory reserved with Reserve()
+   */
+  void Release(size_t size);
+
+  /*!
+   * \brief Log the hit rate and memory usage of the cache
+   */
+  void LogStats() const;
+
+private:
+  CDecodedAudioCache() = default;
+
+  void Evict();
+  void LogStatsInternal() const;
+
+  using EntryList = std::list<std::pair<std::string, std::shared_ptr<const Entry>>>;
+
+  mutable CCriticalSection m_critSection;
+  EntryList m_entries; // most recently used first
+  std::unordered_map<std::string, EntryList::iterator> m_index;
+  size_t m_maxMemory = 0;
+  size_t m_memoryUsage = 0;
+  size_t m_reserved = 0; // by files being recorded
+
+  // Statistics
+  uint64_t m_hits = 0;
+  uint64_t m_misses = 0;
+  uint64_t m_evictions = 0;
+};
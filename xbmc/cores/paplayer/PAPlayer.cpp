@@ -8,6 +8,7 @@
 
 #include "PAPlayer.h"
 
+#include "DecodedAudioCache.h"
 #include "FileItem.h"
 #include "ICodec.h"
 #include "ServiceBroker.h"
@@ -29,13 +30,18 @@
 #include "utils/log.h"
 #include "video/Bookmark.h"
 
+#include <algorithm>
 #include <mutex>
+#include <vector>
 
 using namespace std::chrono_literals;
 
 #define TIME_TO_CACHE_NEXT_FILE 5000 /* 5 seconds before end of song, start caching the next song */
 #define FAST_XFADE_TIME           80 /* 80 milliseconds */
 #define MAX_SKIP_XFADE_TIME     2000 /* max 2 seconds crossfade on track skip */
+#define MAX_FADE_WAIT_TIME      1000 /* fail safe, do not wait longer than 1 second for fades */
+#define DECODE_AHEAD_PACKETS       3 /* packets decoded ahead per pass to keep the decode buffer filled */
+#define MAX_DATA_WAIT_TIME        20 /* max 20 ms between checks of a codec or stream without data */
 
 // PAP: Psycho-acoustic Audio Player
 // Supporting all open  audio codec standards.
@@ -79,31 +85,9 @@ void PAPlayer::SoftStart(bool wait/* = false */)
     si->m_stream->FadeVolume(0.0f, 1.0f, FAST_XFADE_TIME);
   }
 
+  /* wait for them to fade in */
   if (wait)
-  {
-    /* wait for them to fade in */
-    lock.unlock();
-    CThread::Sleep(std::chrono::milliseconds(FAST_XFADE_TIME));
-    lock.lock();
-
-    /* be sure they have faded in */
-    while(wait)
-    {
-      wait = false;
-      for(StreamList::iterator itt = m_streams.begin(); itt != m_streams.end(); ++itt)
-      {
-        StreamInfo* si = *itt;
-        if (si->m_stream->IsFading())
-        {
-          lock.unlock();
-          wait = true;
-          CThread::Sleep(1ms);
-          lock.lock();
-          break;
-        }
-      }
-    }
-  }
+    WaitForFades(lock);
 }
 
 void PAPlayer::SoftStop(bool wait/* = false */, bool close/* = true */)
@@ -127,31 +111,9 @@ void PAPlayer::SoftStop(bool wait/* = false */, bool close/* = true */)
   /* if we are going to wait for them to finish fading */
   if(wait)
   {
-    // fail safe timer, do not wait longer than 1000ms
-    XbmcThreads::EndTime<> timer(1000ms);
-
-    /* wait for them to fade out */
-    lock.unlock();
-    CThread::Sleep(std::chrono::milliseconds(FAST_XFADE_TIME));
-    lock.lock();
-
-    /* be sure they have faded out */
-    while(wait && !CServiceBroker::GetActiveAE()->IsSuspended() && !timer.IsTimePast())
-    {
-      wait = false;
-      for(StreamList::iterator itt = m_streams.begin(); itt != m_streams.end(); ++itt)
-      {
-        StreamInfo* si = *itt;
-        if (si->m_stream && si->m_stream->IsFading())
-        {
-          lock.unlock();
-          wait = true;
-          CThread::Sleep(1ms);
-          lock.lock();
-          break;
-        }
-      }
-    }
+    /* wait for them to fade out, a suspended engine doesn't fade */
+    if (!CServiceBroker::GetActiveAE()->IsSuspended())
+      WaitForFades(lock);
 
     /* if we are not closing the streams, pause them */
     if (!close)
@@ -165,11 +127,47 @@ void PAPlayer::SoftStop(bool wait/* = false */, bool close/* = true */)
   }
 }
 
+bool PAPlayer::IsFading() const
+{
+  for (const StreamInfo* si : m_streams)
+  {
+    if (si->m_stream && si->m_stream->IsFading())
+      return true;
+  }
+  return false;
+}
+
+void PAPlayer::WaitForFades(std::unique_lock<CCriticalSection>& lock)
+{
+  if (!IsFading())
+    return;
+
+  // The processing thread signals when the fades started under the lock are done. Without the
+  // thread only the fade time can be waited for.
+  m_fadeEvent.Reset();
+  lock.unlock();
+  m_processEvent.Set();
+  if (IsRunning())
+    m_fadeEvent.Wait(std::chrono::milliseconds(MAX_FADE_WAIT_TIME));
+  else
+    m_fadeEvent.Wait(std::chrono::milliseconds(FAST_XFADE_TIME));
+  lock.lock();
+}
+
 void PAPlayer::CloseAllStreams(bool fade/* = true */)
 {
   if (!fade)
   {
     std::unique_lock<CCriticalSection> lock(m_streamsLock);
+
+    // the processing thread decodes ahead without holding the lock
+    while (m_decodingAhead)
+    {
+      lock.unlock();
+      m_decodeAheadEvent.Wait(100ms);
+      lock.lock();
+    }
+
     while (!m_streams.empty())
     {
       StreamInfo* si = m_streams.front();
@@ -214,6 +212,11 @@ bool PAPlayer::OpenFile(const CFileItem& file, const CPlayerOptions &options)
   m_defaultCrossfadeMS = CServiceBroker::GetSettingsComponent()->GetSettings()->GetInt(CSettings::SETTING_MUSICPLAYER_CROSSFADE) * 1000;
   m_fullScreen = options.fullscreen;
 
+  // leave the next stream enough time to fill its decode buffer
+  m_prepareAheadMS = std::max<unsigned int>(
+      TIME_TO_CACHE_NEXT_FILE,
+      2 * CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_musicDecodeBufferTime);
+
   if (m_streams.size() > 1 || !m_defaultCrossfadeMS || m_isPaused)
   {
     CloseAllStreams(!m_isPaused);
@@ -345,14 +348,17 @@ bool PAPlayer::QueueNextFileEx(const CFileItem &file, bool fadeIn)
     return false;
   }
 
-  /* decode until there is data-available */
+  /* decode ahead until the decode buffer is queued */
   si->m_decoder.Start();
+  std::chrono::milliseconds dataWait = 1ms;
   while (si->m_decoder.GetDataSize(true) == 0)
   {
     int status = si->m_decoder.GetStatus();
-    if (status == STATUS_ENDED   ||
-        status == STATUS_NO_FILE ||
-        si->m_decoder.ReadSamples(PACKET_SIZE) == RET_ERROR)
+    int result = RET_ERROR;
+    if (status != STATUS_ENDED && status != STATUS_NO_FILE)
+      result = si->m_decoder.ReadSamples(PACKET_SIZE);
+
+    if (result == RET_ERROR)
     {
       CLog::Log(LOGINFO, "PAPlayer::QueueNextFileEx - Error reading samples");
 
@@ -364,8 +370,19 @@ bool PAPlayer::QueueNextFileEx(const CFileItem &file, bool fadeIn)
       return false;
     }
 
-    /* yield our time so that the main PAP thread doesn't stall */
-    CThread::Sleep(1ms);
+    /* only wait if the codec has nothing for us, e.g. while its source is buffering. It can't
+     * tell when it has data again, so the wait gets longer while it stays empty */
+    if ((result == RET_SLEEP && m_abortEvent.Wait(dataWait)) || m_abortEvent.Signaled())
+    {
+      CLog::Log(LOGDEBUG, "PAPlayer::QueueNextFileEx - Aborted");
+
+      si->m_decoder.Destroy();
+      delete si;
+      return false;
+    }
+    dataWait = result == RET_SLEEP
+                   ? std::min<std::chrono::milliseconds>(2 * dataWait, MAX_DATA_WAIT_TIME * 1ms)
+                   : 1ms;
   }
 
   // set m_upcomingCrossfadeMS depending on type of file and user settings
@@ -413,8 +430,8 @@ bool PAPlayer::QueueNextFileEx(const CFileItem &file, bool fadeIn)
   // cd drives don't really like it to be crossfaded or prepared
   if (!file.IsCDDA())
   {
-    if (streamTotalTime >= TIME_TO_CACHE_NEXT_FILE + m_defaultCrossfadeMS)
-      si->m_prepareNextAtFrame = (int)((streamTotalTime - TIME_TO_CACHE_NEXT_FILE - m_defaultCrossfadeMS) * si->m_audioFormat.m_sampleRate / 1000.0f);
+    if (streamTotalTime >= m_prepareAheadMS + m_defaultCrossfadeMS)
+      si->m_prepareNextAtFrame = (int)((streamTotalTime - m_prepareAheadMS - m_defaultCrossfadeMS) * si->m_audioFormat.m_sampleRate / 1000.0f);
   }
 
   if (m_currentStream && ((m_currentStream->m_audioFormat.m_dataFormat == AE_FMT_RAW) || (si->m_audioFormat.m_dataFormat == AE_FMT_RAW)))
@@ -449,6 +466,7 @@ bool PAPlayer::QueueNextFileEx(const CFileItem &file, bool fadeIn)
   m_streams.push_back(si);
   //update the current stream to start playing the next track at the correct frame.
   UpdateStreamInfoPlayNextAtFrame(m_currentStream, m_upcomingCrossfadeMS);
+  m_processEvent.Set();
 
   return true;
 }
@@ -500,31 +518,46 @@ inline bool PAPlayer::PrepareStream(StreamInfo *si)
     // Clipping protection (when enabled in AE) by audio limiting, applied just where needed
     si->m_stream->SetAmplification(gain);
 
-  /* if its not the first stream and crossfade is not enabled */
-  if (m_currentStream && m_currentStream != si && !m_upcomingCrossfadeMS)
   {
-    /* slave the stream for gapless */
-    si->m_isSlaved = true;
-    m_currentStream->m_stream->RegisterSlave(si->m_stream.get());
+    std::unique_lock<CCriticalSection> lock(m_streamsLock);
+
+    /* if its not the first stream and crossfade is not enabled */
+    if (m_currentStream && m_currentStream != si && !m_upcomingCrossfadeMS)
+    {
+      /* slave the stream for gapless */
+      si->m_isSlaved = true;
+      m_currentStream->m_stream->RegisterSlave(si->m_stream.get());
+    }
   }
 
-  /* fill the stream's buffer */
+  /* fill the stream's buffer, without holding m_streamsLock as this takes a while */
+  std::chrono::milliseconds dataWait = 1ms;
   while(si->m_stream->IsBuffering())
   {
     int status = si->m_decoder.GetStatus();
-    if (status == STATUS_ENDED   ||
-        status == STATUS_NO_FILE ||
-        si->m_decoder.ReadSamples(PACKET_SIZE) == RET_ERROR)
+    int result = RET_ERROR;
+    if (status != STATUS_ENDED && status != STATUS_NO_FILE)
+      result = si->m_decoder.ReadSamples(PACKET_SIZE);
+
+    if (result == RET_ERROR)
     {
       CLog::Log(LOGINFO, "PAPlayer::PrepareStream - Stream Finished");
       break;
     }
 
+    const int framesSent = si->m_framesSent;
     if (!QueueData(si))
       break;
 
-    /* yield our time so that the main PAP thread doesn't stall */
-    CThread::Sleep(1ms);
+    /* wait whenever nothing was queued, e.g. while the codec's source is buffering or the
+     * stream doesn't take more data yet. Neither tells when that changes, so the wait gets
+     * longer while nothing is queued. Closing the file aborts the wait */
+    if (si->m_framesSent != framesSent)
+      dataWait = 1ms;
+    else if (m_abortEvent.Wait(dataWait))
+      break;
+    else
+      dataWait = std::min<std::chrono::milliseconds>(2 * dataWait, MAX_DATA_WAIT_TIME * 1ms);
   }
 
   CLog::Log(LOGINFO, "PAPlayer::PrepareStream - Ready");
@@ -542,9 +575,11 @@ bool PAPlayer::CloseFile(bool reopen)
   CloseAllStreams(false);
 
   /* wait for the thread to terminate */
+  m_processEvent.Set();
   StopThread(true);//true - wait for end of thread
 
-  // wait for any pending jobs to complete
+  // abort decoding ahead and wait for any pending jobs to complete
+  m_abortEvent.Set();
   {
     std::unique_lock<CCriticalSection> lock(m_streamsLock);
     while (m_jobCounter > 0)
@@ -554,6 +589,10 @@ bool PAPlayer::CloseFile(bool reopen)
       lock.lock();
     }
   }
+  m_abortEvent.Reset();
+
+  if (!reopen)
+    CDecodedAudioCache::GetInstance().LogStats();
 
   return true;
 }
@@ -578,11 +617,18 @@ void PAPlayer::Process()
 
     double freeBufferTime = 0.0;
     ProcessStreams(freeBufferTime);
+    DecodeAhead();
+
+    {
+      std::unique_lock<CCriticalSection> lock(m_streamsLock);
+      if (!IsFading())
+        m_fadeEvent.Set();
+    }
 
-    // if none of our streams wants at least 10ms of data, we sleep
+    // if none of our streams wants at least 10ms of data, we wait until they do or we are woken up
     if (freeBufferTime < 0.01)
     {
-      CThread::Sleep(10ms);
+      m_processEvent.Wait(10ms);
     }
 
     if (m_newForcedPlayerTime != -1)
@@ -684,6 +730,12 @@ inline void PAPlayer::ProcessStreams(double &freeBufferTime)
         }
       }
 
+      if (si->m_started)
+        CLog::Log(LOGDEBUG,
+                  "PAPlayer::ProcessStreams - Stream Finished, lowest decode buffer level {}%, {} "
+                  "underruns",
+                  si->m_minBufferLevel, si->m_underruns);
+
       /* unregister the audio callback */
       si->m_stream->UnRegisterAudioCallback();
       si->m_decoder.Destroy();
@@ -763,6 +815,7 @@ inline bool PAPlayer::ProcessStream(StreamInfo *si, double &freeBufferTime)
   {
     int64_t time = (int64_t)0;
     /* if its a direct seek */
+    si->m_starved = true; // the seek empties the decode buffer, don't count it as an underrun
     if (si->m_seekFrame > -1)
     {
       time = (int64_t)((float)si->m_seekFrame / (float)si->m_audioFormat.m_sampleRate * 1000.0f);
@@ -819,8 +872,8 @@ inline bool PAPlayer::ProcessStream(StreamInfo *si, double &freeBufferTime)
 
       // calculate time when to prepare next stream
       si->m_prepareNextAtFrame = 0;
-      if (streamTotalTime >= TIME_TO_CACHE_NEXT_FILE + m_defaultCrossfadeMS)
-        si->m_prepareNextAtFrame = (int)((streamTotalTime - TIME_TO_CACHE_NEXT_FILE - m_defaultCrossfadeMS) * si->m_audioFormat.m_sampleRate / 1000.0f);
+      if (streamTotalTime >= m_prepareAheadMS + m_defaultCrossfadeMS)
+        si->m_prepareNextAtFrame = (int)((streamTotalTime - m_prepareAheadMS - m_defaultCrossfadeMS) * si->m_audioFormat.m_sampleRate / 1000.0f);
 
       si->m_prepareTriggered = false;
       si->m_playNextAtFrame = 0;
@@ -846,6 +899,8 @@ inline bool PAPlayer::ProcessStream(StreamInfo *si, double &freeBufferTime)
   if (!QueueData(si))
     return false;
 
+  UpdateBufferHealth(si);
+
   /* update free buffer time if we are running */
   if (si->m_started)
   {
@@ -878,6 +933,56 @@ inline bool PAPlayer::ProcessStream(StreamInfo *si, double &freeBufferTime)
   return true;
 }
 
+void PAPlayer::DecodeAhead()
+{
+  /* decode more than is queued per pass, so the decode buffer fills up and absorbs stalls of the
+     codec. Reading from the codec can take a while, so this is done without holding
+     m_streamsLock, and CloseAllStreams() waits for it before deleting streams */
+  std::unique_lock<CCriticalSection> lock(m_streamsLock);
+  std::vector<StreamInfo*> streams;
+  for (StreamInfo* si : m_streams)
+  {
+    if (si->m_started && si->m_decoder.GetStatus() == STATUS_PLAYING)
+      streams.push_back(si);
+  }
+  if (streams.empty())
+    return;
+  m_decodingAhead = true;
+  lock.unlock();
+
+  for (StreamInfo* si : streams)
+  {
+    for (int i = 0; i < DECODE_AHEAD_PACKETS; ++i)
+    {
+      if (si->m_decoder.ReadSamples(PACKET_SIZE) != RET_SUCCESS)
+        break;
+    }
+  }
+
+  lock.lock();
+  m_decodingAhead = false;
+  m_decodeAheadEvent.Set();
+}
+
+void PAPlayer::UpdateBufferHealth(StreamInfo* si)
+{
+  if (!si->m_started || si->m_decoder.GetStatus() >= STATUS_ENDING)
+    return;
+
+  const unsigned int level = si->m_decoder.GetBufferLevel();
+  si->m_minBufferLevel = std::min(si->m_minBufferLevel, level);
+
+  /* the decoder ran dry while the audio engine is asking for data */
+  const bool starved = level == 0 && si->m_stream->GetSpace() > 0;
+  if (starved && !si->m_starved)
+  {
+    si->m_underruns++;
+    CLog::Log(LOGDEBUG, "PAPlayer::UpdateBufferHealth - Decode buffer underrun on {}",
+              CURL::GetRedacted(si->m_fileItem->GetDynPath()));
+  }
+  si->m_starved = starved;
+}
+
 bool PAPlayer::QueueData(StreamInfo *si)
 {
   unsigned int space = si->m_stream->GetSpace();
@@ -995,6 +1100,7 @@ void PAPlayer::SetSpeed(float speed)
     m_callback.OnPlayBackPaused();
   }
   m_signalSpeedChange = true;
+  m_processEvent.Set();
 }
 
 int64_t PAPlayer::GetTimeInternal()
@@ -1127,6 +1233,7 @@ void PAPlayer::SeekTime(int64_t iTime /*=0*/)
 
   m_currentStream->m_seekFrame = (int)((float)m_currentStream->m_audioFormat.m_sampleRate * ((float)iTime + (float)m_currentStream->m_startOffset) / 1000.0f);
   m_callback.OnPlayBackSeek(iTime, seekOffset);
+  m_processEvent.Set();
 }
 
 void PAPlayer::SeekPercentage(float fPercent /*=0*/)
@@ -18,6 +18,7 @@
 
 #include <atomic>
 #include <list>
+#include <mutex>
 #include <vector>
 
 class IAEStream;
@@ -107,6 +108,10 @@ private:
 
     bool m_isSlaved;                     /* true if the stream has been slaved to another */
     bool m_waitOnDrain;                  /* wait for stream being drained in AE */
+
+    unsigned int m_minBufferLevel = 100; /* lowest decode buffer level while playing, in percent */
+    unsigned int m_underruns = 0;        /* times the decoder ran dry while playing */
+    bool m_starved = false;              /* if the decoder is currently dry */
   };
 
   typedef std::list<StreamInfo*> StreamList;
@@ -120,7 +125,11 @@ private:
   bool m_fullScreen;
   unsigned int        m_defaultCrossfadeMS;  /* how long the default crossfade is in ms */
   unsigned int        m_upcomingCrossfadeMS; /* how long the upcoming crossfade is in ms */
+  unsigned int m_prepareAheadMS = 0;         /* how long before the end the next stream is prepared */
   CEvent              m_startEvent;          /* event for playback start */
+  CEvent m_processEvent;                     /* wakes up the processing thread */
+  CEvent m_fadeEvent;                        /* set by the processing thread when no stream fades */
+  CEvent m_abortEvent{true};                 /* aborts decoding ahead of the next stream */
   StreamInfo* m_currentStream = nullptr;
   IAudioCallback*     m_audioCallback;       /* the viz audio callback */
 
@@ -129,6 +138,8 @@ private:
   StreamList          m_finishing;           /* finishing streams */
   int                 m_jobCounter;
   CEvent              m_jobEvent;
+  bool m_decodingAhead = false;              /* streams are decoded ahead without m_streamsLock */
+  CEvent m_decodeAheadEvent;                 /* set when decoding ahead is done */
   int64_t             m_newForcedPlayerTime;
   int64_t             m_newForcedTotalTime;
   std::unique_ptr<CProcessInfo> m_processInfo;
@@ -136,10 +147,14 @@ private:
   bool QueueNextFileEx(const CFileItem &file, bool fadeIn);
   void SoftStart(bool wait = false);
   void SoftStop(bool wait = false, bool close = true);
+  bool IsFading() const;
+  void WaitForFades(std::unique_lock<CCriticalSection>& lock);
   void CloseAllStreams(bool fade = true);
   void ProcessStreams(double &freeBufferTime);
   bool PrepareStream(StreamInfo *si);
   bool ProcessStream(StreamInfo *si, double &freeBufferTime);
+  void DecodeAhead();
+  void UpdateBufferHealth(StreamInfo* si);
   bool QueueData(StreamInfo *si);
   int64_t GetTotalTime64();
   void UpdateCrossfadeTime(const CFileItem& file);
@@ -0,0 +1,231 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "FileItem.h"
+#include "cores/paplayer/CachedPCMCodec.h"
+#include "cores/paplayer/DecodedAudioCache.h"
+#include "test/TestUtils.h"
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+constexpr unsigned int SAMPLE_RATE = 48000;
+constexpr unsigned int FRAME_SIZE = 4; // 16 bit stereo
+constexpr uint64_t TOTAL_BYTES = 3 * SAMPLE_RATE * FRAME_SIZE; // 3 seconds, 2.2 blocks
+
+// Noise which doesn't compress in the first block, a repeating pattern which does in the others
+uint8_t PatternAt(uint64_t position)
+{
+  if (position < CDecodedAudioCache::BLOCK_SIZE)
+  {
+    uint64_t hash = (position + 1) * 0x9E3779B97F4A7C15ULL;
+    hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EBULL;
+    return static_cast<uint8_t>(hash ^ (hash >> 31));
+  }
+  return static_cast<uint8_t>(position % 251);
+}
+
+// Decodes a byte pattern which tells the position it was read from
+class CPatternCodec : public ICodec
+{
+public:
+  explicit CPatternCodec(bool& inited) : m_inited(inited) {}
+
+  bool Init(const CFileItem& file, unsigned int filecache) override
+  {
+    m_inited = true;
+    m_format.m_dataFormat = AE_FMT_S16NE;
+    m_format.m_sampleRate = SAMPLE_RATE;
+    m_format.m_channelLayout = AE_CH_LAYOUT_2_0;
+    m_bitsPerSample = 16;
+    m_TotalTime = TOTAL_BYTES / FRAME_SIZE * 1000 / SAMPLE_RATE;
+    return true;
+  }
+
+  bool Seek(int64_t iSeekTime) override
+  {
+    m_position = iSeekTime * SAMPLE_RATE / 1000 * FRAME_SIZE;
+    return true;
+  }
+
+  int ReadPCM(uint8_t* pBuffer, size_t size, size_t* actualsize) override
+  {
+    *actualsize = static_cast<size_t>(std::min<uint64_t>(size, TOTAL_BYTES - m_position));
+    for (size_t i = 0; i < *actualsize; i++)
+      pBuffer[i] = PatternAt(m_position++);
+    return m_position < TOTAL_BYTES ? READ_SUCCESS : READ_EOF;
+  }
+
+  bool CanInit() override { return true; }
+
+private:
+  bool& m_inited;
+  uint64_t m_position = 0;
+};
+
+std::shared_ptr<const CDecodedAudioCache::Entry> MakeEntry(size_t memoryUsage)
+{
+  auto entry = std::make_shared<CDecodedAudioCache::Entry>();
+  entry->memoryUsage = memoryUsage;
+  return entry;
+}
+} // namespace
+
+class TestDecodedAudioCache : public testing::Test
+{
+protected:
+  TestDecodedAudioCache() { CDecodedAudioCache::GetInstance().SetMaxMemory(0); }
+  ~TestDecodedAudioCache() override { CDecodedAudioCache::GetInstance().SetMaxMemory(0); }
+
+  // Play the file from start to end, which records it into the cache
+  void Record(const CFileItem& item)
+  {
+    bool inited = false;
+    CachedPCMCodec codec(std::make_unique<CPatternCodec>(inited));
+    ASSERT_TRUE(codec.Init(item, 0));
+    ASSERT_TRUE(inited);
+
+    std::vector<uint8_t> buffer(10000);
+    size_t actualSize = 0;
+    while (codec.ReadPCM(buffer.data(), buffer.size(), &actualSize) == READ_SUCCESS)
+      ;
+  }
+};
+
+TEST_F(TestDecodedAudioCache, InsertAndLookup)
+{
+  CDecodedAudioCache& cache = CDecodedAudioCache::GetInstance();
+  cache.SetMaxMemory(1024);
+
+  const std::shared_ptr<const CDecodedAudioCache::Entry> entry = MakeEntry(100);
+  cache.Add("a", entry);
+
+  EXPECT_EQ(entry, cache.Get("a"));
+  EXPECT_EQ(nullptr, cache.Get("b"));
+}
+
+TEST_F(TestDecodedAudioCache, RejectsEntryLargerThanBudget)
+{
+  CDecodedAudioCache& cache = CDecodedAudioCache::GetInstance();
+  cache.SetMaxMemory(1024);
+
+  cache.Add("a", MakeEntry(2048));
+
+  EXPECT_EQ(nullptr, cache.Get("a"));
+}
+
+TEST_F(TestDecodedAudioCache, EvictsLeastRecentlyUsed)
+{
+  CDecodedAudioCache& cache = CDecodedAudioCache::GetInstance();
+  cache.SetMaxMemory(300);
+
+  cache.Add("a", MakeEntry(100));
+  cache.Add("b", MakeEntry(100));
+  cache.Add("c", MakeEntry(100));
+
+  // using "a" makes "b" the least recently used entry
+  EXPECT_NE(nullptr, cache.Get("a"));
+  cache.Add("d", MakeEntry(100));
+
+  EXPECT_NE(nullptr, cache.Get("a"));
+  EXPECT_EQ(nullptr, cache.Get("b"));
+  EXPECT_NE(nullptr, cache.Get("c"));
+  EXPECT_NE(nullptr, cache.Get("d"));
+
+  // lowering the budget evicts entries right away
+  cache.SetMaxMemory(100);
+  EXPECT_EQ(nullptr, cache.Get("a"));
+  EXPECT_EQ(nullptr, cache.Get("c"));
+  EXPECT_NE(nullptr, cache.Get("d"));
+}
+
+TEST_F(TestDecodedAudioCache, RecordingsCountAgainstBudget)
+{
+  CDecodedAudioCache& cache = CDecodedAudioCache::GetInstance();
+  cache.SetMaxMemory(300);
+
+  cache.Add("a", MakeEntry(100));
+  cache.Add("b", MakeEntry(100));
+
+  // reserving memory for a recording evicts entries
+  EXPECT_TRUE(cache.Reserve(150));
+  EXPECT_EQ(nullptr, cache.Get("a"));
+  EXPECT_NE(nullptr, cache.Get("b"));
+
+  // recordings can't exceed the budget together
+  EXPECT_FALSE(cache.Reserve(200));
+  cache.Release(150);
+  EXPECT_TRUE(cache.Reserve(200));
+  cache.Release(200);
+}
+
+TEST_F(TestDecodedAudioCache, RecordsDecodedFile)
+{
+  CDecodedAudioCache& cache = CDecodedAudioCache::GetInstance();
+  cache.SetMaxMemory(16 * 1024 * 1024);
+
+  XFILE::CFile* file = XBMC_CREATETEMPFILE(".flac");
+  ASSERT_NE(nullptr, file);
+  const CFileItem item(XBMC_TEMPFILEPATH(file), false);
+
+  Record(item);
+
+  const std::string key = CDecodedAudioCache::GetKey(item);
+  const std::shared_ptr<const CDecodedAudioCache::Entry> entry = cache.Get(key);
+  ASSERT_NE(nullptr, entry);
+  EXPECT_EQ(TOTAL_BYTES, entry->totalBytes);
+  ASSERT_EQ(3u, entry->blocks.size());
+  EXPECT_EQ(CDecodedAudioCache::BLOCK_SIZE, entry->blocks[0].size());
+  EXPECT_LT(entry->blocks[1].size(), CDecodedAudioCache::BLOCK_SIZE / 10);
+  EXPECT_EQ(SAMPLE_RATE, entry->format.m_sampleRate);
+
+  EXPECT_TRUE(XBMC_DELETETEMPFILE(file));
+}
+
+TEST_F(TestDecodedAudioCache, SeekInsideCachedFile)
+{
+  CDecodedAudioCache::GetInstance().SetMaxMemory(16 * 1024 * 1024);
+
+  XFILE::CFile* file = XBMC_CREATETEMPFILE(".flac");
+  ASSERT_NE(nullptr, file);
+  const CFileItem item(XBMC_TEMPFILEPATH(file), false);
+
+  Record(item);
+
+  // a hit is played without initializing the wrapped codec
+  bool inited = false;
+  CachedPCMCodec codec(std::make_unique<CPatternCodec>(inited));
+  ASSERT_TRUE(codec.Init(item, 0));
+  EXPECT_FALSE(inited);
+  EXPECT_EQ(3000, codec.m_TotalTime);
+
+  // read across the boundary of the first, uncompressed, and the second, compressed, block
+  ASSERT_TRUE(codec.Seek(1000));
+  const uint64_t position = SAMPLE_RATE * FRAME_SIZE;
+  std::vector<uint8_t> buffer(CDecodedAudioCache::BLOCK_SIZE);
+  size_t actualSize = 0;
+  EXPECT_EQ(READ_SUCCESS, codec.ReadPCM(buffer.data(), buffer.size(), &actualSize));
+  ASSERT_EQ(buffer.size(), actualSize);
+  for (size_t i = 0; i < actualSize; i++)
+    ASSERT_EQ(PatternAt(position + i), buffer[i]) << "at byte " << position + i;
+
+  // the end of the file
+  ASSERT_TRUE(codec.Seek(2999));
+  const uint64_t endPosition = 2999 * SAMPLE_RATE / 1000 * FRAME_SIZE;
+  EXPECT_EQ(READ_EOF, codec.ReadPCM(buffer.data(), buffer.size(), &actualSize));
+  EXPECT_EQ(TOTAL_BYTES - endPosition, actualSize);
+  EXPECT_EQ(PatternAt(endPosition), buffer[0]);
+
+  EXPECT_TRUE(XBMC_DELETETEMPFILE(file));
+}
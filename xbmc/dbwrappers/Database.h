@@ -106,7 +106,7 @@ public:
 
   void BeginTransaction();
   virtual bool CommitTransaction();
-  void RollbackTransaction();
+  virtual void RollbackTransaction();
   void CopyDB(const std::string& latestDb);
   void DropAnalytics();
 
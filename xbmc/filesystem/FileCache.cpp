@@ -97,6 +97,7 @@ CFileCache::CFileCache(const unsigned int flags)
     m_fileSize(0),
     m_flags(flags)
 {
+  SetRole(ThreadRole::INTERACTIVE);
 }
 
 CFileCache::~CFileCache()
@@ -10,6 +10,8 @@
 
 #include "windowing/GraphicContext.h"
 
+#include <algorithm>
+#include <cmath>
 #include <stdio.h>
 
 void CUnionDirtyRegionSolver::Solve(const CDirtyRegionList &input, CDirtyRegionList &output)
@@ -71,3 +73,132 @@ void CGreedyDirtyRegionSolver::Solve(const CDirtyRegionList &input, CDirtyRegion
       output.push_back(currentRegion);
   }
 }
+
+CTileDirtyRegionSolver::CTileDirtyRegionSolver(int tileSize)
+  : m_tileSize(static_cast<float>(std::max(tileSize, 8)))
+{
+  // a render pass walks the whole control tree, so it is priced like filling 256x256 pixels
+  m_costNewRegion = 10.0f;
+  m_costPerArea = m_costNewRegion / (256.0f * 256.0f);
+}
+
+float CTileDirtyRegionSolver::Cost(const CDirtyRegion& region) const
+{
+  return m_costNewRegion + m_costPerArea * region.Area();
+}
+
+void CTileDirtyRegionSolver::Solve(const CDirtyRegionList &input, CDirtyRegionList &output)
+{
+  Solve(input, CServiceBroker::GetWinSystem()->GetGfxContext().GetViewWindow(), output);
+}
+
+void CTileDirtyRegionSolver::Solve(const CDirtyRegionList& input,
+                                   const CRect& viewport,
+                                   CDirtyRegionList& output)
+{
+  if (input.empty() || viewport.IsEmpty())
+    return;
+
+  const int cols = static_cast<int>(std::ceil(viewport.Width() / m_tileSize));
+  const int rows = static_cast<int>(std::ceil(viewport.Height() / m_tileSize));
+  m_tiles.assign(cols * rows, false);
+
+  bool dirty = false;
+  for (const auto& region : input)
+  {
+    CRect rect(region);
+    rect.Intersect(viewport);
+    if (rect.IsEmpty())
+      continue;
+
+    const int col1 = static_cast<int>((rect.x1 - viewport.x1) / m_tileSize);
+    const int row1 = static_cast<int>((rect.y1 - viewport.y1) / m_tileSize);
+    const int col2 =
+        std::min(static_cast<int>(std::ceil((rect.x2 - viewport.x1) / m_tileSize)), cols);
+    const int row2 =
+        std::min(static_cast<int>(std::ceil((rect.y2 - viewport.y1) / m_tileSize)), rows);
+    for (int row = row1; row < row2; row++)
+      std::fill_n(m_tiles.begin() + row * cols + col1, col2 - col1, true);
+    dirty = true;
+  }
+  if (!dirty)
+    return;
+
+  // combine dirty tiles into rectangles, extending the ones of the previous row when a
+  // run of tiles covers exactly the same columns
+  struct TileRect
+  {
+    int col1, col2, row1, row2;
+  };
+  std::vector<TileRect> rects;
+  std::vector<size_t> open, nextOpen;
+  for (int row = 0; row < rows; row++)
+  {
+    nextOpen.clear();
+    size_t candidate = 0;
+    for (int col = 0; col < cols;)
+    {
+      if (!m_tiles[row * cols + col])
+      {
+        col++;
+        continue;
+      }
+      const int start = col;
+      while (col < cols && m_tiles[row * cols + col])
+        col++;
+
+      // runs are found left to right, so the open rectangles can be walked in step
+      while (candidate < open.size() && rects[open[candidate]].col1 < start)
+        candidate++;
+      if (candidate < open.size() && rects[open[candidate]].col1 == start &&
+          rects[open[candidate]].col2 == col)
+      {
+        rects[open[candidate]].row2 = row + 1;
+        nextOpen.push_back(open[candidate]);
+      }
+      else
+      {
+        rects.push_back({start, col, row, row + 1});
+        nextOpen.push_back(rects.size() - 1);
+      }
+    }
+    open.swap(nextOpen);
+  }
+
+  // merge rectangles when the extra fill costs less than an additional render pass
+  for (const auto& rect : rects)
+  {
+    CDirtyRegion region(viewport.x1 + rect.col1 * m_tileSize, viewport.y1 + rect.row1 * m_tileSize,
+                        viewport.x1 + rect.col2 * m_tileSize, viewport.y1 + rect.row2 * m_tileSize);
+    region.Intersect(viewport);
+
+    int bestMatch = -1;
+    float bestCost = Cost(region);
+    CDirtyRegion bestUnion;
+    for (unsigned int i = 0; i < output.size(); i++)
+    {
+      CDirtyRegion temporaryUnion = output[i];
+      temporaryUnion.Union(region);
+      const float temporaryCost = Cost(temporaryUnion) - Cost(output[i]);
+      if (temporaryCost < bestCost)
+      {
+        bestMatch = i;
+        bestCost = temporaryCost;
+        bestUnion = temporaryUnion;
+      }
+    }
+
+    if (bestMatch >= 0)
+      output[bestMatch] = bestUnion;
+    else
+      output.push_back(region);
+  }
+
+  // fall back to a single pass over the viewport when that's cheaper than the passes found
+  const CDirtyRegion fullViewport(viewport);
+  float cost = 0.0f;
+  for (const auto& region : output)
+    cost += Cost(region);
+  if (output.size() > 1 && cost >= Cost(fullViewport))
+    output.assign(1, fullViewport);
+}
@@ -10,6 +10,8 @@
 
 #include "IDirtyRegionSolver.h"
 
+#include <vector>
+
 class CUnionDirtyRegionSolver : public IDirtyRegionSolver
 {
 public:
@@ -37,3 +39,29 @@ private:
   float m_costNewRegion;
   float m_costPerArea;
 };
+
+/*!
+ \brief Snaps dirty regions to a grid of tiles covering the viewport.
+
+ Dirty tiles are first combined into rectangles (runs within a row, extended over
+ the following rows while the run is unchanged). The rectangles are then merged
+ greedily when rendering the extra pixels is cheaper than another render pass, so
+ a few small dirty spots far apart no longer make the whole area between them dirty.
+ */
+class CTileDirtyRegionSolver : public IDirtyRegionSolver
+{
+public:
+  explicit CTileDirtyRegionSolver(int tileSize = DEFAULT_TILE_SIZE);
+  void Solve(const CDirtyRegionList &input, CDirtyRegionList &output) override;
+  void Solve(const CDirtyRegionList& input, const CRect& viewport, CDirtyRegionList& output);
+
+  static constexpr int DEFAULT_TILE_SIZE = 64;
+
+private:
+  float Cost(const CDirtyRegion& region) const;
+
+  float m_tileSize;
+  float m_costNewRegion;
+  float m_costPerArea;
+  std::vector<bool> m_tiles;
+};
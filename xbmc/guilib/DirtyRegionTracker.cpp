@@ -43,6 +43,12 @@ void CDirtyRegionTracker::SelectAlgorithm()
       CLog::Log(LOGDEBUG, "guilib: Cost reduction as algorithm for solving rendering passes");
       m_solver = new CGreedyDirtyRegionSolver();
       break;
+    case DIRTYREGION_SOLVER_TILES:
+      CLog::Log(LOGDEBUG, "guilib: Tiles with cost reduction for solving rendering passes");
+      m_solver = new CTileDirtyRegionSolver(CServiceBroker::GetSettingsComponent()
+                                                ->GetAdvancedSettings()
+                                                ->m_guiDirtyRegionTileSize);
+      break;
     case DIRTYREGION_SOLVER_UNION:
       m_solver = new CUnionDirtyRegionSolver();
       CLog::Log(LOGDEBUG, "guilib: Union as algorithm for solving rendering passes");
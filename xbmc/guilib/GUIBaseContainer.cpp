@@ -199,6 +199,8 @@ void CGUIBaseContainer::ProcessItem(float posX, float posY, CGUIListItemPtr& ite
 {
   if (!m_focusedLayout || !m_layout) return;
 
+  LayoutItem& tracked = TrackLayoutItem(item);
+
   // set the origin
   CServiceBroker::GetWinSystem()->GetGfxContext().SetOrigin(posX, posY);
 
@@ -208,7 +210,8 @@ void CGUIBaseContainer::ProcessItem(float posX, float posY, CGUIListItemPtr& ite
   {
     if (!item->GetFocusedLayout())
     {
-      item->SetFocusedLayout(std::make_unique<CGUIListItemLayout>(*m_focusedLayout, this));
+      item->SetFocusedLayout(AcquireLayout(true));
+      tracked.m_focusedLayout = item->GetFocusedLayout();
     }
     if (item->GetFocusedLayout())
     {
@@ -234,8 +237,8 @@ void CGUIBaseContainer::ProcessItem(float posX, float posY, CGUIListItemPtr& ite
       item->GetFocusedLayout()->SetFocusedItem(0);  // focus is not set
     if (!item->GetLayout())
     {
-      CGUIListItemLayoutPtr layout = std::make_unique<CGUIListItemLayout>(*m_layout, this);
-      item->SetLayout(std::move(layout));
+      item->SetLayout(AcquireLayout(false));
+      tracked.m_layout = item->GetLayout();
     }
     if (item->GetFocusedLayout())
       item->GetFocusedLayout()->Process(item.get(), m_parentID, currentTime, dirtyregions);
@@ -959,6 +962,7 @@ void CGUIBaseContainer::AllocResources()
 void CGUIBaseContainer::FreeResources(bool immediately)
 {
   CGUIControl::FreeResources(immediately);
+  FlushLayoutPools();
   if (m_listProvider)
   {
     if (immediately)
@@ -976,6 +980,8 @@ void CGUIBaseContainer::UpdateLayout(bool updateAllItems)
   { // free memory of items
     for (iItems it = m_items.begin(); it != m_items.end(); ++it)
       (*it)->FreeMemory();
+    m_layoutItems.clear();
+    FlushLayoutPools();
   }
   // and recalculate the layout
   CalculateLayout();
@@ -1240,6 +1246,14 @@ int CGUIBaseContainer::CorrectOffset(int offset, int cursor) const
 void CGUIBaseContainer::Reset()
 {
   m_wasReset = true;
+  // the items may be shown by another container next, so take back their layouts now
+  for (const auto& tracked : m_layoutItems)
+  {
+    const CGUIListItemPtr item = tracked.second.m_item.lock();
+    if (item)
+      ReleaseLayouts(*item, tracked.second, m_layoutItems.size());
+  }
+  m_layoutItems.clear();
   m_items.clear();
   m_lastItem.reset();
   ResetAutoScrolling();
@@ -1285,17 +1299,87 @@ void CGUIBaseContainer::SetRenderOffset(const CPoint &offset)
 
 void CGUIBaseContainer::FreeMemory(int keepStart, int keepEnd)
 {
-  if (keepStart < keepEnd)
-  { // remove before keepStart and after keepEnd
-    for (int i = 0; i < keepStart && i < (int)m_items.size(); ++i)
-      m_items[i]->FreeMemory();
-    for (int i = std::max(keepEnd + 1, 0); i < (int)m_items.size(); ++i)
-      m_items[i]->FreeMemory();
+  const int numItems = static_cast<int>(m_items.size());
+  // remove before keepStart and after keepEnd, or between the two when wrapping
+  const auto keep = [keepStart, keepEnd](int i) {
+    return keepStart < keepEnd ? (i >= keepStart && i <= keepEnd)
+                               : (i <= keepEnd || i >= keepStart);
+  };
+  // never pool more layouts than can be on screen at once
+  const size_t poolSize = keepStart < keepEnd
+                              ? static_cast<size_t>(keepEnd - keepStart + 1)
+                              : static_cast<size_t>(std::max(numItems - keepStart + keepEnd + 1, 0));
+
+  for (auto it = m_layoutItems.begin(); it != m_layoutItems.end();)
+  {
+    const CGUIListItemPtr item = it->second.m_item.lock();
+    if (!item)
+    {
+      it = m_layoutItems.erase(it);
+      continue;
+    }
+
+    // the position is refreshed each time the item is processed. If the item has been moved
+    // or removed from the list since, it is no longer on screen either.
+    const int index = static_cast<int>(item->GetCurrentItem()) - 1;
+    if (index >= 0 && index < numItems && m_items[index] == item && keep(index))
+    {
+      ++it;
+      continue;
+    }
+
+    ReleaseLayouts(*item, it->second, poolSize);
+    it = m_layoutItems.erase(it);
   }
-  else
-  { // wrapping
-    for (int i = std::max(keepEnd + 1, 0); i < keepStart && i < (int)m_items.size(); ++i)
-      m_items[i]->FreeMemory();
+}
+
+CGUIListItemLayoutPtr CGUIBaseContainer::AcquireLayout(bool focused)
+{
+  std::vector<CGUIListItemLayoutPtr>& pool = focused ? m_focusedLayoutPool : m_layoutPool;
+  if (pool.empty())
+    return std::make_unique<CGUIListItemLayout>(focused ? *m_focusedLayout : *m_layout, this);
+
+  CGUIListItemLayoutPtr layout = std::move(pool.back());
+  pool.pop_back();
+  layout->Recycle();
+  return layout;
+}
+
+CGUIBaseContainer::LayoutItem& CGUIBaseContainer::TrackLayoutItem(const CGUIListItemPtr& item)
+{
+  LayoutItem& tracked = m_layoutItems[item.get()];
+  if (tracked.m_item.lock() != item)
+    tracked = LayoutItem{item};
+  return tracked;
+}
+
+void CGUIBaseContainer::ReleaseLayouts(CGUIListItem& item,
+                                       const LayoutItem& tracked,
+                                       size_t poolSize)
+{
+  // only take back layouts we created from the current templates, anything else is freed
+  if (tracked.m_layout && item.GetLayout() == tracked.m_layout && m_layoutPool.size() < poolSize)
+  {
+    m_layoutPool.emplace_back(item.ReleaseLayout());
+    m_layoutPool.back()->FreeResources();
+  }
+  if (tracked.m_focusedLayout && item.GetFocusedLayout() == tracked.m_focusedLayout &&
+      m_focusedLayoutPool.size() < poolSize)
+  {
+    m_focusedLayoutPool.emplace_back(item.ReleaseFocusedLayout());
+    m_focusedLayoutPool.back()->FreeResources();
+  }
+  item.FreeMemory();
+}
+
+void CGUIBaseContainer::FlushLayoutPools()
+{
+  m_layoutPool.clear();
+  m_focusedLayoutPool.clear();
+  for (auto& tracked : m_layoutItems)
+  {
+    tracked.second.m_layout = nullptr;
+    tracked.second.m_focusedLayout = nullptr;
   }
 }
 
@@ -1353,6 +1437,9 @@ bool CGUIBaseContainer::GetCondition(int condition, int data) const
 
 void CGUIBaseContainer::GetCurrentLayouts()
 {
+  const CGUIListItemLayout* oldLayout = m_layout;
+  const CGUIListItemLayout* oldFocusedLayout = m_focusedLayout;
+
   m_layout = NULL;
   for (auto &layout : m_layouts)
   {
@@ -1376,6 +1463,10 @@ void CGUIBaseContainer::GetCurrentLayouts()
   }
   if (!m_focusedLayout && !m_focusedLayouts.empty())
     m_focusedLayout = &m_focusedLayouts.front(); // failsafe
+
+  // pooled layouts were cloned from the old templates
+  if (oldLayout != m_layout || oldFocusedLayout != m_focusedLayout)
+    FlushLayoutPools();
 }
 
 bool CGUIBaseContainer::HasNextPage() const
@@ -19,6 +19,7 @@
 
 #include <list>
 #include <memory>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -30,6 +31,7 @@
 class IListProvider;
 class TiXmlNode;
 class CGUIListItemLayout;
+using CGUIListItemLayoutPtr = std::unique_ptr<CGUIListItemLayout>;
 
 class CGUIBaseContainer : public IGUIContainer
 {
@@ -128,6 +130,10 @@ protected:
   int ScrollCorrectionRange() const;
   inline float Size() const;
   void FreeMemory(int keepStart, int keepEnd);
+  /*! \brief Get a layout for an item, reusing one released by an offscreen item if possible
+   \param focused whether to get a focused or an unfocused layout
+   */
+  CGUIListItemLayoutPtr AcquireLayout(bool focused);
   void GetCurrentLayouts();
   CGUIListItemLayout *GetFocusedLayout() const;
 
@@ -230,6 +236,22 @@ private:
 
   bool m_gestureActive = false;
 
+  // layout recycling. Every item we process is tracked here, so freeing offscreen items
+  // only has to look at these rather than at every item in the list.
+  struct LayoutItem
+  {
+    std::weak_ptr<CGUIListItem> m_item;
+    const CGUIListItemLayout* m_layout{nullptr}; // layouts we handed out for the current templates
+    const CGUIListItemLayout* m_focusedLayout{nullptr};
+  };
+  LayoutItem& TrackLayoutItem(const CGUIListItemPtr& item);
+  void ReleaseLayouts(CGUIListItem& item, const LayoutItem& tracked, size_t poolSize);
+  void FlushLayoutPools();
+
+  std::unordered_map<const CGUIListItem*, LayoutItem> m_layoutItems;
+  std::vector<CGUIListItemLayoutPtr> m_layoutPool;
+  std::vector<CGUIListItemLayoutPtr> m_focusedLayoutPool;
+
   // early inertial scroll cancellation
   bool m_waitForScrollEnd = false;
   float m_lastScrollValue = 0.0f;
@@ -241,11 +241,25 @@ bool CGUIControlProfiler::IsRunning(void)
 void CGUIControlProfiler::Start(void)
 {
   m_iFrameCount = 0;
+  m_pixelFrames = 0;
+  m_renderPasses = 0;
+  m_renderedPixels = 0;
+  m_viewportPixels = 0;
   m_bIsRunning = true;
   m_pLastItem = NULL;
   m_ItemHead.Reset(this);
 }
 
+void CGUIControlProfiler::AddRenderedPixels(unsigned int passes,
+                                            uint64_t pixels,
+                                            uint64_t viewportPixels)
+{
+  m_pixelFrames++;
+  m_renderPasses += passes;
+  m_renderedPixels += pixels;
+  m_viewportPixels += viewportPixels;
+}
+
 void CGUIControlProfiler::BeginVisibility(CGUIControl *pControl)
 {
   CGUIControlProfilerItem *item = FindOrAddControl(pControl);
@@ -332,6 +346,20 @@ bool CGUIControlProfiler::SaveResults(void)
   root->SetAttribute("timeunit", "ms");
   doc.LinkEndChild(root);
 
+  if (m_pixelFrames > 0)
+  {
+    TiXmlElement *fill = new TiXmlElement("fill");
+    fill->SetAttribute("frames", std::to_string(m_pixelFrames).c_str());
+    fill->SetAttribute("passesperframe",
+                       StringUtils::Format("{:.2f}", static_cast<double>(m_renderPasses) / m_pixelFrames).c_str());
+    fill->SetAttribute("pixelsperframe", std::to_string(m_renderedPixels / m_pixelFrames).c_str());
+    fill->SetAttribute("viewportpixelsperframe", std::to_string(m_viewportPixels / m_pixelFrames).c_str());
+    if (m_viewportPixels > 0)
+      fill->SetAttribute("viewportratio",
+                         StringUtils::Format("{:.3f}", static_cast<double>(m_renderedPixels) / m_viewportPixels).c_str());
+    root->LinkEndChild(fill);
+  }
+
   m_ItemHead.SaveToXML(root);
   return doc.SaveFile(m_strOutputFile);
 }
@@ -57,6 +57,12 @@ public:
   void EndVisibility(CGUIControl *pControl);
   void BeginRender(CGUIControl *pControl);
   void EndRender(CGUIControl *pControl);
+  /*! \brief Account for the pixels filled by the render passes of one frame
+   \param passes number of render passes (dirty regions) of the frame
+   \param pixels number of pixels covered by these passes
+   \param viewportPixels number of pixels of the whole viewport
+   */
+  void AddRenderedPixels(unsigned int passes, uint64_t pixels, uint64_t viewportPixels);
   int GetMaxFrameCount(void) const { return m_iMaxFrameCount; }
   void SetMaxFrameCount(int iMaxFrameCount) { m_iMaxFrameCount = iMaxFrameCount; }
   void SetOutputFile(const std::string& strOutputFile) { m_strOutputFile = strOutputFile; }
@@ -79,10 +85,16 @@ private:
   std::string m_strOutputFile;
   int m_iMaxFrameCount = 200;
   int m_iFrameCount = 0;
+
+  unsigned int m_pixelFrames = 0;
+  uint64_t m_renderPasses = 0;
+  uint64_t m_renderedPixels = 0;
+  uint64_t m_viewportPixels = 0;
 };
 
 #define GUIPROFILER_VISIBILITY_BEGIN(x) { if (CGUIControlProfiler::IsRunning()) CGUIControlProfiler::Instance().BeginVisibility(x); }
 #define GUIPROFILER_VISIBILITY_END(x) { if (CGUIControlProfiler::IsRunning()) CGUIControlProfiler::Instance().EndVisibility(x); }
 #define GUIPROFILER_RENDER_BEGIN(x) { if (CGUIControlProfiler::IsRunning()) CGUIControlProfiler::Instance().BeginRender(x); }
 #define GUIPROFILER_RENDER_END(x) { if (CGUIControlProfiler::IsRunning()) CGUIControlProfiler::Instance().EndRender(x); }
+#define GUIPROFILER_RENDERED_PIXELS(passes, pixels, viewportPixels) { if (CGUIControlProfiler::IsRunning()) CGUIControlProfiler::Instance().AddRenderedPixels(passes, pixels, viewportPixels); }
 
@@ -264,7 +264,7 @@ bool CGUIFont::ClippedRegionIsEmpty(
   return !context.SetClipRegion(x, y, width, m_font->GetTextHeight(1, 2) * context.GetGUIScaleY());
 }
 
-float CGUIFont::GetTextWidth(const vecText& text)
+float CGUIFont::GetTextWidth(const vecText& text, bool cacheShaping /* = true */)
 {
   CWinSystemBase* const winSystem = CServiceBroker::GetWinSystem();
   if (!m_font || !winSystem)
@@ -273,7 +273,7 @@ float CGUIFont::GetTextWidth(const vecText& text)
   CGraphicContext& context = winSystem->GetGfxContext();
 
   std::unique_lock<CCriticalSection> lock(context);
-  return m_font->GetTextWidthInternal(text) * context.GetGUIScaleX();
+  return m_font->GetTextWidthInternal(text, cacheShaping) * context.GetGUIScaleX();
 }
 
 float CGUIFont::GetCharWidth(character_t ch)
@@ -150,7 +150,7 @@ public:
 
   bool UpdateScrollInfo(const vecText& text, CScrollInfo& scrollInfo);
 
-  float GetTextWidth(const vecText& text);
+  float GetTextWidth(const vecText& text, bool cacheShaping = true);
   float GetCharWidth(character_t ch);
   float GetTextHeight(int numLines) const;
   float GetTextBaseLine() const;
@@ -0,0 +1,179 @@
+/*
+ *  Copyright (C) 2005-2021 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+/*!
+\file GUIFontShapingCache.h
+\brief
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+typedef uint32_t character_t;
+typedef std::vector<character_t> vecText;
+
+/*!
+ \ingroup textures
+ \brief LRU cache for the result of shaping a line of text with a single font, bounded by
+ the memory held by its entries.
+
+ Value must provide GetMemoryUsage(), returning the number of bytes it holds including
+ itself. Entries are keyed on the styled text only. The color bits (16-24) of each character
+ do not change glyph selection nor metrics, so they are ignored when hashing and
+ comparing keys, which lets differently colored labels share the same entry.
+ */
+template<class Value>
+class CGUIFontShapingCache
+{
+public:
+  struct Stats
+  {
+    uint64_t m_hits{0};
+    uint64_t m_misses{0};
+    uint64_t m_evictions{0};
+    size_t m_size{0};
+    size_t m_bytes{0};
+    size_t m_capacity{0}; // in bytes
+
+    float GetHitRate() const
+    {
+      const uint64_t lookups = m_hits + m_misses;
+      return lookups ? static_cast<float>(m_hits) / static_cast<float>(lookups) : 0.0f;
+    }
+  };
+
+  /*!
+   \brief Create a cache holding at most capacity bytes of keys and values, 0 for no limit.
+   */
+  explicit CGUIFontShapingCache(size_t capacity) : m_capacity(capacity) {}
+
+  CGUIFontShapingCache(const CGUIFontShapingCache&) = delete;
+  CGUIFontShapingCache& operator=(const CGUIFontShapingCache&) = delete;
+
+  /*!
+   \brief Find the cached value for the given text and mark it as most recently used.
+   \return the cached value, or nullptr on a miss. The pointer stays valid until the
+           next call to Insert() or Flush().
+   */
+  Value* Lookup(const vecText& text)
+  {
+    const auto it = m_map.find(&text);
+    if (it == m_map.end())
+    {
+      m_stats.m_misses++;
+      return nullptr;
+    }
+
+    m_stats.m_hits++;
+    m_lru.splice(m_lru.begin(), m_lru, it->second);
+    return &it->second->second;
+  }
+
+  /*!
+   \brief Add a value for the given text, evicting the least recently used entries until it fits.
+   An entry larger than the whole capacity is still stored, as the only entry.
+   \return the stored value. The reference stays valid until the next call to Insert() or Flush().
+   */
+  Value& Insert(const vecText& text, Value&& value)
+  {
+    const auto it = m_map.find(&text);
+    if (it != m_map.end())
+    {
+      m_bytes -= GetMemoryUsage(*it->second);
+      m_lru.erase(it->second);
+      m_map.erase(it);
+    }
+
+    m_lru.emplace_front(text, std::move(value));
+    m_map.emplace(&m_lru.front().first, m_lru.begin());
+    m_bytes += GetMemoryUsage(m_lru.front());
+
+    while (m_capacity > 0 && m_lru.size() > 1 && m_bytes > m_capacity)
+    {
+      m_bytes -= GetMemoryUsage(m_lru.back());
+      m_map.erase(&m_lru.back().first);
+      m_lru.pop_back();
+      m_stats.m_evictions++;
+    }
+
+    return m_lru.front().second;
+  }
+
+  void Flush()
+  {
+    m_map.clear();
+    m_lru.clear();
+    m_bytes = 0;
+  }
+
+  Stats GetStats() const
+  {
+    Stats stats = m_stats;
+    stats.m_size = m_lru.size();
+    stats.m_bytes = m_bytes;
+    stats.m_capacity = m_capacity;
+    return stats;
+  }
+
+private:
+  static constexpr character_t KEY_MASK = 0xFF00FFFF; // strip color bits
+
+  struct KeyHash
+  {
+    size_t operator()(const vecText* text) const
+    {
+      // FNV-1a
+      uint64_t hash = 14695981039346656037ULL;
+      for (const character_t ch : *text)
+      {
+        hash ^= (ch & KEY_MASK);
+        hash *= 1099511628211ULL;
+      }
+      return static_cast<size_t>(hash);
+    }
+  };
+
+  struct KeyEqual
+  {
+    bool operator()(const vecText* a, const vecText* b) const
+    {
+      if (a->size() != b->size())
+        return false;
+      for (size_t i = 0; i < a->size(); ++i)
+      {
+        if (((*a)[i] & KEY_MASK) != ((*b)[i] & KEY_MASK))
+          return false;
+      }
+      return true;
+    }
+  };
+
+  using Entry = std::pair<vecText, Value>;
+  using EntryList = std::list<Entry>;
+
+  // list node and map node overhead, approximated as a few pointers each
+  static constexpr size_t ENTRY_OVERHEAD = 8 * sizeof(void*);
+
+  static size_t GetMemoryUsage(const Entry& entry)
+  {
+    return ENTRY_OVERHEAD + sizeof(vecText) + entry.first.capacity() * sizeof(character_t) +
+           entry.second.GetMemoryUsage();
+  }
+
+  const size_t m_capacity;
+  size_t m_bytes{0};
+  EntryList m_lru;
+  std::unordered_map<const vecText*, typename EntryList::iterator, KeyHash, KeyEqual> m_map;
+  Stats m_stats;
+};
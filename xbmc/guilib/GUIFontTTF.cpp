@@ -59,6 +59,7 @@ constexpr int CHAR_CHUNK = 64; // 64 chars allocated at a time (2048 bytes)
 constexpr int GLYPH_STRENGTH_BOLD = 24;
 constexpr int GLYPH_STRENGTH_LIGHT = -48;
 constexpr int TAB_SPACE_LENGTH = 4;
+constexpr size_t SHAPING_CACHE_SIZE = 1024 * 1024; // max bytes of shaped text cached per font
 } /* namespace */
 
 class CFreeTypeLibrary
@@ -165,6 +166,7 @@ CGUIFontTTF::CGUIFontTTF(const std::string& fontIdent)
   : m_fontIdent(fontIdent),
     m_staticCache(*this),
     m_dynamicCache(*this),
+    m_shapingCache(SHAPING_CACHE_SIZE),
     m_renderSystem(CServiceBroker::GetRenderSystem())
 {
 }
@@ -213,6 +215,15 @@ void CGUIFontTTF::Clear()
   m_posY = 0;
   m_nestedBeginCount = 0;
 
+  const auto stats = m_shapingCache.GetStats();
+  if (stats.m_hits + stats.m_misses > 0)
+    CLog::Log(LOGDEBUG,
+              "{} - font {}: shaping cache {} hits, {} misses ({:.1f}% hit rate), {} evictions, "
+              "{} entries using {} bytes",
+              __FUNCTION__, m_fontIdent, stats.m_hits, stats.m_misses,
+              stats.GetHitRate() * 100.0f, stats.m_evictions, stats.m_size, stats.m_bytes);
+  m_shapingCache.Flush();
+
   if (m_hbFont)
     hb_font_destroy(m_hbFont);
   m_hbFont = nullptr;
@@ -385,7 +396,8 @@ void CGUIFontTTF::DrawTextInternal(CGraphicContext& context,
 
   if (dirtyCache)
   {
-    const std::vector<Glyph> glyphs = GetHarfBuzzShapedGlyphs(text);
+    // nothing below shapes any other text, so the cached glyphs stay valid
+    const std::vector<Glyph>& glyphs = GetShapedText(text).m_glyphs;
     // save the origin, which is scaled separately
     m_originX = x;
     m_originY = y;
@@ -574,10 +586,15 @@ void CGUIFontTTF::DrawTextInternal(CGraphicContext& context,
 }
 
 
-float CGUIFontTTF::GetTextWidthInternal(const vecText& text)
+float CGUIFontTTF::GetTextWidthInternal(const vecText& text, bool cacheShaping)
 {
-  const std::vector<Glyph> glyphs = GetHarfBuzzShapedGlyphs(text);
-  return GetTextWidthInternal(text, glyphs);
+  if (!cacheShaping)
+    return GetTextWidthInternal(text, GetHarfBuzzShapedGlyphs(text));
+
+  ShapedText& shaped = GetShapedText(text);
+  if (shaped.m_width < 0.0f)
+    shaped.m_width = GetTextWidthInternal(text, shaped.m_glyphs);
+  return shaped.m_width;
 }
 
 // this routine assumes a single line (i.e. it was called from GUITextLayout)
@@ -737,6 +754,17 @@ std::vector<CGUIFontTTF::Glyph> CGUIFontTTF::GetHarfBuzzShapedGlyphs(const vecTe
   return glyphs;
 }
 
+CGUIFontTTF::ShapedText& CGUIFontTTF::GetShapedText(const vecText& text)
+{
+  ShapedText* shaped = m_shapingCache.Lookup(text);
+  if (shaped)
+    return *shaped;
+
+  ShapedText entry;
+  entry.m_glyphs = GetHarfBuzzShapedGlyphs(text);
+  return m_shapingCache.Insert(text, std::move(entry));
+}
+
 CGUIFontTTF::Character* CGUIFontTTF::GetCharacter(character_t chr, FT_UInt glyphIndex)
 {
   const wchar_t letter = static_cast<wchar_t>(chr & 0xffff);
@@ -71,6 +71,7 @@ struct SVertex
 #endif
 
 #include "GUIFontCache.h"
+#include "GUIFontShapingCache.h"
 
 
 class CGUIFontTTF
@@ -121,6 +122,14 @@ protected:
     }
   };
 
+  struct ShapedText
+  {
+    std::vector<Glyph> m_glyphs;
+    float m_width{-1.0f}; // computed lazily, negative until then
+
+    size_t GetMemoryUsage() const { return sizeof(*this) + m_glyphs.capacity() * sizeof(Glyph); }
+  };
+
   struct Character
   {
     short m_offsetX;
@@ -149,7 +158,16 @@ protected:
 
   std::vector<Glyph> GetHarfBuzzShapedGlyphs(const vecText& text);
 
-  float GetTextWidthInternal(const vecText& text);
+  /*! \brief Get the shaped glyphs of the given text, shaping it only on a cache miss.
+   The returned reference is invalidated by the next call to this function.
+   */
+  ShapedText& GetShapedText(const vecText& text);
+
+  /*! \brief Get the width of the given text.
+   \param cacheShaping whether to keep the shaped text, false for text that is measured once
+   only, e.g. the growing prefixes measured while wrapping a line.
+   */
+  float GetTextWidthInternal(const vecText& text, bool cacheShaping = true);
   float GetTextWidthInternal(const vecText& text, const std::vector<Glyph>& glyph);
   float GetCharWidthInternal(character_t ch);
   float GetTextHeight(float lineSpacing, int numLines) const;
@@ -265,6 +283,7 @@ protected:
 
   CGUIFontCache<CGUIFontCacheStaticPosition, CGUIFontCacheStaticValue> m_staticCache;
   CGUIFontCache<CGUIFontCacheDynamicPosition, CGUIFontCacheDynamicValue> m_dynamicCache;
+  CGUIFontShapingCache<ShapedText> m_shapingCache;
 
   CRenderSystemBase* m_renderSystem;
 
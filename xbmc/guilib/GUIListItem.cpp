@@ -343,6 +343,16 @@ CGUIListItemLayout *CGUIListItem::GetFocusedLayout()
   return m_focusedLayout.get();
 }
 
+CGUIListItemLayoutPtr CGUIListItem::ReleaseLayout()
+{
+  return std::move(m_layout);
+}
+
+CGUIListItemLayoutPtr CGUIListItem::ReleaseFocusedLayout()
+{
+  return std::move(m_focusedLayout);
+}
+
 void CGUIListItem::SetInvalid()
 {
   if (m_layout) m_layout->SetInvalid();
@@ -131,6 +131,12 @@ public:
   void SetFocusedLayout(CGUIListItemLayoutPtr layout);
   CGUIListItemLayout *GetFocusedLayout();
 
+  /*! \brief Detach the layouts from this item without freeing them, so they can be reused.
+   \return the detached layout, which may be empty.
+   */
+  CGUIListItemLayoutPtr ReleaseLayout();
+  CGUIListItemLayoutPtr ReleaseFocusedLayout();
+
   void FreeIcons();
   void FreeMemory(bool immediately = false);
   void SetInvalid();
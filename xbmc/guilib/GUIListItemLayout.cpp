@@ -96,6 +96,15 @@ void CGUIListItemLayout::Render(CGUIListItem *item, int parentID)
   m_group.DoRender();
 }
 
+void CGUIListItemLayout::Recycle()
+{
+  m_group.ResetAnimations();
+  m_group.SetFocusedItem(0);
+  m_group.AllocResources();
+  m_infoUpdateTimeout.Set(m_infoUpdateMillis);
+  SetInvalid();
+}
+
 void CGUIListItemLayout::SetFocusedItem(unsigned int focus)
 {
   m_group.SetFocusedItem(focus);
@@ -33,6 +33,11 @@ public:
   void ResetAnimation(ANIMATION_TYPE animType);
   void SetInvalid() { m_invalidated = true; }
   void FreeResources(bool immediately = false);
+  /*! \brief Prepare a layout that was used by another list item for reuse.
+   Resets animations and focus and reallocates resources, leaving the layout in the
+   same state as a freshly cloned one.
+   */
+  void Recycle();
   void SetParentControl(CGUIControl* control) { m_group.SetParentControl(control); }
 
   //#ifdef GUILIB_PYTHON_COMPATIBILITY
@@ -561,7 +561,8 @@ void CGUITextLayout::WrapText(const vecText &text, float maxWidth)
       // check for a space
       if (CanWrapAtLetter(letter))
       {
-        float width = m_font->GetTextWidth(curLine);
+        // prefixes are measured once only, don't let them push lines out of the shaping cache
+        float width = m_font->GetTextWidth(curLine, false);
         if (width > maxWidth)
         {
           if (lastSpace != line.m_text.begin() && lastSpaceInLine > 0)
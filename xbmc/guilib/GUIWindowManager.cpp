@@ -9,6 +9,7 @@
 #include "GUIWindowManager.h"
 
 #include "GUIAudioManager.h"
+#include "GUIControlProfiler.h"
 #include "GUIDialog.h"
 #include "GUIInfoManager.h"
 #include "GUIPassword.h"
@@ -1282,12 +1283,18 @@ bool CGUIWindowManager::Render()
 
   CDirtyRegionList dirtyRegions = m_tracker.GetDirtyRegions();
 
+  const float viewportArea = CServiceBroker::GetWinSystem()->GetGfxContext().GetViewWindow().Area();
+  unsigned int renderPasses = 0;
+  float renderedArea = 0.0f;
+
   bool hasRendered = false;
   // If we visualize the regions we will always render the entire viewport
   if (CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_guiVisualizeDirtyRegions || CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_guiAlgorithmDirtyRegions == DIRTYREGION_SOLVER_FILL_VIEWPORT_ALWAYS)
   {
     RenderPass();
     hasRendered = true;
+    renderPasses = 1;
+    renderedArea = viewportArea;
   }
   else if (CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_guiAlgorithmDirtyRegions == DIRTYREGION_SOLVER_FILL_VIEWPORT_ON_CHANGE)
   {
@@ -1295,6 +1302,8 @@ bool CGUIWindowManager::Render()
     {
       RenderPass();
       hasRendered = true;
+      renderPasses = 1;
+      renderedArea = viewportArea;
     }
   }
   else
@@ -1307,10 +1316,15 @@ bool CGUIWindowManager::Render()
       CServiceBroker::GetWinSystem()->GetGfxContext().SetScissors(i);
       RenderPass();
       hasRendered = true;
+      renderPasses++;
+      renderedArea += i.Area();
     }
     CServiceBroker::GetWinSystem()->GetGfxContext().ResetScissors();
   }
 
+  GUIPROFILER_RENDERED_PIXELS(renderPasses, static_cast<uint64_t>(renderedArea),
+                              static_cast<uint64_t>(viewportArea));
+
   if (CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_guiVisualizeDirtyRegions)
   {
     CServiceBroker::GetWinSystem()->GetGfxContext().SetRenderingResolution(CServiceBroker::GetWinSystem()->GetGfxContext().GetResInfo(), false);
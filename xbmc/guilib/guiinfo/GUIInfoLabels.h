@@ -314,6 +314,7 @@
 #define RETROPLAYER_VIDEO_FILTER      330
 #define RETROPLAYER_STRETCH_MODE      331
 #define RETROPLAYER_VIDEO_ROTATION    332
+#define RETROPLAYER_SAVESTATE_STATS   333
 
 #define CONTAINER_HAS_PARENT_ITEM    341
 #define CONTAINER_CAN_FILTER         342
@@ -9,8 +9,11 @@
 #include "guilib/guiinfo/GamesGUIInfo.h"
 
 #include "FileItem.h"
+#include "ServiceBroker.h"
 #include "Util.h"
 #include "cores/RetroPlayer/RetroPlayerUtils.h"
+#include "cores/RetroPlayer/guibridge/GUIGameRenderManager.h"
+#include "cores/RetroPlayer/guibridge/GUIGameSettingsHandle.h"
 #include "games/tags/GameInfoTag.h"
 #include "guilib/guiinfo/GUIInfo.h"
 #include "guilib/guiinfo/GUIInfoLabels.h"
@@ -69,6 +72,12 @@ bool CGamesGUIInfo::GetLabel(std::string& value, const CFileItem *item, int cont
       value = std::to_string(rotationDegCCW);
       return true;
     }
+    case RETROPLAYER_SAVESTATE_STATS:
+    {
+      auto gameSettingsHandle = CServiceBroker::GetGameRenderManager().RegisterGameSettingsDialog();
+      value = gameSettingsHandle->GetSavestateStats();
+      return true;
+    }
     default:
       break;
   }
@@ -0,0 +1,120 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "guilib/DirtyRegionSolvers.h"
+
+#include <gtest/gtest.h>
+
+namespace
+{
+const CRect VIEWPORT(0, 0, 1920, 1080);
+} // namespace
+
+TEST(TestTileDirtyRegionSolver, EmptyInput)
+{
+  CTileDirtyRegionSolver solver;
+  CDirtyRegionList output;
+
+  solver.Solve({}, VIEWPORT, output);
+  EXPECT_TRUE(output.empty());
+
+  solver.Solve({CDirtyRegion(10, 10, 20, 20)}, CRect(), output);
+  EXPECT_TRUE(output.empty());
+}
+
+TEST(TestTileDirtyRegionSolver, SnapsToTiles)
+{
+  CTileDirtyRegionSolver solver(64);
+  CDirtyRegionList output;
+
+  solver.Solve({CDirtyRegion(70, 10, 80, 20)}, VIEWPORT, output);
+  ASSERT_EQ(1u, output.size());
+  EXPECT_EQ(CRect(64, 0, 128, 64), output[0]);
+}
+
+TEST(TestTileDirtyRegionSolver, TilesStartAtViewport)
+{
+  CTileDirtyRegionSolver solver(64);
+  CDirtyRegionList output;
+
+  solver.Solve({CDirtyRegion(110, 60, 120, 70)}, CRect(100, 50, 740, 530), output);
+  ASSERT_EQ(1u, output.size());
+  EXPECT_EQ(CRect(100, 50, 164, 114), output[0]);
+}
+
+TEST(TestTileDirtyRegionSolver, MergesTiles)
+{
+  CTileDirtyRegionSolver solver(64);
+  CDirtyRegionList output;
+
+  // adjacent tiles in a row and the same run in the following row form one rectangle
+  solver.Solve({CDirtyRegion(10, 10, 20, 20), CDirtyRegion(70, 10, 80, 20),
+                CDirtyRegion(10, 70, 80, 80)},
+               VIEWPORT, output);
+  ASSERT_EQ(1u, output.size());
+  EXPECT_EQ(CRect(0, 0, 128, 128), output[0]);
+
+  // nearby rectangles are merged as the extra fill is cheaper than another pass
+  output.clear();
+  solver.Solve({CDirtyRegion(10, 10, 20, 20), CDirtyRegion(200, 10, 210, 20)}, VIEWPORT, output);
+  ASSERT_EQ(1u, output.size());
+  EXPECT_EQ(CRect(0, 0, 256, 64), output[0]);
+}
+
+TEST(TestTileDirtyRegionSolver, KeepsDistantRegionsApart)
+{
+  CTileDirtyRegionSolver solver(64);
+  CDirtyRegionList output;
+
+  solver.Solve({CDirtyRegion(10, 10, 20, 20), CDirtyRegion(1800, 1000, 1810, 1010)}, VIEWPORT,
+               output);
+  ASSERT_EQ(2u, output.size());
+  EXPECT_EQ(CRect(0, 0, 64, 64), output[0]);
+  EXPECT_EQ(CRect(1792, 960, 1856, 1024), output[1]);
+}
+
+TEST(TestTileDirtyRegionSolver, ClipsToViewport)
+{
+  CTileDirtyRegionSolver solver(64);
+  CDirtyRegionList output;
+
+  // the last row of tiles is cut by the viewport
+  solver.Solve({CDirtyRegion(1900, 1070, 2000, 1200)}, VIEWPORT, output);
+  ASSERT_EQ(1u, output.size());
+  EXPECT_EQ(CRect(1856, 1024, 1920, 1080), output[0]);
+
+  // regions outside the viewport are ignored
+  output.clear();
+  solver.Solve({CDirtyRegion(2000, 10, 2100, 20), CDirtyRegion(-100, -100, -10, -10)}, VIEWPORT,
+               output);
+  EXPECT_TRUE(output.empty());
+}
+
+TEST(TestTileDirtyRegionSolver, FillsViewport)
+{
+  CTileDirtyRegionSolver solver(64);
+  CDirtyRegionList output;
+
+  // a full screen change renders the viewport in a single pass
+  solver.Solve({CDirtyRegion(-10, -10, 2000, 1100)}, VIEWPORT, output);
+  ASSERT_EQ(1u, output.size());
+  EXPECT_EQ(VIEWPORT, output[0]);
+
+  // so do changes scattered all over it, here every other tile, as one pass costs less than one
+  // per row of tiles
+  CDirtyRegionList input;
+  for (float y = 0; y < VIEWPORT.y2; y += 64)
+  {
+    for (float x = static_cast<int>(y / 64) % 2 * 64; x < VIEWPORT.x2; x += 128)
+      input.emplace_back(x, y, x + 10, y + 10);
+  }
+  output.clear();
+  solver.Solve(input, VIEWPORT, output);
+  ASSERT_EQ(1u, output.size());
+  EXPECT_EQ(VIEWPORT, output[0]);
+}
@@ -30,6 +30,8 @@
 #include "utils/StringUtils.h"
 #include "utils/log.h"
 
+#include <utility>
+
 using namespace JSONRPC;
 
 std::map<std::string, CVariant> CJSONServiceDescription::m_notifications = std::map<std::string, CVariant>();
@@ -250,7 +252,8 @@ JsonRpcMethodMap CJSONServiceDescription::m_methodMaps[] = {
 
 // XBMC operations
   { "XBMC.GetInfoLabels",                           CXBMCOperations::GetInfoLabels },
-  { "XBMC.GetInfoBooleans",                         CXBMCOperations::GetInfoBooleans }
+  { "XBMC.GetInfoBooleans",                         CXBMCOperations::GetInfoBooleans },
+  { "XBMC.GetLockStatistics",                       CXBMCOperations::GetLockStatistics }
 };
 
 // clang-format on
@@ -658,9 +661,28 @@ JSONRPC_STATUS JSONSchemaTypeDefinition::Check(const CVariant& value,
                                                CVariant& outputValue,
                                                CVariant& errorData) const
 {
-  if (!name.empty())
-    errorData["name"] = name;
-  SchemaValueTypeToJson(type, errorData["type"]);
+  // only describe the type in the error data if the check failed, building it for every
+  // successfully checked value is most of the cost of checking large parameters
+  bool extendedTypeFailed = false;
+  JSONRPC_STATUS status = CheckValue(value, outputValue, errorData, extendedTypeFailed);
+  if (status != OK)
+  {
+    // a mismatching extended type has described itself already, this type only provides the
+    // name if the extended type has none
+    if (!name.empty() && (!extendedTypeFailed || !errorData.isMember("name")))
+      errorData["name"] = name;
+    if (!extendedTypeFailed)
+      SchemaValueTypeToJson(type, errorData["type"]);
+  }
+
+  return status;
+}
+
+JSONRPC_STATUS JSONSchemaTypeDefinition::CheckValue(const CVariant& value,
+                                                    CVariant& outputValue,
+                                                    CVariant& errorData,
+                                                    bool& extendedTypeFailed) const
+{
   std::string errorMessage;
 
   // Let's check the type of the provided parameter
@@ -710,6 +732,7 @@ JSONRPC_STATUS JSONSchemaTypeDefinition::Check(const CVariant& value,
 
       if (status != OK)
       {
+        extendedTypeFailed = true;
         CLog::Log(LOGDEBUG, "JSONRPC: Value does not match extended type {} of type {}",
                   extends.at(extendsIndex)->ID, name);
         errorMessage = StringUtils::Format("value does not match extended type {}",
@@ -756,10 +779,12 @@ JSONRPC_STATUS JSONSchemaTypeDefinition::Check(const CVariant& value,
       for (unsigned int arrayIndex = 0; arrayIndex < value.size(); arrayIndex++)
       {
         CVariant temp;
-        JSONRPC_STATUS status = itemType->Check(value[arrayIndex], temp, errorData["property"]);
+        CVariant propertyError;
+        JSONRPC_STATUS status = itemType->Check(value[arrayIndex], temp, propertyError);
         outputValue.push_back(temp);
         if (status != OK)
         {
+          errorData["property"] = std::move(propertyError);
           CLog::Log(LOGDEBUG, "JSONRPC: Array element at index {} does not match in type {}",
                     arrayIndex, name);
           errorMessage =
@@ -794,9 +819,11 @@ JSONRPC_STATUS JSONSchemaTypeDefinition::Check(const CVariant& value,
       unsigned int arrayIndex;
       for (arrayIndex = 0; arrayIndex < std::min(items.size(), (size_t)value.size()); arrayIndex++)
       {
-        JSONRPC_STATUS status = items.at(arrayIndex)->Check(value[arrayIndex], outputValue[arrayIndex], errorData["property"]);
+        CVariant propertyError;
+        JSONRPC_STATUS status = items.at(arrayIndex)->Check(value[arrayIndex], outputValue[arrayIndex], propertyError);
         if (status != OK)
         {
+          errorData["property"] = std::move(propertyError);
           CLog::Log(
               LOGDEBUG,
               "JSONRPC: Array element at index {} does not match with items schema in type {}",
@@ -873,9 +900,11 @@ JSONRPC_STATUS JSONSchemaTypeDefinition::Check(const CVariant& value,
     {
       if (value.isMember(propertiesIterator->second->name))
       {
-        JSONRPC_STATUS status = propertiesIterator->second->Check(value[propertiesIterator->second->name], outputValue[propertiesIterator->second->name], errorData["property"]);
+        CVariant propertyError;
+        JSONRPC_STATUS status = propertiesIterator->second->Check(value[propertiesIterator->second->name], outputValue[propertiesIterator->second->name], propertyError);
         if (status != OK)
         {
+          errorData["property"] = std::move(propertyError);
           CLog::Log(LOGDEBUG, "JSONRPC: Invalid property \"{}\" in type {}",
                     propertiesIterator->second->name, name);
           return status;
@@ -916,9 +945,11 @@ JSONRPC_STATUS JSONSchemaTypeDefinition::Check(const CVariant& value,
             continue;
           }
 
-          JSONRPC_STATUS status = additionalProperties->Check(value[iter->first], outputValue[iter->first], errorData["property"]);
+          CVariant propertyError;
+          JSONRPC_STATUS status = additionalProperties->Check(value[iter->first], outputValue[iter->first], propertyError);
           if (status != OK)
           {
+            errorData["property"] = std::move(propertyError);
             CLog::Log(LOGDEBUG, "JSONRPC: Invalid additional property \"{}\" in type {}",
                       iter->first, name);
             return status;
@@ -930,7 +961,6 @@ JSONRPC_STATUS JSONSchemaTypeDefinition::Check(const CVariant& value,
       else if (!hasAdditionalProperties || additionalProperties == NULL)
       {
         errorData["message"] = "Unexpected additional properties received";
-        errorData.erase("property");
         return InvalidParams;
       }
     }
@@ -1441,13 +1471,19 @@ JSONRPC_STATUS JsonRpcMethod::checkParameter(const CVariant& requestParameters,
   // Let's check if the parameter has been provided
   if (ParameterExists(requestParameters, type->name, position))
   {
-    // Get the parameter
-    CVariant parameterValue = GetParameter(requestParameters, type->name, position);
+    // Get the parameter without copying it
+    const CVariant& parameterValue = IsValueMember(requestParameters, type->name)
+                                         ? requestParameters[type->name]
+                                         : requestParameters[position];
 
     // Evaluate the type of the parameter
-    JSONRPC_STATUS status = type->Check(parameterValue, outputParameters[type->name], errorData["stack"]);
+    CVariant parameterError;
+    JSONRPC_STATUS status = type->Check(parameterValue, outputParameters[type->name], parameterError);
     if (status != OK)
+    {
+      errorData["stack"] = std::move(parameterError);
       return status;
+    }
 
     // The parameter was present and valid
     handled++;
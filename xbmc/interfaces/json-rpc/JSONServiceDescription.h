@@ -37,6 +37,13 @@ namespace JSONRPC
     JSONSchemaTypeDefinition();
 
     bool Parse(const CVariant &value, bool isParameter = false);
+    /*!
+     \brief Checks the given value against this type definition
+     \param value Value to check
+     \param outputValue Checked value with defaults filled in for missing optional properties
+     \param errorData Details about the first mismatch. Only written to if the check fails.
+     \return OK if the value matches the type definition, an error code otherwise
+     */
     JSONRPC_STATUS Check(const CVariant& value, CVariant& outputValue, CVariant& errorData) const;
     void Print(bool isParameter, bool isGlobal, bool printDefault, bool printDescriptions, CVariant &output) const;
     void ResolveReference();
@@ -211,6 +218,12 @@ namespace JSONRPC
      \brief Type definition for additional properties
      */
     JSONSchemaTypeDefinitionPtr additionalProperties;
+
+  private:
+    JSONRPC_STATUS CheckValue(const CVariant& value,
+                              CVariant& outputValue,
+                              CVariant& errorData,
+                              bool& extendedTypeFailed) const;
   };
 
   /*!
@@ -11,6 +11,7 @@
 #include "ServiceBroker.h"
 #include "messaging/ApplicationMessenger.h"
 #include "powermanagement/PowerManager.h"
+#include "threads/LockStatistics.h"
 #include "utils/Variant.h"
 
 using namespace JSONRPC;
@@ -86,3 +87,30 @@ JSONRPC_STATUS CXBMCOperations::GetInfoBooleans(const std::string &method, ITran
 
   return OK;
 }
+
+JSONRPC_STATUS CXBMCOperations::GetLockStatistics(const std::string &method, ITransportLayer *transport, IClient *client, const CVariant &parameterObject, CVariant &result)
+{
+  using namespace std::chrono;
+
+  result["enabled"] = XbmcThreads::CLockStatistics::IsEnabled();
+  result["locks"] = CVariant(CVariant::VariantTypeArray);
+
+  const auto statistics = XbmcThreads::CLockStatistics::GetStatistics(
+      static_cast<size_t>(parameterObject["limit"].asUnsignedInteger()));
+  for (const auto& site : statistics)
+  {
+    CVariant lock(CVariant::VariantTypeObject);
+    lock["site"] = site.m_site;
+    lock["locks"] = site.m_locks;
+    lock["contentions"] = site.m_contentions;
+    lock["waittime"] = static_cast<uint64_t>(duration_cast<microseconds>(site.m_waitTime).count());
+    lock["maxwaittime"] =
+        static_cast<uint64_t>(duration_cast<microseconds>(site.m_maxWaitTime).count());
+    lock["holdtime"] = static_cast<uint64_t>(duration_cast<microseconds>(site.m_holdTime).count());
+    lock["maxholdtime"] =
+        static_cast<uint64_t>(duration_cast<microseconds>(site.m_maxHoldTime).count());
+    result["locks"].push_back(lock);
+  }
+
+  return OK;
+}
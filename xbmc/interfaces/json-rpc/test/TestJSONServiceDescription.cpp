@@ -0,0 +1,100 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "interfaces/json-rpc/JSONServiceDescription.h"
+#include "utils/Variant.h"
+
+#include <gtest/gtest.h>
+
+using namespace JSONRPC;
+
+class TestJSONServiceDescription : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    ASSERT_TRUE(CJSONServiceDescription::AddType(
+        R"("Test.Base": { "type": "object", "properties": {
+             "id": { "type": "integer", "required": true } } })"));
+    ASSERT_TRUE(CJSONServiceDescription::AddType(
+        R"("Test.Derived": { "extends": "Test.Base", "properties": {
+             "label": { "type": "string" } } })"));
+    ASSERT_TRUE(CJSONServiceDescription::AddType(R"("Test.Count": { "type": "integer" })"));
+  }
+
+  void TearDown() override { CJSONServiceDescription::Cleanup(); }
+};
+
+TEST_F(TestJSONServiceDescription, ValidValue)
+{
+  const JSONSchemaTypeDefinitionPtr type = CJSONServiceDescription::GetType("Test.Derived");
+  ASSERT_TRUE(type);
+
+  CVariant value(CVariant::VariantTypeObject);
+  value["id"] = 1;
+  value["label"] = "label";
+
+  CVariant output;
+  CVariant errorData;
+  EXPECT_EQ(OK, type->Check(value, output, errorData));
+  EXPECT_EQ(1, output["id"].asInteger());
+  EXPECT_EQ("label", output["label"].asString());
+
+  // the error data is only built when the check fails
+  EXPECT_TRUE(errorData.isNull());
+}
+
+TEST_F(TestJSONServiceDescription, InvalidType)
+{
+  const JSONSchemaTypeDefinitionPtr type = CJSONServiceDescription::GetType("Test.Count");
+  ASSERT_TRUE(type);
+
+  CVariant output;
+  CVariant errorData;
+  EXPECT_EQ(InvalidParams, type->Check(CVariant("one"), output, errorData));
+  EXPECT_EQ("Test.Count", errorData["name"].asString());
+  EXPECT_EQ("integer", errorData["type"].asString());
+  EXPECT_EQ("Invalid type string received", errorData["message"].asString());
+}
+
+TEST_F(TestJSONServiceDescription, InvalidProperty)
+{
+  const JSONSchemaTypeDefinitionPtr type = CJSONServiceDescription::GetType("Test.Derived");
+  ASSERT_TRUE(type);
+
+  CVariant value(CVariant::VariantTypeObject);
+  value["id"] = 1;
+  value["label"] = 2;
+
+  CVariant output;
+  CVariant errorData;
+  EXPECT_EQ(InvalidParams, type->Check(value, output, errorData));
+  EXPECT_EQ("Test.Derived", errorData["name"].asString());
+  EXPECT_EQ("object", errorData["type"].asString());
+  EXPECT_EQ("label", errorData["property"]["name"].asString());
+  EXPECT_EQ("string", errorData["property"]["type"].asString());
+}
+
+TEST_F(TestJSONServiceDescription, InvalidExtendedType)
+{
+  const JSONSchemaTypeDefinitionPtr type = CJSONServiceDescription::GetType("Test.Derived");
+  ASSERT_TRUE(type);
+
+  CVariant value(CVariant::VariantTypeObject);
+  value["id"] = "one";
+
+  // a mismatch of the extended type is reported with the name of the extended type
+  CVariant output;
+  CVariant errorData;
+  EXPECT_EQ(InvalidParams, type->Check(value, output, errorData));
+  EXPECT_EQ("Test.Base", errorData["name"].asString());
+  EXPECT_EQ("object", errorData["type"].asString());
+  EXPECT_EQ("value does not match extended type Test.Base", errorData["message"].asString());
+  EXPECT_EQ("id", errorData["property"]["name"].asString());
+  EXPECT_EQ("integer", errorData["property"]["type"].asString());
+}
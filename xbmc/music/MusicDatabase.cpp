@@ -2325,6 +2325,11 @@ int CMusicDatabase::AddRole(const std::string& strRole)
       return -1;
     if (nullptr == m_pDS)
       return -1;
+
+    auto it = m_roleCache.find(strRole);
+    if (it != m_roleCache.end())
+      return it->second;
+
     strSQL = PrepareSQL("SELECT idRole FROM role WHERE strRole LIKE '%s'", strRole.c_str());
     m_pDS->query(strSQL);
     if (m_pDS->num_rows() > 0)
@@ -2338,6 +2343,7 @@ int CMusicDatabase::AddRole(const std::string& strRole)
       idRole = static_cast<int>(m_pDS->lastinsertid());
       m_pDS->close();
     }
+    m_roleCache.insert(std::pair<std::string, int>(strRole, idRole));
   }
   catch (...)
   {
@@ -3957,6 +3963,7 @@ void CMusicDatabase::EmptyCache()
 {
   m_genreCache.erase(m_genreCache.begin(), m_genreCache.end());
   m_pathCache.erase(m_pathCache.begin(), m_pathCache.end());
+  m_roleCache.erase(m_roleCache.begin(), m_roleCache.end());
 }
 
 bool CMusicDatabase::Search(const std::string& search, CFileItemList& items)
@@ -4344,6 +4351,7 @@ bool CMusicDatabase::CleanupGenres()
     // Must be executed AFTER the song, and song_genre have been cleaned.
     std::string strSQL = "DELETE FROM genre WHERE idGenre NOT IN (SELECT idGenre FROM song_genre)";
     m_pDS->exec(strSQL);
+    m_genreCache.clear();
     return true;
   }
   catch (...)
@@ -4382,6 +4390,7 @@ bool CMusicDatabase::CleanupRoles()
     std::string strSQL = "DELETE FROM role "
                          "WHERE idRole > 1 AND idRole NOT IN (SELECT idRole FROM song_artist)";
     m_pDS->exec(strSQL);
+    m_roleCache.clear();
     return true;
   }
   catch (...)
@@ -11416,6 +11425,13 @@ int CMusicDatabase::GetSongIDFromPath(const std::string& filePath)
   return -1;
 }
 
+void CMusicDatabase::RollbackTransaction()
+{
+  CDatabase::RollbackTransaction();
+  // ids inserted within the transaction are gone
+  EmptyCache();
+}
+
 bool CMusicDatabase::CommitTransaction()
 {
   if (CDatabase::CommitTransaction())
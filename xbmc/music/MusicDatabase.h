@@ -106,6 +106,7 @@ public:
 
   bool Open() override;
   bool CommitTransaction() override;
+  void RollbackTransaction() override;
   void EmptyCache();
   void Clean();
   int Cleanup(CGUIDialogProgress* progressDialog = nullptr);
@@ -879,6 +880,7 @@ public:
 protected:
   std::map<std::string, int> m_genreCache;
   std::map<std::string, int> m_pathCache;
+  std::map<std::string, int> m_roleCache;
 
   void CreateTables() override;
   void CreateAnalytics() override;
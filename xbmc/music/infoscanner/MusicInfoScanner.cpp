@@ -44,15 +44,20 @@
 #include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
+#include "threads/Condition.h"
 #include "utils/Digest.h"
 #include "utils/FileExtensionProvider.h"
 #include "utils/FileUtils.h"
+#include "utils/JobManager.h"
 #include "utils/StringUtils.h"
 #include "utils/URIUtils.h"
 #include "utils/Variant.h"
 #include "utils/log.h"
 
 #include <algorithm>
+#include <chrono>
+#include <memory>
+#include <thread>
 #include <utility>
 
 using namespace MUSIC_INFO;
@@ -111,6 +116,8 @@ void CMusicInfoScanner::Process()
       // Reset progress vars
       m_currentItem=0;
       m_itemCount=-1;
+      m_tagsRead = 0;
+      m_tagReadTime = std::chrono::milliseconds(0);
 
       // Create the thread to count all files to be scanned
       if (m_handle)
@@ -271,6 +278,9 @@ void CMusicInfoScanner::Process()
     CLog::Log(LOGERROR, "MusicInfoScanner: Exception while scanning.");
   }
   m_musicDatabase.Close();
+  if (m_tagReadTime.count() > 0)
+    CLog::Log(LOGDEBUG, "{} - Read tags of {} files in {} ms ({} files/s)", __FUNCTION__,
+              m_tagsRead, m_tagReadTime.count(), m_tagsRead * 1000 / m_tagReadTime.count());
   CLog::Log(LOGDEBUG, "{} - Finished scan", __FUNCTION__);
 
   m_bRunning = false;
@@ -562,17 +572,101 @@ bool CMusicInfoScanner::DoScan(const std::string& strDirectory)
   return !m_bStop;
 }
 
+namespace
+{
+// upper bound of the threads reading tags of one directory, whatever the settings
+constexpr unsigned int MAX_TAG_READERS = 8;
+
+void LoadTag(CFileItem& item)
+{
+  CMusicInfoTag& tag = *item.GetMusicInfoTag();
+  if (!tag.Loaded())
+  {
+    std::unique_ptr<IMusicInfoTagLoader> pLoader(CMusicInfoTagLoaderFactory::CreateLoader(item));
+    if (nullptr != pLoader)
+      pLoader->Load(item.GetPath(), tag);
+  }
+}
+
+/*!
+ \brief Reads the tags of a list of files in order on a fixed set of threads.
+
+ Every reader claims the next file that nobody is reading yet. The scanner thread is a reader
+ too: WaitFor() reads the requested file itself when no other reader claimed it, so reading
+ never depends on a free job manager worker.
+ */
+class CTagReader
+{
+public:
+  explicit CTagReader(std::vector<CFileItemPtr> files)
+    : m_files(std::move(files)), m_loaded(m_files.size(), false)
+  {
+  }
+
+  //! Read tags until all files are claimed or Abort() was called
+  void Run()
+  {
+    std::unique_lock<CCriticalSection> lock(m_section);
+    if (m_abort)
+      return;
+
+    m_readers++;
+    while (!m_abort && m_next < m_files.size())
+      Load(lock, m_next++);
+    m_readers--;
+    m_readersDone.notifyAll();
+  }
+
+  //! Wait until the tag of the given file was read, in the order of the files
+  void WaitFor(size_t index)
+  {
+    std::unique_lock<CCriticalSection> lock(m_section);
+    if (m_next == index)
+      Load(lock, m_next++);
+    else
+      m_fileLoaded.wait(lock, [this, index]() { return static_cast<bool>(m_loaded[index]); });
+  }
+
+  //! Stop claiming files and wait for the readers to finish the file they are reading
+  void Abort()
+  {
+    std::unique_lock<CCriticalSection> lock(m_section);
+    m_abort = true;
+    m_readersDone.wait(lock, [this]() { return m_readers == 0; });
+  }
+
+private:
+  void Load(std::unique_lock<CCriticalSection>& lock, size_t index)
+  {
+    lock.unlock();
+    LoadTag(*m_files[index]);
+    lock.lock();
+    m_loaded[index] = true;
+    m_fileLoaded.notifyAll();
+  }
+
+  const std::vector<CFileItemPtr> m_files;
+  CCriticalSection m_section;
+  XbmcThreads::ConditionVariable m_fileLoaded;
+  XbmcThreads::ConditionVariable m_readersDone;
+  std::vector<bool> m_loaded;
+  size_t m_next = 0;
+  unsigned int m_readers = 0;
+  bool m_abort = false;
+};
+} // unnamed namespace
+
 CInfoScanner::INFO_RET CMusicInfoScanner::ScanTags(const CFileItemList& items,
                                                    CFileItemList& scannedItems)
 {
-  std::vector<std::string> regexps = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_audioExcludeFromScanRegExps;
+  const std::shared_ptr<CAdvancedSettings> advancedSettings =
+      CServiceBroker::GetSettingsComponent()->GetAdvancedSettings();
+  const std::vector<std::string>& regexps = advancedSettings->m_audioExcludeFromScanRegExps;
 
+  std::vector<CFileItemPtr> files;
   for (int i = 0; i < items.Size(); ++i)
   {
-    if (m_bStop)
-      return INFO_CANCELLED;
-
-    CFileItemPtr pItem = items[i];
+    const CFileItemPtr& pItem = items[i];
 
     if (CUtil::ExcludeFileOrFolder(pItem->GetPath(), regexps))
       continue;
@@ -580,19 +674,41 @@ CInfoScanner::INFO_RET CMusicInfoScanner::ScanTags(const CFileItemList& items,
     if (pItem->m_bIsFolder || pItem->IsPlayList() || pItem->IsPicture() || pItem->IsLyrics())
       continue;
 
-    m_currentItem++;
+    files.push_back(pItem);
+  }
 
-    CMusicInfoTag& tag = *pItem->GetMusicInfoTag();
-    if (!tag.Loaded())
+  // Opening files is mostly waiting on the disk or network, so read the tags of the next few
+  // files in parallel while the current one is processed. Results are still handled in order.
+  // This thread is one of the readers, the others run as jobs.
+  const unsigned int readers =
+      std::min({URIUtils::IsRemote(items.GetPath()) ? advancedSettings->m_musicTagReadersRemote
+                                                    : advancedSettings->m_musicTagReadersLocal,
+                std::max(std::thread::hardware_concurrency(), 1u), MAX_TAG_READERS,
+                static_cast<unsigned int>(files.size())});
+  const auto tagReader = std::make_shared<CTagReader>(files);
+  for (unsigned int i = 1; i < readers; ++i)
+    CServiceBroker::GetJobManager()->Submit([tagReader]() { tagReader->Run(); },
+                                            CJob::PRIORITY_LOW);
+
+  const auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < files.size(); ++i)
+  {
+    if (m_bStop)
     {
-      std::unique_ptr<IMusicInfoTagLoader> pLoader (CMusicInfoTagLoaderFactory::CreateLoader(*pItem));
-      if (nullptr != pLoader)
-        pLoader->Load(pItem->GetPath(), tag);
+      tagReader->Abort();
+      return INFO_CANCELLED;
     }
 
+    const CFileItemPtr& pItem = files[i];
+    tagReader->WaitFor(i);
+
+    m_currentItem++;
+    m_tagsRead++;
+
     if (m_handle && m_itemCount>0)
       m_handle->SetPercentage(static_cast<float>(m_currentItem * 100) / static_cast<float>(m_itemCount));
 
+    CMusicInfoTag& tag = *pItem->GetMusicInfoTag();
     if (!tag.Loaded() && !pItem->HasCueDocument())
     {
       CLog::Log(LOGDEBUG, "{} - No tag found for: {}", __FUNCTION__, pItem->GetPath());
@@ -609,6 +725,15 @@ CInfoScanner::INFO_RET CMusicInfoScanner::ScanTags(const CFileItemList& items,
     else
       scannedItems.Add(pItem);
   }
+  m_tagReadTime += std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - start);
+
+  if (m_handle && m_tagReadTime.count() > 0)
+  {
+    m_handle->SetText(StringUtils::Format("{} ({} files/s)", Prettify(items.GetPath()),
+                                          m_tagsRead * 1000 / m_tagReadTime.count()));
+  }
+
   return INFO_ADDED;
 }
 
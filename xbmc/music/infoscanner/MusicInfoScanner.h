@@ -16,6 +16,9 @@
 #include "threads/Thread.h"
 #include "utils/ScraperUrl.h"
 
+#include <chrono>
+#include <cstdint>
+
 class CAlbum;
 class CArtist;
 class CGUIDialogProgressBarHandle;
@@ -250,6 +253,8 @@ protected:
 
   int m_currentItem;
   int m_itemCount;
+  int64_t m_tagsRead = 0;
+  std::chrono::milliseconds m_tagReadTime{0};
   bool m_bStop;
   bool m_needsCleanup = false;
   int m_scanType = 0; // 0 - load from files, 1 - albums, 2 - artists
@@ -8,15 +8,17 @@
 
 #include "DNSNameCache.h"
 
+#include "ServiceBroker.h"
 #include "threads/CriticalSection.h"
+#include "threads/Event.h"
+#include "utils/JobManager.h"
 #include "utils/StringUtils.h"
 #include "utils/log.h"
 
+#include <algorithm>
 #include <mutex>
 
 #if !defined(TARGET_WINDOWS) && defined(HAS_FILESYSTEM_SMB)
-#include "ServiceBroker.h"
-
 #include "platform/posix/filesystem/SMBWSDiscovery.h"
 #endif
 
@@ -24,6 +26,39 @@
 #include <netdb.h>
 #include <netinet/in.h>
 
+namespace
+{
+// How long addresses are cached, as the system resolver doesn't tell the TTL
+// of the records
+constexpr std::chrono::seconds DEFAULT_TTL(600);
+
+// How long names which don't resolve are cached, and how long an address is
+// kept when refreshing it fails
+constexpr std::chrono::seconds NEGATIVE_TTL(30);
+
+// How long a lookup waits for a resolution started elsewhere before resolving
+// the name itself, in case that resolution never runs
+constexpr std::chrono::seconds RESOLVE_WAIT_TIMEOUT(10);
+
+bool GetWSDiscoveryCached(const std::string& strHostName, std::string& strIpAddress)
+{
+#if !defined(TARGET_WINDOWS) && defined(HAS_FILESYSTEM_SMB)
+  if (WSDiscovery::CWSDiscoveryPosix::IsInitialized())
+  {
+    WSDiscovery::CWSDiscoveryPosix& WSInstance =
+        dynamic_cast<WSDiscovery::CWSDiscoveryPosix&>(CServiceBroker::GetWSDiscovery());
+    if (WSInstance.GetCached(strHostName, strIpAddress))
+      return true;
+  }
+  else
+    CLog::Log(LOGDEBUG, LOGWSDISCOVERY,
+              "CDNSNameCache::GetCached: CWSDiscoveryPosix not initialized");
+#endif
+
+  return false;
+}
+} // namespace
+
 CDNSNameCache g_DNSCache;
 
 CCriticalSection CDNSNameCache::m_critical;
@@ -38,6 +73,193 @@ bool CDNSNameCache::Lookup(const std::string& strHostName, std::string& strIpAdd
     return false;
 
   // first see if this is already an ip address
+  if (IsIpAddress(strHostName, strIpAddress))
+    return true;
+
+  const auto start = std::chrono::steady_clock::now();
+  bool waited = false;
+  bool waitTimedOut = false;
+  bool checkedWSDiscovery = false;
+
+  std::unique_lock<CCriticalSection> lock(m_critical);
+  Stats& stats = g_DNSCache.m_stats;
+  stats.lookups++;
+
+  while (true)
+  {
+    // check if there's a custom entry or if it's already cached
+    auto it = g_DNSCache.m_entries.find(strHostName);
+    if (it != g_DNSCache.m_entries.end())
+    {
+      CEntry& entry = it->second;
+      const bool expired = std::chrono::steady_clock::now() >= entry.m_expiry;
+
+      if (!expired || !entry.m_strIpAddress.empty())
+      {
+        // WS-Discovery knows hosts the resolver doesn't, and may have found this one since
+        if (entry.m_strIpAddress.empty() && !checkedWSDiscovery)
+        {
+          lock.unlock();
+          if (LookupDiscovery(strHostName, strIpAddress))
+            return true;
+          lock.lock();
+          checkedWSDiscovery = true;
+          continue;
+        }
+
+        stats.hits++;
+        if (entry.m_strIpAddress.empty())
+          stats.negativeHits++;
+
+        // the address most likely didn't change, so it's used while refreshing it
+        if (expired)
+        {
+          stats.staleHits++;
+
+          // without job workers the lookup refreshes the address itself
+          if (!entry.m_resolved && !ResolveAsync(strHostName))
+            break;
+        }
+
+        if (waited)
+          stats.totalWaitTime += std::chrono::duration_cast<std::chrono::microseconds>(
+              std::chrono::steady_clock::now() - start);
+
+        strIpAddress = entry.m_strIpAddress;
+        return !strIpAddress.empty();
+      }
+
+      // wait for the resolution started by a prefetch or another lookup
+      if (entry.m_resolved && !waitTimedOut)
+      {
+        std::shared_ptr<CEvent> resolved = entry.m_resolved;
+        lock.unlock();
+        waitTimedOut = !resolved->Wait(RESOLVE_WAIT_TIMEOUT);
+        lock.lock();
+        waited = true;
+        if (waitTimedOut)
+          CLog::Log(LOGWARNING, "CDNSNameCache: Resolving '{}' takes too long, resolving it again",
+                    strHostName);
+        continue;
+      }
+    }
+
+    if (!checkedWSDiscovery)
+    {
+      lock.unlock();
+      if (LookupDiscovery(strHostName, strIpAddress))
+        return true;
+      lock.lock();
+      checkedWSDiscovery = true;
+      continue;
+    }
+
+    break;
+  }
+
+  // perform dns lookup, any lookups waiting for a resolution started before
+  // are released by this one as well
+  CEntry& entry = g_DNSCache.m_entries[strHostName];
+  if (!entry.m_resolved)
+    entry.m_resolved = std::make_shared<CEvent>(true);
+  lock.unlock();
+  Resolve(strHostName);
+  lock.lock();
+
+  stats.totalWaitTime += std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start);
+
+  strIpAddress = g_DNSCache.m_entries[strHostName].m_strIpAddress;
+  return !strIpAddress.empty();
+}
+
+bool CDNSNameCache::GetCached(const std::string& strHostName, std::string& strIpAddress)
+{
+  {
+    std::unique_lock<CCriticalSection> lock(m_critical);
+
+    auto it = g_DNSCache.m_entries.find(strHostName);
+    if (it != g_DNSCache.m_entries.end() && !it->second.m_strIpAddress.empty() &&
+        std::chrono::steady_clock::now() < it->second.m_expiry)
+    {
+      strIpAddress = it->second.m_strIpAddress;
+      return true;
+    }
+  }
+
+  if (LookupDiscovery(strHostName, strIpAddress))
+    return true;
+
+  // not cached
+  return false;
+}
+
+void CDNSNameCache::Add(const std::string& strHostName, const std::string& strIpAddress)
+{
+  std::unique_lock<CCriticalSection> lock(m_critical);
+
+  // custom entries never expire
+  CEntry& entry = g_DNSCache.m_entries[strHostName];
+  entry.m_strIpAddress = strIpAddress;
+  entry.m_expiry = std::chrono::steady_clock::time_point::max();
+}
+
+void CDNSNameCache::Prefetch(const std::vector<std::string>& hostNames)
+{
+  std::unique_lock<CCriticalSection> lock(m_critical);
+
+  for (const std::string& strHostName : hostNames)
+  {
+    std::string strIpAddress;
+    if (strHostName.empty() || IsIpAddress(strHostName, strIpAddress))
+      continue;
+
+    auto it = g_DNSCache.m_entries.find(strHostName);
+    if (it != g_DNSCache.m_entries.end() &&
+        (it->second.m_resolved || std::chrono::steady_clock::now() < it->second.m_expiry))
+      continue;
+
+    // without job workers the name is resolved by its first lookup
+    if (!ResolveAsync(strHostName))
+      break;
+  }
+}
+
+void CDNSNameCache::SetResolver(Resolver resolver)
+{
+  std::unique_lock<CCriticalSection> lock(m_critical);
+  g_DNSCache.m_resolver = std::move(resolver);
+}
+
+void CDNSNameCache::SetDiscoveryLookup(DiscoveryLookup discoveryLookup)
+{
+  std::unique_lock<CCriticalSection> lock(m_critical);
+  g_DNSCache.m_discoveryLookup = std::move(discoveryLookup);
+}
+
+CDNSNameCache::Stats CDNSNameCache::GetStats()
+{
+  std::unique_lock<CCriticalSection> lock(m_critical);
+  return g_DNSCache.m_stats;
+}
+
+void CDNSNameCache::Clear()
+{
+  std::unique_lock<CCriticalSection> lock(m_critical);
+
+  // don't leave lookups waiting for running resolutions
+  for (auto& entry : g_DNSCache.m_entries)
+  {
+    if (entry.second.m_resolved)
+      entry.second.m_resolved->Set();
+  }
+
+  g_DNSCache.m_entries.clear();
+  g_DNSCache.m_stats = Stats{};
+}
+
+bool CDNSNameCache::IsIpAddress(const std::string& strHostName, std::string& strIpAddress)
+{
   unsigned long address = inet_addr(strHostName.c_str());
   strIpAddress.clear();
 
@@ -48,67 +270,123 @@ bool CDNSNameCache::Lookup(const std::string& strHostName, std::string& strIpAdd
     return true;
   }
 
-  // check if there's a custom entry or if it's already cached
-  if(g_DNSCache.GetCached(strHostName, strIpAddress))
-    return true;
+  return false;
+}
 
-  // perform dns lookup
-  struct hostent *host = gethostbyname(strHostName.c_str());
-  if (host && host->h_addr_list[0])
-  {
-    strIpAddress = StringUtils::Format("{}.{}.{}.{}", (unsigned char)host->h_addr_list[0][0],
-                                       (unsigned char)host->h_addr_list[0][1],
-                                       (unsigned char)host->h_addr_list[0][2],
-                                       (unsigned char)host->h_addr_list[0][3]);
-    g_DNSCache.Add(strHostName, strIpAddress);
-    return true;
-  }
+bool CDNSNameCache::ResolveHost(const std::string& strHostName,
+                                std::string& strIpAddress,
+                                std::chrono::seconds& ttl)
+{
+  // getaddrinfo is thread safe unlike gethostbyname, which matters for the
+  // resolutions running in parallel
+  struct addrinfo hints = {};
+  hints.ai_family = AF_INET;
 
-  CLog::Log(LOGERROR, "Unable to lookup host: '{}'", strHostName);
-  return false;
+  struct addrinfo* result = nullptr;
+  if (getaddrinfo(strHostName.c_str(), nullptr, &hints, &result) != 0 || !result)
+    return false;
+
+  char address[INET_ADDRSTRLEN];
+  const bool resolved =
+      inet_ntop(AF_INET, &reinterpret_cast<struct sockaddr_in*>(result->ai_addr)->sin_addr,
+                address, sizeof(address)) != nullptr;
+  freeaddrinfo(result);
+
+  if (resolved)
+    strIpAddress = address;
+
+  return resolved;
 }
 
-bool CDNSNameCache::GetCached(const std::string& strHostName, std::string& strIpAddress)
+void CDNSNameCache::Resolve(const std::string& strHostName)
 {
+  Resolver resolver;
   {
     std::unique_lock<CCriticalSection> lock(m_critical);
-
-    // loop through all DNSname entries and see if strHostName is cached
-    for (const auto& DNSname : g_DNSCache.m_vecDNSNames)
-    {
-      if (DNSname.m_strHostName == strHostName)
-      {
-        strIpAddress = DNSname.m_strIpAddress;
-        return true;
-      }
-    }
+    resolver = g_DNSCache.m_resolver;
   }
 
-#if !defined(TARGET_WINDOWS) && defined(HAS_FILESYSTEM_SMB)
-  if (WSDiscovery::CWSDiscoveryPosix::IsInitialized())
+  std::string strIpAddress;
+  std::chrono::seconds ttl = DEFAULT_TTL;
+
+  const auto start = std::chrono::steady_clock::now();
+  const bool resolved = resolver ? resolver(strHostName, strIpAddress, ttl)
+                                 : ResolveHost(strHostName, strIpAddress, ttl);
+  const auto end = std::chrono::steady_clock::now();
+  const auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+
+  std::unique_lock<CCriticalSection> lock(m_critical);
+
+  CEntry& entry = g_DNSCache.m_entries[strHostName];
+  if (resolved)
   {
-    WSDiscovery::CWSDiscoveryPosix& WSInstance =
-        dynamic_cast<WSDiscovery::CWSDiscoveryPosix&>(CServiceBroker::GetWSDiscovery());
-    if (WSInstance.GetCached(strHostName, strIpAddress))
-      return true;
+    entry.m_strIpAddress = strIpAddress;
+    entry.m_expiry = end + ttl;
   }
   else
-    CLog::Log(LOGDEBUG, LOGWSDISCOVERY,
-              "CDNSNameCache::GetCached: CWSDiscoveryPosix not initialized");
-#endif
+  {
+    // an address which was resolved before is kept until the resolver recovers
+    entry.m_expiry = end + (ttl == DEFAULT_TTL ? NEGATIVE_TTL : ttl);
+    if (entry.m_strIpAddress.empty())
+      CLog::Log(LOGERROR, "Unable to lookup host: '{}'", strHostName);
+    else
+      CLog::Log(LOGWARNING, "Unable to refresh host: '{}', keeping {}", strHostName,
+                entry.m_strIpAddress);
+  }
 
-  // not cached
-  return false;
+  if (entry.m_resolved)
+  {
+    entry.m_resolved->Set();
+    entry.m_resolved.reset();
+  }
+
+  Stats& stats = g_DNSCache.m_stats;
+  stats.resolutions++;
+  if (!resolved)
+    stats.failures++;
+  stats.totalResolveTime += duration;
+  stats.maxResolveTime = std::max(stats.maxResolveTime, duration);
+
+  LogStats(strHostName, duration);
 }
 
-void CDNSNameCache::Add(const std::string& strHostName, const std::string& strIpAddress)
+bool CDNSNameCache::ResolveAsync(const std::string& strHostName)
 {
-  CDNSName dnsName;
+  std::shared_ptr<CJobManager> jobManager = CServiceBroker::GetJobManager();
+  if (!jobManager)
+    return false;
 
-  dnsName.m_strHostName = strHostName;
-  dnsName.m_strIpAddress  = strIpAddress;
+  g_DNSCache.m_entries[strHostName].m_resolved = std::make_shared<CEvent>(true);
 
-  std::unique_lock<CCriticalSection> lock(m_critical);
-  g_DNSCache.m_vecDNSNames.push_back(dnsName);
+  // lookups running on job workers wait for the resolution, so it must not
+  // queue behind them for a worker
+  jobManager->Submit([strHostName]() { Resolve(strHostName); }, CJob::PRIORITY_DEDICATED);
+  return true;
 }
 
+bool CDNSNameCache::LookupDiscovery(const std::string& strHostName, std::string& strIpAddress)
+{
+  DiscoveryLookup discoveryLookup;
+  {
+    std::unique_lock<CCriticalSection> lock(m_critical);
+    discoveryLookup = g_DNSCache.m_discoveryLookup;
+  }
+
+  return discoveryLookup ? discoveryLookup(strHostName, strIpAddress)
+                         : GetWSDiscoveryCached(strHostName, strIpAddress);
+}
+
+void CDNSNameCache::LogStats(const std::string& strHostName, std::chrono::microseconds duration)
+{
+  const Stats& stats = g_DNSCache.m_stats;
+
+  CLog::Log(LOGDEBUG,
+            "CDNSNameCache: Resolved '{}' in {:.1f} ms, {} lookups with {:.1f}% from cache "
+            "({} stale, {} negative), {} resolutions with {} failed, average {:.1f} ms, max "
+            "{:.1f} ms",
+            strHostName, duration.count() / 1000.0, stats.lookups,
+            stats.lookups > 0 ? 100.0 * stats.hits / stats.lookups : 0.0, stats.staleHits,
+            stats.negativeHits, stats.resolutions, stats.failures,
+            stats.totalResolveTime.count() / 1000.0 / stats.resolutions,
+            stats.maxResolveTime.count() / 1000.0);
+}
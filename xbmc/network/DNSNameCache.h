@@ -8,27 +8,110 @@
 
 #pragma once
 
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <stdint.h>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 class CCriticalSection;
+class CEvent;
 
 class CDNSNameCache
 {
 public:
-  class CDNSName
+  /*!
+   * \brief Resolves a host name to an IPv4 address
+   *
+   * \param strHostName The host name to resolve
+   * \param[out] strIpAddress The address, if the name resolves
+   * \param[in,out] ttl How long the result may be cached, preset to the
+   *        default for a resolved name. Names which don't resolve are cached
+   *        for a shorter time unless it's changed.
+   * \return true if the name resolves
+   */
+  using Resolver = std::function<bool(
+      const std::string& strHostName, std::string& strIpAddress, std::chrono::seconds& ttl)>;
+
+  /*!
+   * \brief Looks up a host name in the names announced by WS-Discovery
+   *
+   * \param strHostName The host name to look up
+   * \param[out] strIpAddress The address, if the name is known
+   * \return true if the name is known
+   */
+  using DiscoveryLookup =
+      std::function<bool(const std::string& strHostName, std::string& strIpAddress)>;
+
+  struct Stats
   {
-  public:
-    std::string m_strHostName;
-    std::string m_strIpAddress;
+    uint64_t lookups = 0;
+    uint64_t hits = 0; // served from the cache, including names which don't resolve
+    uint64_t staleHits = 0; // expired addresses served while being refreshed
+    uint64_t negativeHits = 0;
+    uint64_t resolutions = 0;
+    uint64_t failures = 0;
+    std::chrono::microseconds totalResolveTime{0};
+    std::chrono::microseconds maxResolveTime{0};
+    std::chrono::microseconds totalWaitTime{0}; // lookups waiting for a resolution
   };
+
   CDNSNameCache(void);
   virtual ~CDNSNameCache(void);
   static void Add(const std::string& strHostName, const std::string& strIpAddress);
   static bool GetCached(const std::string& strHostName, std::string& strIpAddress);
   static bool Lookup(const std::string& strHostName, std::string& strIpAddress);
 
+  /*!
+   * \brief Resolve host names in the background, so their first lookups don't
+   * wait for the resolver
+   */
+  static void Prefetch(const std::vector<std::string>& hostNames);
+
+  /*!
+   * \brief Replace the system resolver, nullptr restores it
+   */
+  static void SetResolver(Resolver resolver);
+
+  /*!
+   * \brief Replace the WS-Discovery lookup, nullptr restores it
+   */
+  static void SetDiscoveryLookup(DiscoveryLookup discoveryLookup);
+
+  static Stats GetStats();
+
+  /*!
+   * \brief Remove all entries and reset the statistics
+   */
+  static void Clear();
+
 protected:
+  struct CEntry
+  {
+    std::string m_strIpAddress; // empty if the name doesn't resolve
+    std::chrono::steady_clock::time_point m_expiry;
+    std::shared_ptr<CEvent> m_resolved; // set while a resolution is running
+  };
+
+  static bool IsIpAddress(const std::string& strHostName, std::string& strIpAddress);
+  static bool ResolveHost(const std::string& strHostName,
+                          std::string& strIpAddress,
+                          std::chrono::seconds& ttl);
+  static void Resolve(const std::string& strHostName);
+  /*!
+   * \brief Start resolving a host name on a job worker, must be called with
+   * m_critical held
+   * \return false if there are no job workers to resolve the name
+   */
+  static bool ResolveAsync(const std::string& strHostName);
+  static bool LookupDiscovery(const std::string& strHostName, std::string& strIpAddress);
+  static void LogStats(const std::string& strHostName, std::chrono::microseconds duration);
+
   static CCriticalSection m_critical;
-  std::vector<CDNSName> m_vecDNSNames;
+  std::unordered_map<std::string, CEntry> m_entries;
+  Resolver m_resolver;
+  DiscoveryLookup m_discoveryLookup;
+  Stats m_stats;
 };
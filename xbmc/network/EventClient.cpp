@@ -23,6 +23,7 @@
 #include "utils/log.h"
 #include "windowing/GraphicContext.h"
 
+#include <cstring>
 #include <map>
 #include <mutex>
 #include <queue>
@@ -50,6 +51,43 @@ struct ButtonStateFinder
   std::string    m_button;
 };
 
+namespace
+{
+// Offset of the amount in the payload of a button packet
+constexpr unsigned int BUTTON_AMOUNT_OFFSET = 4;
+
+// Whether a packet only carries a state which the next packet replaces, which
+// is the case for absolute mouse positions and for held axes whose amount
+// changes. Releases and separate presses are never replaced.
+bool IsReplacedBy(const CEventPacket& packet, const CEventPacket& next)
+{
+  if (packet.Type() != next.Type() || packet.Size() > 1 || next.Size() > 1)
+    return false;
+
+  if (packet.Type() == PT_MOUSE)
+    return true;
+
+  if (packet.Type() != PT_BUTTON || packet.PayloadSize() != next.PayloadSize() ||
+      packet.PayloadSize() < BUTTON_AMOUNT_OFFSET + 2)
+    return false;
+
+  const uint8_t* payload = packet.Payload();
+  const uint8_t* nextPayload = next.Payload();
+  const unsigned short flags = ntohs(*reinterpret_cast<const uint16_t*>(payload + 2));
+  if (!(flags & PTB_DOWN) || !(flags & PTB_USE_AMOUNT) || !(flags & (PTB_AXIS | PTB_AXISSINGLE)))
+    return false;
+
+  // each of these is a separate press
+  if ((flags & PTB_QUEUE) && (flags & PTB_NO_REPEAT))
+    return false;
+
+  // the same button with the same flags, map and name
+  return memcmp(payload, nextPayload, BUTTON_AMOUNT_OFFSET) == 0 &&
+         memcmp(payload + BUTTON_AMOUNT_OFFSET + 2, nextPayload + BUTTON_AMOUNT_OFFSET + 2,
+                packet.PayloadSize() - BUTTON_AMOUNT_OFFSET - 2) == 0;
+}
+} // namespace
+
 /************************************************************************/
 /* CEventButtonState                                                    */
 /************************************************************************/
@@ -110,6 +148,7 @@ bool CEventClient::AddPacket(std::unique_ptr<CEventPacket> packet)
     }
 
     unsigned int sequence = packet->Sequence();
+    const auto arrivalTime = packet->ArrivalTime(); // of the last packet completing the sequence
 
     m_seqPackets[sequence] = std::move(packet);
     if (m_seqPackets.size() == m_seqPackets[sequence]->Size())
@@ -134,6 +173,7 @@ bool CEventClient::AddPacket(std::unique_ptr<CEventPacket> packet)
           m_seqPackets.erase(i);
       }
       m_seqPackets[1]->SetPayload(newPayload);
+      m_seqPackets[1]->SetArrivalTime(arrivalTime);
       m_readyPackets.push(std::move(m_seqPackets[1]));
       m_seqPackets.clear();
     }
@@ -145,17 +185,27 @@ bool CEventClient::AddPacket(std::unique_ptr<CEventPacket> packet)
   return true;
 }
 
-void CEventClient::ProcessEvents()
+unsigned int CEventClient::ProcessEvents()
 {
-  if (!m_readyPackets.empty())
+  unsigned int replaced = 0;
+
+  while ( ! m_readyPackets.empty() )
   {
-    while ( ! m_readyPackets.empty() )
+    std::unique_ptr<CEventPacket> packet = std::move(m_readyPackets.front());
+    m_readyPackets.pop();
+
+    // mouse moves and axis changes received together only need the last one
+    if (!m_readyPackets.empty() && IsReplacedBy(*packet, *m_readyPackets.front()))
     {
-      ProcessPacket(m_readyPackets.front().get());
-      if ( ! m_readyPackets.empty() ) // in case the BYE packet cleared the queues
-        m_readyPackets.pop();
+      ResetTimeout();
+      replaced++;
+      continue;
     }
+
+    ProcessPacket(packet.get());
   }
+
+  return replaced;
 }
 
 bool CEventClient::GetNextAction(CEventAction &action)
@@ -384,6 +434,7 @@ bool CEventClient::OnPacketBUTTON(CEventPacket *packet)
                              (flags & (PTB_AXIS|PTB_AXISSINGLE)) ? true  : false,
                              (flags & PTB_NO_REPEAT)             ? false : true,
                              (flags & PTB_USE_AMOUNT)            ? true : false );
+    state.m_arrivalTime = packet->ArrivalTime();
 
     /* correct non active events so they work with rest of code */
     if(!active)
@@ -456,6 +507,7 @@ bool CEventClient::OnPacketBUTTON(CEventPacket *packet)
       m_currentButton.m_bRepeat    = (flags & PTB_NO_REPEAT)  ? false : true;
       m_currentButton.m_bAxis      = (flags & PTB_AXIS)       ? true : false;
       m_currentButton.m_iNextRepeat = {};
+      m_currentButton.m_arrivalTime = packet->ArrivalTime();
       m_currentButton.SetActive();
       m_currentButton.Load();
     }
@@ -472,6 +524,7 @@ bool CEventClient::OnPacketBUTTON(CEventPacket *packet)
                                  m_currentButton.m_bAxis,
                                  false,
                                  true );
+        state.m_arrivalTime = packet->ArrivalTime();
 
         m_buttonQueue.push_back (state);
       }
@@ -611,6 +664,7 @@ bool CEventClient::OnPacketACTION(CEventPacket *packet)
     {
       std::unique_lock<CCriticalSection> lock(m_critSection);
       m_actionQueue.push(CEventAction(actionString.c_str(), actionType));
+      m_actionQueue.back().arrivalTime = packet->ArrivalTime();
     }
     break;
 
@@ -680,10 +734,12 @@ void CEventClient::FreePacketQueues()
   m_seqPackets.clear();
 }
 
-unsigned int CEventClient::GetButtonCode(std::string& strMapName, bool& isAxis, float& amount, bool &isJoystick)
+unsigned int CEventClient::GetButtonCode(std::string& strMapName, bool& isAxis, float& amount, bool &isJoystick,
+                                         std::chrono::steady_clock::time_point& arrivalTime)
 {
   std::unique_lock<CCriticalSection> lock(m_critSection);
   unsigned int bcode = 0;
+  arrivalTime = {};
 
   if ( m_currentButton.Active() )
   {
@@ -698,14 +754,20 @@ unsigned int CEventClient::GetButtonCode(std::string& strMapName, bool& isAxis,
 
     isAxis = m_currentButton.Axis();
     amount = m_currentButton.Amount();
+    arrivalTime = m_currentButton.m_arrivalTime;
 
     if ( ! m_currentButton.Repeat() )
       m_currentButton.Reset();
     else
     {
       if ( ! CheckButtonRepeat(m_currentButton.m_iNextRepeat) )
+      {
         bcode = 0;
+        arrivalTime = {};
+      }
     }
+    if (bcode)
+      m_currentButton.m_arrivalTime = {};
     return bcode;
   }
 
@@ -741,7 +803,9 @@ unsigned int CEventClient::GetButtonCode(std::string& strMapName, bool& isAxis,
         bcode = 0;
         continue;
       }
+      repeat.back().m_arrivalTime = {};
     }
+    arrivalTime = it->m_arrivalTime;
   }
 
   m_buttonQueue.erase(m_buttonQueue.begin(), it);
@@ -42,6 +42,7 @@ namespace EVENTCLIENT
 
     std::string    actionName;
     unsigned char  actionType;
+    std::chrono::steady_clock::time_point arrivalTime; // of the packet
   };
 
   class CEventButtonState
@@ -104,6 +105,7 @@ namespace EVENTCLIENT
     bool              m_bActive;
     bool              m_bAxis;
     std::chrono::time_point<std::chrono::steady_clock> m_iNextRepeat;
+    std::chrono::time_point<std::chrono::steady_clock> m_arrivalTime; // of the packet, until first returned
   };
 
 
@@ -173,8 +175,9 @@ namespace EVENTCLIENT
     // process the packet queue
     bool ProcessQueue();
 
-    // process the queued up events (packets)
-    void ProcessEvents();
+    // process the queued up events (packets), returns the number of packets
+    // skipped because a following packet replaces them
+    unsigned int ProcessEvents();
 
     // gets the next action in the action queue
     bool GetNextAction(CEventAction& action);
@@ -182,8 +185,9 @@ namespace EVENTCLIENT
     // deallocate all packets in the queues
     void FreePacketQueues();
 
-    // return event states
-    unsigned int GetButtonCode(std::string& strMapName, bool& isAxis, float& amount, bool &isJoystick);
+    // return event states, arrivalTime is only set the first time a button is returned
+    unsigned int GetButtonCode(std::string& strMapName, bool& isAxis, float& amount, bool &isJoystick,
+                               std::chrono::steady_clock::time_point& arrivalTime);
 
     // update mouse position
     bool GetMousePos(float& x, float& y);
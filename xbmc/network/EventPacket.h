@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <cstdint>
 #include <stdlib.h>
 #include <vector>
@@ -210,6 +211,8 @@ namespace EVENTPACKET
     unsigned int PayloadSize() const { return m_pPayload.size(); }
     unsigned int ClientToken() const { return m_iClientToken; }
     void SetPayload(std::vector<uint8_t> payload);
+    std::chrono::steady_clock::time_point ArrivalTime() const { return m_arrivalTime; }
+    void SetArrivalTime(std::chrono::steady_clock::time_point time) { m_arrivalTime = time; }
 
   protected:
     bool m_bValid{false};
@@ -221,6 +224,7 @@ namespace EVENTPACKET
     unsigned char m_cMajVer{'0'};
     unsigned char m_cMinVer{'0'};
     PacketType m_eType{PT_LAST};
+    std::chrono::steady_clock::time_point m_arrivalTime;
   };
 
 }
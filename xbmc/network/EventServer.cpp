@@ -18,6 +18,7 @@
 #include "input/Key.h"
 #include "input/actions/ActionTranslator.h"
 #include "interfaces/builtins/Builtins.h"
+#include "utils/StringUtils.h"
 #include "utils/SystemInfo.h"
 #include "utils/log.h"
 
@@ -32,6 +33,18 @@ using namespace EVENTCLIENT;
 using namespace SOCKETS;
 using namespace std::chrono_literals;
 
+namespace
+{
+// Packets read from the socket at once
+constexpr int MAX_BATCH_PACKETS = 32;
+
+// Upper limits of the latency histogram buckets in ms
+constexpr std::array<int, 8> LATENCY_BUCKET_LIMITS_MS = {1, 2, 5, 10, 20, 50, 100, 200};
+
+// Dispatched actions and buttons between logging the statistics
+constexpr uint64_t STATS_INTERVAL = 1000;
+} // namespace
+
 /************************************************************************/
 /* CEventServer                                                         */
 /************************************************************************/
@@ -116,7 +129,6 @@ void CEventServer::Process()
 void CEventServer::Run()
 {
   CSocketListener listener;
-  int packetSize = 0;
 
   CLog::Log(LOGINFO, "ES: Starting UDP Event server on port {}", m_iPort);
 
@@ -130,7 +142,9 @@ void CEventServer::Run()
     return;
   }
 
-  m_pPacketBuffer.resize(PACKET_SIZE);
+  m_pPacketBuffer.resize(PACKET_SIZE * MAX_BATCH_PACKETS);
+  m_packetAddresses.resize(MAX_BATCH_PACKETS);
+  m_packetSizes.resize(MAX_BATCH_PACKETS);
 
   // bind to IP and start listening on port
   const std::shared_ptr<CSettings> settings = CServiceBroker::GetSettingsComponent()->GetSettings();
@@ -166,10 +180,22 @@ void CEventServer::Run()
       // start listening until we timeout
       if (listener.Listen(m_iListenTimeout))
       {
-        CAddress addr;
-        if ((packetSize = m_pSocket->Read(addr, PACKET_SIZE, m_pPacketBuffer.data())) > -1)
+        // read everything received from all clients at once
+        int packets = m_pSocket->ReadMultiple(m_packetAddresses.data(), m_packetSizes.data(),
+                                              MAX_BATCH_PACKETS, PACKET_SIZE,
+                                              m_pPacketBuffer.data());
+        const auto arrivalTime = std::chrono::steady_clock::now();
+        for (int i = 0; i < packets; i++)
+        {
+          ProcessPacket(m_packetAddresses[i], m_pPacketBuffer.data() + i * PACKET_SIZE,
+                        m_packetSizes[i], arrivalTime);
+        }
+
+        if (packets > 0)
         {
-          ProcessPacket(addr, packetSize);
+          std::unique_lock<CCriticalSection> lock(m_critSection);
+          m_receivedPackets += packets;
+          m_receiveBatches++;
         }
       }
     }
@@ -191,14 +217,17 @@ void CEventServer::Run()
 
   CLog::Log(LOGINFO, "ES: UDP Event server stopped");
   m_bRunning = false;
+  LogStats();
   Cleanup();
 }
 
-void CEventServer::ProcessPacket(CAddress& addr, int pSize)
+void CEventServer::ProcessPacket(CAddress& addr,
+                                 const uint8_t* data,
+                                 int pSize,
+                                 std::chrono::steady_clock::time_point arrivalTime)
 {
   // check packet validity
-  std::unique_ptr<CEventPacket> packet =
-      std::make_unique<CEventPacket>(pSize, m_pPacketBuffer.data());
+  std::unique_ptr<CEventPacket> packet = std::make_unique<CEventPacket>(pSize, data);
   if (!packet)
   {
     CLog::Log(LOGERROR, "ES: Out of memory, cannot accept packet");
@@ -240,6 +269,7 @@ void CEventServer::ProcessPacket(CAddress& addr, int pSize)
 
     m_clients[clientToken] = std::move(client);
   }
+  packet->SetArrivalTime(arrivalTime);
   m_clients[clientToken]->AddPacket(std::move(packet));
 }
 
@@ -276,11 +306,51 @@ void CEventServer::ProcessEvents()
 
   while (iter != m_clients.end())
   {
-    iter->second->ProcessEvents();
+    m_replacedPackets += iter->second->ProcessEvents();
     ++iter;
   }
 }
 
+void CEventServer::AddLatency(std::chrono::steady_clock::time_point arrivalTime)
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+
+  const auto latency = std::chrono::steady_clock::now() - arrivalTime;
+  const auto latencyMs = std::chrono::duration_cast<std::chrono::milliseconds>(latency).count();
+
+  size_t bucket = 0;
+  while (bucket < LATENCY_BUCKET_LIMITS_MS.size() && latencyMs >= LATENCY_BUCKET_LIMITS_MS[bucket])
+    bucket++;
+  m_latencyBuckets[bucket]++;
+
+  m_maxLatency = std::max(m_maxLatency, latency);
+  if (++m_latencyCount % STATS_INTERVAL == 0)
+    LogStats();
+}
+
+void CEventServer::LogStats()
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+
+  if (m_receivedPackets == 0)
+    return;
+
+  std::string histogram;
+  for (size_t i = 0; i < m_latencyBuckets.size(); i++)
+  {
+    if (i < LATENCY_BUCKET_LIMITS_MS.size())
+      histogram += StringUtils::Format(" <{}ms: {}", LATENCY_BUCKET_LIMITS_MS[i], m_latencyBuckets[i]);
+    else
+      histogram += StringUtils::Format(" more: {}", m_latencyBuckets[i]);
+  }
+
+  CLog::Log(LOGDEBUG,
+            "ES: {} packets in {} reads, {} replaced by following ones, {} dispatched with "
+            "latency{}, max {:.1f}ms",
+            m_receivedPackets, m_receiveBatches, m_replacedPackets, m_latencyCount, histogram,
+            std::chrono::duration<double, std::milli>(m_maxLatency).count());
+}
+
 bool CEventServer::ExecuteNextAction()
 {
   std::unique_lock<CCriticalSection> lock(m_critSection);
@@ -294,6 +364,7 @@ bool CEventServer::ExecuteNextAction()
     {
       // Leave critical section before processing action
       lock.unlock();
+      const auto arrivalTime = actionEvent.arrivalTime;
       switch(actionEvent.actionType)
       {
       case AT_EXEC_BUILTIN:
@@ -313,6 +384,7 @@ bool CEventServer::ExecuteNextAction()
         }
         break;
       }
+      AddLatency(arrivalTime);
       return true;
     }
     ++iter;
@@ -326,12 +398,18 @@ unsigned int CEventServer::GetButtonCode(std::string& strMapName, bool& isAxis,
   std::unique_lock<CCriticalSection> lock(m_critSection);
   auto iter = m_clients.begin();
   unsigned int bcode = 0;
+  std::chrono::steady_clock::time_point arrivalTime;
 
   while (iter != m_clients.end())
   {
-    bcode = iter->second->GetButtonCode(strMapName, isAxis, fAmount, isJoystick);
+    bcode = iter->second->GetButtonCode(strMapName, isAxis, fAmount, isJoystick, arrivalTime);
     if (bcode)
+    {
+      // the button is handled by the caller right away
+      if (arrivalTime.time_since_epoch().count() != 0)
+        AddLatency(arrivalTime);
       return bcode;
+    }
     ++iter;
   }
   return bcode;
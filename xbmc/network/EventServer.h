@@ -13,7 +13,9 @@
 #include "threads/CriticalSection.h"
 #include "threads/Thread.h"
 
+#include <array>
 #include <atomic>
+#include <chrono>
 #include <map>
 #include <mutex>
 #include <queue>
@@ -61,9 +63,17 @@ namespace EVENTSERVER
   protected:
     void Cleanup();
     void Run();
-    void ProcessPacket(SOCKETS::CAddress& addr, int packetSize);
+    void ProcessPacket(SOCKETS::CAddress& addr,
+                       const uint8_t* data,
+                       int packetSize,
+                       std::chrono::steady_clock::time_point arrivalTime);
     void ProcessEvents();
     void RefreshClients();
+    void AddLatency(std::chrono::steady_clock::time_point arrivalTime);
+    void LogStats();
+
+    // buckets of the latency histogram, the last one for anything slower
+    static constexpr size_t LATENCY_BUCKETS = 9;
 
     std::map<unsigned long, std::unique_ptr<EVENTCLIENT::CEventClient>> m_clients;
     static std::unique_ptr<CEventServer> m_pInstance;
@@ -72,9 +82,19 @@ namespace EVENTSERVER
     int              m_iListenTimeout;
     int              m_iMaxClients;
     std::vector<uint8_t> m_pPacketBuffer;
+    std::vector<SOCKETS::CAddress> m_packetAddresses;
+    std::vector<int> m_packetSizes;
     std::atomic<bool> m_bRunning = false;
     CCriticalSection m_critSection;
     bool             m_bRefreshSettings;
+
+    // statistics
+    uint64_t m_receivedPackets = 0;
+    uint64_t m_receiveBatches = 0;
+    uint64_t m_replacedPackets = 0;
+    std::array<uint64_t, LATENCY_BUCKETS> m_latencyBuckets{}; // from arrival to dispatch
+    uint64_t m_latencyCount = 0;
+    std::chrono::steady_clock::duration m_maxLatency{};
   };
 
 }
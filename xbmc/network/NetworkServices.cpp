@@ -700,6 +700,8 @@ bool CNetworkServices::StartWebserver()
     password = m_settings->GetString(CSettings::SETTING_SERVICES_WEBSERVERPASSWORD);
   }
 
+  m_webserver.SetWorkerThreads(
+      CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_webserverWorkerThreads);
   if (!m_webserver.Start(webPort, username, password))
     return false;
 
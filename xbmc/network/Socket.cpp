@@ -13,6 +13,7 @@
 #include "utils/ScopeGuard.h"
 #include "utils/log.h"
 
+#include <cerrno>
 #include <vector>
 
 using namespace SOCKETS;
@@ -209,6 +210,55 @@ int CPosixUDPSocket::Read(CAddress& addr, const int buffersize, void *buffer)
                        (struct sockaddr*)&addr.saddr, &addr.size);
 }
 
+int CPosixUDPSocket::ReadMultiple(CAddress* addrs, int* sizes, const int count,
+                                  const int buffersize, uint8_t* buffers)
+{
+#if defined(TARGET_LINUX) || defined(TARGET_ANDROID)
+  // a single call for all datagrams waiting
+  std::vector<mmsghdr> messages(count);
+  std::vector<iovec> vectors(count);
+  for (int i = 0; i < count; i++)
+  {
+    if (m_ipv6Socket)
+      addrs[i].SetAddress("::");
+    vectors[i].iov_base = buffers + i * buffersize;
+    vectors[i].iov_len = buffersize;
+    messages[i].msg_hdr.msg_name = &addrs[i].saddr;
+    messages[i].msg_hdr.msg_namelen = sizeof(addrs[i].saddr);
+    messages[i].msg_hdr.msg_iov = &vectors[i];
+    messages[i].msg_hdr.msg_iovlen = 1;
+  }
+
+  int received = recvmmsg(m_iSock, messages.data(), count, MSG_DONTWAIT, nullptr);
+  if (received < 0)
+    return (errno == EAGAIN || errno == EWOULDBLOCK) ? 0 : -1;
+
+  for (int i = 0; i < received; i++)
+  {
+    addrs[i].size = messages[i].msg_hdr.msg_namelen;
+    sizes[i] = static_cast<int>(messages[i].msg_len);
+  }
+  return received;
+#else
+  int received = 0;
+  while (received < count)
+  {
+    fd_set fdset;
+    FD_ZERO(&fdset);
+    FD_SET(m_iSock, &fdset);
+    struct timeval tv = {};
+    if (select(m_iSock + 1, &fdset, NULL, NULL, &tv) <= 0)
+      break;
+
+    sizes[received] = Read(addrs[received], buffersize, buffers + received * buffersize);
+    if (sizes[received] < 0)
+      return received > 0 ? received : -1;
+    received++;
+  }
+  return received;
+#endif
+}
+
 int CPosixUDPSocket::SendTo(const CAddress& addr, const int buffersize,
                           const void *buffer)
 {
@@ -10,6 +10,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <string.h>
@@ -174,6 +175,12 @@ namespace SOCKETS
 
     // read datagrams, return no. of bytes read or -1 or error
     virtual int Read(CAddress& addr, const int buffersize, void *buffer) = 0;
+
+    // read the datagrams already received without blocking, up to count of
+    // them into consecutive buffers of buffersize bytes, return no. of
+    // datagrams read or -1 on error
+    virtual int ReadMultiple(CAddress* addrs, int* sizes, const int count,
+                             const int buffersize, uint8_t* buffers) = 0;
     virtual bool Broadcast(const CAddress& addr, const int datasize,
                            const void* data) = 0;
   };
@@ -197,6 +204,8 @@ namespace SOCKETS
     bool Listen(int timeout);
     int SendTo(const CAddress& addr, const int datasize, const void* data) override;
     int Read(CAddress& addr, const int buffersize, void *buffer) override;
+    int ReadMultiple(CAddress* addrs, int* sizes, const int count,
+                     const int buffersize, uint8_t* buffers) override;
     bool Broadcast(const CAddress& addr, const int datasize, const void* data) override
     {
       //! @todo implement
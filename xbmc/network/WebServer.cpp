@@ -10,13 +10,16 @@
 
 #include "CompileInfo.h"
 #include "ServiceBroker.h"
+#include "URL.h"
 #include "XBDateTime.h"
 #include "filesystem/File.h"
+#include "filesystem/SpecialProtocol.h"
 #include "network/httprequesthandler/HTTPRequestHandlerUtils.h"
 #include "network/httprequesthandler/IHTTPRequestHandler.h"
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
 #include "utils/FileUtils.h"
+#include "utils/JobManager.h"
 #include "utils/Mime.h"
 #include "utils/StringUtils.h"
 #include "utils/URIUtils.h"
@@ -28,15 +31,22 @@
 #include <mutex>
 #include <stdexcept>
 #include <utility>
+#include <vector>
 
 #if defined(TARGET_POSIX)
+#include <fcntl.h>
 #include <pthread.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #endif
 
 #include <inttypes.h>
 
 #define MAX_POST_BUFFER_SIZE 2048
 
+// size of the buffer filled by the callback of file download responses
+#define FILE_DOWNLOAD_BLOCK_SIZE (64 * 1024)
+
 #define PAGE_FILE_NOT_FOUND \
   "<html><head><title>File not found</title></head><body>File not found</body></html>"
 #define NOT_SUPPORTED \
@@ -47,17 +57,20 @@
 
 #define HEADER_NEWLINE "\r\n"
 
+typedef struct
+{
+  bool fromFile; // otherwise from data
+  std::string data; // multipart boundary
+  uint64_t filePosition;
+  uint64_t length;
+} HttpFileDownloadSegment;
+
 typedef struct
 {
   std::shared_ptr<XFILE::CFile> file;
-  CHttpRanges ranges;
-  size_t rangeCountTotal;
-  std::string boundary;
-  std::string boundaryWithHeader;
-  std::string boundaryEnd;
-  bool boundaryWritten;
-  std::string contentType;
-  uint64_t writePosition;
+  std::vector<HttpFileDownloadSegment> segments; // the response body
+  size_t segment; // segment at the last read position
+  uint64_t segmentPosition; // position of that segment in the response body
 } HttpFileDownloadContext;
 
 CWebServer::CWebServer()
@@ -256,12 +269,19 @@ MHD_RESULT CWebServer::HandlePartialRequest(struct MHD_Connection* connection,
         return MHD_YES;
       }
 
-      return HandleRequest(handler);
+      return HandleRequest(conHandler, handler, con_cls);
     }
   }
   // this is a subsequent call to AnswerToConnection for this request
   else
   {
+    // the request has been handled on a job thread and the connection has been resumed
+    if (conHandler->isSuspended)
+    {
+      conHandler->isSuspended = false;
+      return CreateResponse(conHandler->requestHandler, conHandler->handlerResult);
+    }
+
     // again we need to take special care of the POST data
     if (request.method == POST)
     {
@@ -283,7 +303,7 @@ MHD_RESULT CWebServer::HandlePartialRequest(struct MHD_Connection* connection,
         return SendErrorResponse(request, conHandler->errorStatus, request.method);
 
       // we have handled all POST data so it's time to invoke the IHTTPRequestHandler
-      return HandleRequest(conHandler->requestHandler);
+      return HandleRequest(conHandler, conHandler->requestHandler, con_cls);
     }
 
     // it's unusual to get more than one call to AnswerToConnection for none-POST requests, but
@@ -325,8 +345,70 @@ MHD_RESULT CWebServer::HandleRequest(const std::shared_ptr<IHTTPRequestHandler>&
   if (handler == nullptr)
     return MHD_NO;
 
+  return CreateResponse(handler, handler->HandleRequest());
+}
+
+MHD_RESULT CWebServer::HandleRequest(std::unique_ptr<ConnectionHandler>& connectionHandler,
+                                     const std::shared_ptr<IHTTPRequestHandler>& handler,
+                                     void** con_cls)
+{
+  // with one thread per connection there is no one else to block
+  if (m_workerThreads == 0 || handler == nullptr || !handler->IsLongRunning())
+    return HandleRequest(handler);
+
+  bool stopping;
+  {
+    std::unique_lock<CCriticalSection> lock(m_suspendedSection);
+    stopping = m_stopping;
+    if (!stopping && m_suspendedRequests++ == 0)
+      m_suspendedRequestsDone.Reset();
+  }
+
+  // no connections must be suspended anymore once the server is stopping
+  if (stopping)
+    return HandleRequest(handler);
+
+  // suspend the connection while the request is handled on a job thread. Once it is resumed
+  // libmicrohttpd calls AnswerToConnection again and we pick up the result from there. Until
+  // then the connection handler is owned by libmicrohttpd which frees it in RequestCompleted
+  // if the connection is closed.
+  struct MHD_Connection* connection = handler->GetRequest().connection;
+  connectionHandler->requestHandler = handler;
+  connectionHandler->isSuspended = true;
+  ConnectionHandler* conHandler = connectionHandler.release();
+  *con_cls = conHandler;
+
+  MHD_suspend_connection(connection);
+  CServiceBroker::GetJobManager()->Submit(
+      [this, conHandler, connection]()
+      {
+        bool stopping;
+        {
+          std::unique_lock<CCriticalSection> lock(m_suspendedSection);
+          stopping = m_stopping;
+        }
+
+        // don't start handling requests which are only going to be dropped
+        if (!stopping)
+          conHandler->handlerResult = conHandler->requestHandler->HandleRequest();
+
+        // the daemon isn't stopped before all suspended connections have been resumed
+        MHD_resume_connection(connection);
+
+        std::unique_lock<CCriticalSection> lock(m_suspendedSection);
+        if (--m_suspendedRequests == 0)
+          m_suspendedRequestsDone.Set();
+      },
+      CJob::PRIORITY_NORMAL);
+
+  return MHD_YES;
+}
+
+MHD_RESULT CWebServer::CreateResponse(const std::shared_ptr<IHTTPRequestHandler>& handler,
+                                      MHD_RESULT handled)
+{
   HTTPRequest request = handler->GetRequest();
-  MHD_RESULT ret = handler->HandleRequest();
+  MHD_RESULT ret = handled;
   if (ret == MHD_NO)
   {
     m_logger->error("failed to handle HTTP request for {}", request.pathUrl);
@@ -816,26 +898,20 @@ MHD_RESULT CWebServer::CreateFileDownloadResponse(
     mimeType = CreateMimeTypeFromExtension(ext.c_str());
   }
 
-  uint64_t totalLength = 0;
-  std::unique_ptr<HttpFileDownloadContext> context = std::make_unique<HttpFileDownloadContext>();
-  context->file = file;
-  context->contentType = mimeType;
-  context->boundaryWritten = false;
-  context->writePosition = 0;
-
+  CHttpRanges ranges;
   if (handler->IsRequestRanged())
   {
     if (!request.ranges.IsEmpty())
-      context->ranges = request.ranges;
+      ranges = request.ranges;
     else
-      HTTPRequestHandlerUtils::GetRequestedRanges(request.connection, fileLength, context->ranges);
+      HTTPRequestHandlerUtils::GetRequestedRanges(request.connection, fileLength, ranges);
   }
 
   uint64_t firstPosition = 0;
   uint64_t lastPosition = 0;
   // if there are no ranges, add the whole range
-  if (context->ranges.IsEmpty())
-    context->ranges.Add(CHttpRange(0, fileLength - 1));
+  if (ranges.IsEmpty())
+    ranges.Add(CHttpRange(0, fileLength - 1));
   else
   {
     handler->SetResponseStatus(MHD_HTTP_PARTIAL_CONTENT);
@@ -844,61 +920,82 @@ MHD_RESULT CWebServer::CreateFileDownloadResponse(
     // reliable anymore for length comparisons
     ranged = true;
 
-    context->ranges.GetFirstPosition(firstPosition);
-    context->ranges.GetLastPosition(lastPosition);
+    ranges.GetFirstPosition(firstPosition);
+    ranges.GetLastPosition(lastPosition);
   }
 
-  // remember the total number of ranges
-  context->rangeCountTotal = context->ranges.Size();
-  // remember the total length
-  totalLength = context->ranges.GetLength();
+  // split the response body into the ranges of the file and, in case of multiple ranges which
+  // require multipart boundaries, the boundaries between them
+  std::unique_ptr<HttpFileDownloadContext> context = std::make_unique<HttpFileDownloadContext>();
+  context->file = file;
+  context->segment = 0;
+  context->segmentPosition = 0;
 
-  // adjust the MIME type and range length in case of multiple ranges which requires multipart
-  // boundaries
-  if (context->rangeCountTotal > 1)
+  if (ranges.Size() > 1)
   {
-    context->boundary = HttpRangeUtils::GenerateMultipartBoundary();
-    mimeType = HttpRangeUtils::GenerateMultipartBoundaryContentType(context->boundary);
-
-    // build part of the boundary with the optional Content-Type header
+    const std::string boundary = HttpRangeUtils::GenerateMultipartBoundary();
     // "--<boundary>\r\nContent-Type: <content-type>\r\n
-    context->boundaryWithHeader = HttpRangeUtils::GenerateMultipartBoundaryWithHeader(
-        context->boundary, context->contentType);
-    context->boundaryEnd = HttpRangeUtils::GenerateMultipartBoundaryEnd(context->boundary);
+    const std::string boundaryWithHeader =
+        HttpRangeUtils::GenerateMultipartBoundaryWithHeader(boundary, mimeType);
+    mimeType = HttpRangeUtils::GenerateMultipartBoundaryContentType(boundary);
 
-    // for every range, we need to add a boundary with header
-    for (HttpRanges::const_iterator range = context->ranges.Begin(); range != context->ranges.End();
-         ++range)
+    for (HttpRanges::const_iterator range = ranges.Begin(); range != ranges.End(); ++range)
     {
-      // we need to temporarily add the Content-Range header to the boundary to be able to
-      // determine the length
-      std::string completeBoundaryWithHeader =
-          HttpRangeUtils::GenerateMultipartBoundaryWithHeader(context->boundaryWithHeader, &*range);
-      totalLength += completeBoundaryWithHeader.size();
-
       // add a newline before any new multipart boundary
-      if (range != context->ranges.Begin())
-        totalLength += strlen(HEADER_NEWLINE);
+      std::string rangeBoundary = range != ranges.Begin() ? HEADER_NEWLINE : "";
+      rangeBoundary +=
+          HttpRangeUtils::GenerateMultipartBoundaryWithHeader(boundaryWithHeader, &*range);
+
+      const uint64_t boundaryLength = rangeBoundary.size();
+      context->segments.push_back({false, std::move(rangeBoundary), 0, boundaryLength});
+      context->segments.push_back({true, "", range->GetFirstPosition(), range->GetLength()});
     }
+
     // and at the very end a special end-boundary "\r\n--<boundary>--"
-    totalLength += context->boundaryEnd.size();
+    std::string boundaryEnd = HttpRangeUtils::GenerateMultipartBoundaryEnd(boundary);
+    const uint64_t boundaryEndLength = boundaryEnd.size();
+    context->segments.push_back({false, std::move(boundaryEnd), 0, boundaryEndLength});
+  }
+  else
+  {
+    CHttpRange range;
+    ranges.GetFirst(range);
+    context->segments.push_back({true, "", range.GetFirstPosition(), range.GetLength()});
   }
 
-  // set the initial write position
-  context->ranges.GetFirstPosition(context->writePosition);
+  uint64_t totalLength = 0;
+  for (const auto& segment : context->segments)
+    totalLength += segment.length;
 
   // create the response object
-  response =
-      MHD_create_response_from_callback(totalLength, 2048, &CWebServer::ContentReaderCallback,
-                                        context.get(), &CWebServer::ContentReaderFreeCallback);
-  if (response == nullptr)
+#if defined(TARGET_POSIX)
+  // a single range of a local file is sent straight from the file descriptor which lets
+  // libmicrohttpd use sendfile() without copying the data
+  int fd = context->segments.size() == 1 ? OpenLocalFile(filePath, fileLength) : -1;
+  if (fd >= 0)
   {
-    m_logger->error("failed to create a HTTP response for {} to be filled from{}", request.pathUrl,
-                    filePath);
-    return MHD_NO;
+    response = MHD_create_response_from_fd_at_offset64(totalLength, fd,
+                                                       context->segments.front().filePosition);
+    if (response == nullptr)
+      close(fd);
   }
+#endif
 
-  context.release(); // ownership was passed to mhd
+  // otherwise the response is filled from the file opened through the VFS
+  if (response == nullptr)
+  {
+    response = MHD_create_response_from_callback(totalLength, FILE_DOWNLOAD_BLOCK_SIZE,
+                                                 &CWebServer::ContentReaderCallback, context.get(),
+                                                 &CWebServer::ContentReaderFreeCallback);
+    if (response == nullptr)
+    {
+      m_logger->error("failed to create a HTTP response for {} to be filled from{}",
+                      request.pathUrl, filePath);
+      return MHD_NO;
+    }
+
+    context.release(); // ownership was passed to mhd
+  }
 
   // add Content-Range header
   if (ranged)
@@ -913,6 +1010,32 @@ MHD_RESULT CWebServer::CreateFileDownloadResponse(
   return MHD_YES;
 }
 
+int CWebServer::OpenLocalFile(const std::string& filePath, uint64_t fileLength) const
+{
+#if defined(TARGET_POSIX)
+  const std::string localPath = CSpecialProtocol::TranslatePath(filePath);
+  if (!CURL(localPath).GetProtocol().empty())
+    return -1;
+
+  int fd = open(localPath.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0)
+    return -1;
+
+  // the response length was taken from the file opened through the VFS
+  struct stat buffer;
+  if (fstat(fd, &buffer) != 0 || !S_ISREG(buffer.st_mode) ||
+      static_cast<uint64_t>(buffer.st_size) != fileLength)
+  {
+    close(fd);
+    return -1;
+  }
+
+  return fd;
+#else
+  return -1;
+#endif
+}
+
 MHD_RESULT CWebServer::CreateErrorResponse(struct MHD_Connection* connection,
                                            int responseType,
                                            HTTPMethod method,
@@ -986,6 +1109,24 @@ MHD_RESULT CWebServer::SendErrorResponse(const HTTPRequest& request,
   return SendResponse(request, errorType, response);
 }
 
+void CWebServer::RequestCompleted(void* cls,
+                                  struct MHD_Connection* connection,
+                                  void** con_cls,
+                                  enum MHD_RequestTerminationCode toe)
+{
+  if (con_cls == nullptr || *con_cls == nullptr)
+    return;
+
+  // the connection was closed before the request has been handled completely, e.g. while it was
+  // suspended or receiving POST data
+  ConnectionHandler* connectionHandler = reinterpret_cast<ConnectionHandler*>(*con_cls);
+  if (connectionHandler->postprocessor != nullptr)
+    MHD_destroy_post_processor(connectionHandler->postprocessor);
+
+  delete connectionHandler;
+  *con_cls = nullptr;
+}
+
 void* CWebServer::UriRequestLogger(void* cls, const char* uri)
 {
   CWebServer* webServer = reinterpret_cast<CWebServer*>(cls);
@@ -1015,93 +1156,63 @@ ssize_t CWebServer::ContentReaderCallback(void* cls, uint64_t pos, char* buf, si
     return -1;
 
   if (CServiceBroker::GetLogging().CanLogComponent(LOGWEBSERVER))
-    GetLogger()->debug("[OUT] write maximum {} bytes from {} ({})", max, context->writePosition,
-                       pos);
+    GetLogger()->debug("[OUT] write maximum {} bytes from {}", max, pos);
 
-  // check if we need to add the end-boundary
-  if (context->rangeCountTotal > 1 && context->ranges.IsEmpty())
+  // find the segment containing the position, usually the one of the last read
+  if (pos < context->segmentPosition)
   {
-    // put together the end-boundary
-    std::string endBoundary = HttpRangeUtils::GenerateMultipartBoundaryEnd(context->boundary);
-    if ((unsigned int)max != endBoundary.size())
-      return -1;
-
-    // copy the boundary into the buffer
-    memcpy(buf, endBoundary.c_str(), endBoundary.size());
-    return endBoundary.size();
+    context->segment = 0;
+    context->segmentPosition = 0;
+  }
+  while (context->segment < context->segments.size() &&
+         pos >= context->segmentPosition + context->segments[context->segment].length)
+  {
+    context->segmentPosition += context->segments[context->segment].length;
+    context->segment++;
   }
 
-  CHttpRange range;
-  if (context->ranges.IsEmpty() || !context->ranges.GetFirst(range))
-    return -1;
-
-  uint64_t start = range.GetFirstPosition();
-  uint64_t end = range.GetLastPosition();
-  uint64_t maximum = (uint64_t)max;
-  int written = 0;
-
-  if (context->rangeCountTotal > 1 && !context->boundaryWritten)
+  // fill the buffer from as many segments as fit
+  size_t written = 0;
+  while (written < max && context->segment < context->segments.size())
   {
-    // add a newline before any new multipart boundary
-    if (context->rangeCountTotal > context->ranges.Size())
+    const HttpFileDownloadSegment& segment = context->segments[context->segment];
+    const uint64_t offset = pos + written - context->segmentPosition;
+    size_t count = static_cast<size_t>(std::min<uint64_t>(max - written, segment.length - offset));
+
+    if (segment.fromFile)
     {
-      size_t newlineLength = strlen(HEADER_NEWLINE);
-      memcpy(buf, HEADER_NEWLINE, newlineLength);
-      buf += newlineLength;
-      written += newlineLength;
-      maximum -= newlineLength;
-    }
+      const uint64_t position = segment.filePosition + offset;
 
-    // put together the boundary for the current range
-    std::string boundary =
-        HttpRangeUtils::GenerateMultipartBoundaryWithHeader(context->boundaryWithHeader, &range);
-
-    // copy the boundary into the buffer
-    memcpy(buf, boundary.c_str(), boundary.size());
-    // advance the buffer position
-    buf += boundary.size();
-    // update the number of written byte
-    written += boundary.size();
-    // update the maximum number of bytes
-    maximum -= boundary.size();
-    context->boundaryWritten = true;
-  }
+      // seek to the position if necessary
+      if (context->file->GetPosition() < 0 ||
+          position != static_cast<uint64_t>(context->file->GetPosition()))
+        context->file->Seek(position);
 
-  // check if the current position is within this range
-  // if not, set it to the start position
-  if (context->writePosition < start || context->writePosition > end)
-    context->writePosition = start;
-  // adjust the maximum number of read bytes
-  maximum = std::min(maximum, end - context->writePosition + 1);
-
-  // seek to the position if necessary
-  if (context->file->GetPosition() < 0 ||
-      context->writePosition != static_cast<uint64_t>(context->file->GetPosition()))
-    context->file->Seek(context->writePosition);
-
-  // read data from the file
-  ssize_t res = context->file->Read(buf, static_cast<size_t>(maximum));
-  if (res <= 0)
-    return -1;
+      ssize_t res = context->file->Read(buf + written, count);
+      if (res <= 0)
+        return written > 0 ? static_cast<ssize_t>(written) : -1;
 
-  // add the number of read bytes to the number of written bytes
-  written += res;
+      if (CServiceBroker::GetLogging().CanLogComponent(LOGWEBSERVER))
+        GetLogger()->debug("[OUT] wrote {} bytes from {} in range ({} - {})", res, position,
+                           segment.filePosition, segment.filePosition + segment.length - 1);
 
-  if (CServiceBroker::GetLogging().CanLogComponent(LOGWEBSERVER))
-    GetLogger()->debug("[OUT] wrote {} bytes from {} in range ({} - {})", written,
-                       context->writePosition, start, end);
+      count = static_cast<size_t>(res);
+    }
+    else
+      memcpy(buf + written, segment.data.c_str() + offset, count);
 
-  // update the current write position
-  context->writePosition += res;
+    written += count;
 
-  // if we have read all the data from the current range
-  // remove it from the list
-  if (context->writePosition >= end + 1)
-  {
-    context->ranges.Remove(0);
-    context->boundaryWritten = false;
+    if (offset + count < segment.length)
+      break; // a short read from the file
+
+    context->segmentPosition += segment.length;
+    context->segment++;
   }
 
+  if (written == 0)
+    return -1;
+
   return written;
 }
 
@@ -1196,50 +1307,59 @@ struct MHD_Daemon* CWebServer::StartMHD(unsigned int flags, int port)
 
   MHD_set_panic_func(&panicHandlerForMHD, nullptr);
 
+  unsigned int threadingFlags;
+  if (m_workerThreads > 0)
+  {
+    // a pool of worker threads polling all connections, suspending the connections of long
+    // running requests while they are handled on job threads
+    threadingFlags = MHD_USE_INTERNAL_POLLING_THREAD | MHD_USE_SUSPEND_RESUME
+#if (MHD_VERSION >= 0x00095300)
+                     | MHD_USE_AUTO /* epoll on Linux, poll or select elsewhere */
+#endif
+        ;
+  }
+  else
+  {
+    // one thread per connection
+    // WARNING: set MHD_OPTION_CONNECTION_TIMEOUT to something higher than 1
+    // otherwise on libmicrohttpd 0.4.4-1 it spins a busy loop
+    threadingFlags = MHD_USE_THREAD_PER_CONNECTION
+#if (MHD_VERSION >= 0x00095207)
+                     | MHD_USE_INTERNAL_POLLING_THREAD /* MHD_USE_THREAD_PER_CONNECTION must be used
+                                                          only with MHD_USE_INTERNAL_POLLING_THREAD
+                                                          since 0.9.54 */
+#endif
+        ;
+  }
+
   if (CServiceBroker::GetSettingsComponent()->GetSettings()->GetBool(
           CSettings::SETTING_SERVICES_WEBSERVERSSL) &&
       MHD_is_feature_supported(MHD_FEATURE_SSL) == MHD_YES && LoadCert(m_key, m_cert))
     // SSL enabled
     return MHD_start_daemon(
-        flags |
-            // one thread per connection
-            // WARNING: set MHD_OPTION_CONNECTION_TIMEOUT to something higher than 1
-            // otherwise on libmicrohttpd 0.4.4-1 it spins a busy loop
-            MHD_USE_THREAD_PER_CONNECTION
-#if (MHD_VERSION >= 0x00095207)
-            |
-            MHD_USE_INTERNAL_POLLING_THREAD /* MHD_USE_THREAD_PER_CONNECTION must be used only with
-                                               MHD_USE_INTERNAL_POLLING_THREAD since 0.9.54 */
-#endif
-            | MHD_USE_DEBUG /* Print MHD error messages to log */
+        flags | threadingFlags | MHD_USE_DEBUG /* Print MHD error messages to log */
             | MHD_USE_SSL,
         port, 0, 0, &CWebServer::AnswerToConnection, this,
 
         MHD_OPTION_EXTERNAL_LOGGER, &logFromMHD, 0, MHD_OPTION_CONNECTION_LIMIT, 512,
         MHD_OPTION_CONNECTION_TIMEOUT, timeout, MHD_OPTION_URI_LOG_CALLBACK,
-        &CWebServer::UriRequestLogger, this, MHD_OPTION_THREAD_STACK_SIZE, m_thread_stacksize,
-        MHD_OPTION_HTTPS_MEM_KEY, m_key.c_str(), MHD_OPTION_HTTPS_MEM_CERT, m_cert.c_str(),
-        MHD_OPTION_HTTPS_PRIORITIES, ciphers, MHD_OPTION_END);
+        &CWebServer::UriRequestLogger, this, MHD_OPTION_NOTIFY_COMPLETED,
+        &CWebServer::RequestCompleted, this, MHD_OPTION_THREAD_STACK_SIZE, m_thread_stacksize,
+        MHD_OPTION_THREAD_POOL_SIZE, m_workerThreads, MHD_OPTION_HTTPS_MEM_KEY, m_key.c_str(),
+        MHD_OPTION_HTTPS_MEM_CERT, m_cert.c_str(), MHD_OPTION_HTTPS_PRIORITIES, ciphers,
+        MHD_OPTION_END);
 
   // No SSL
   return MHD_start_daemon(
-      flags |
-          // one thread per connection
-          // WARNING: set MHD_OPTION_CONNECTION_TIMEOUT to something higher than 1
-          // otherwise on libmicrohttpd 0.4.4-1 it spins a busy loop
-          MHD_USE_THREAD_PER_CONNECTION
-#if (MHD_VERSION >= 0x00095207)
-          | MHD_USE_INTERNAL_POLLING_THREAD /* MHD_USE_THREAD_PER_CONNECTION must be used only with
-                                               MHD_USE_INTERNAL_POLLING_THREAD since 0.9.54 */
-#endif
-          | MHD_USE_DEBUG /* Print MHD error messages to log */
+      flags | threadingFlags | MHD_USE_DEBUG /* Print MHD error messages to log */
       ,
       port, 0, 0, &CWebServer::AnswerToConnection, this,
 
       MHD_OPTION_EXTERNAL_LOGGER, &logFromMHD, 0, MHD_OPTION_CONNECTION_LIMIT, 512,
       MHD_OPTION_CONNECTION_TIMEOUT, timeout, MHD_OPTION_URI_LOG_CALLBACK,
-      &CWebServer::UriRequestLogger, this, MHD_OPTION_THREAD_STACK_SIZE, m_thread_stacksize,
-      MHD_OPTION_END);
+      &CWebServer::UriRequestLogger, this, MHD_OPTION_NOTIFY_COMPLETED,
+      &CWebServer::RequestCompleted, this, MHD_OPTION_THREAD_STACK_SIZE, m_thread_stacksize,
+      MHD_OPTION_THREAD_POOL_SIZE, m_workerThreads, MHD_OPTION_END);
 }
 
 bool CWebServer::Start(uint16_t port, const std::string& username, const std::string& password)
@@ -1250,6 +1370,11 @@ bool CWebServer::Start(uint16_t port, const std::string& username, const std::st
     // use a new logger containing the port in the name
     m_logger = CServiceBroker::GetLogging().GetLogger(StringUtils::Format("CWebserver[{}]", port));
 
+    {
+      std::unique_lock<CCriticalSection> lock(m_suspendedSection);
+      m_stopping = false;
+    }
+
     int v6testSock;
     if ((v6testSock = socket(AF_INET6, SOCK_STREAM, 0)) >= 0)
     {
@@ -1262,7 +1387,10 @@ bool CWebServer::Start(uint16_t port, const std::string& username, const std::st
     if (m_running)
     {
       m_port = port;
-      m_logger->info("Started");
+      if (m_workerThreads > 0)
+        m_logger->info("Started with {} worker threads", m_workerThreads);
+      else
+        m_logger->info("Started");
     }
     else
       m_logger->error("Failed to start");
@@ -1276,11 +1404,21 @@ bool CWebServer::Stop()
   if (!m_running)
     return true;
 
+  // the jobs handling the requests of suspended connections must have resumed them before the
+  // daemons are stopped
+  {
+    std::unique_lock<CCriticalSection> lock(m_suspendedSection);
+    m_stopping = true;
+  }
+  m_suspendedRequestsDone.Wait();
+
   if (m_daemon_ip6 != nullptr)
     MHD_stop_daemon(m_daemon_ip6);
+  m_daemon_ip6 = nullptr;
 
   if (m_daemon_ip4 != nullptr)
     MHD_stop_daemon(m_daemon_ip4);
+  m_daemon_ip4 = nullptr;
 
   m_running = false;
   m_logger->info("Stopped");
@@ -10,6 +10,7 @@
 
 #include "network/httprequesthandler/IHTTPRequestHandler.h"
 #include "threads/CriticalSection.h"
+#include "threads/Event.h"
 #include "utils/logtypes.h"
 
 #include <memory>
@@ -29,6 +30,14 @@ public:
   virtual ~CWebServer() = default;
 
   bool Start(uint16_t port, const std::string &username, const std::string &password);
+  /*!
+   \brief Sets the number of worker threads serving the connections.
+
+   With 0 (the default) every connection is served by its own thread. Otherwise the given
+   number of threads poll all connections (using epoll where available) and long running
+   requests are handled on job threads. Takes effect the next time the server is started.
+   */
+  void SetWorkerThreads(unsigned int workerThreads) { m_workerThreads = workerThreads; }
   bool Stop();
   bool IsStarted();
   static bool WebServerSupportsSSL();
@@ -45,6 +54,8 @@ protected:
     std::shared_ptr<IHTTPRequestHandler> requestHandler;
     struct MHD_PostProcessor *postprocessor;
     int errorStatus;
+    bool isSuspended; // the request handler is running on a job thread
+    MHD_RESULT handlerResult;
 
     explicit ConnectionHandler(const std::string& uri)
       : fullUri(uri)
@@ -52,6 +63,8 @@ protected:
       , requestHandler(nullptr)
       , postprocessor(nullptr)
       , errorStatus(MHD_HTTP_OK)
+      , isSuspended(false)
+      , handlerResult(MHD_NO)
     { }
   } ConnectionHandler;
 
@@ -60,6 +73,10 @@ protected:
   virtual MHD_RESULT HandlePartialRequest(struct MHD_Connection *connection, ConnectionHandler* connectionHandler, const HTTPRequest& request,
                                    const char *upload_data, size_t *upload_data_size, void **con_cls);
   virtual MHD_RESULT HandleRequest(const std::shared_ptr<IHTTPRequestHandler>& handler);
+  MHD_RESULT HandleRequest(std::unique_ptr<ConnectionHandler>& connectionHandler,
+                           const std::shared_ptr<IHTTPRequestHandler>& handler,
+                           void** con_cls);
+  MHD_RESULT CreateResponse(const std::shared_ptr<IHTTPRequestHandler>& handler, MHD_RESULT handled);
   virtual MHD_RESULT FinalizeRequest(const std::shared_ptr<IHTTPRequestHandler>& handler, int responseStatus, struct MHD_Response *response);
 
 private:
@@ -83,6 +100,12 @@ private:
   MHD_RESULT CreateRedirect(struct MHD_Connection *connection, const std::string &strURL, struct MHD_Response *&response) const;
   MHD_RESULT CreateFileDownloadResponse(const std::shared_ptr<IHTTPRequestHandler>& handler, struct MHD_Response *&response) const;
   MHD_RESULT CreateErrorResponse(struct MHD_Connection *connection, int responseType, HTTPMethod method, struct MHD_Response *&response) const;
+  /*!
+   * \brief Opens a file in the local filesystem for sending it with sendfile()
+   *
+   * \return The file descriptor or -1 if the file isn't local
+   */
+  int OpenLocalFile(const std::string& filePath, uint64_t fileLength) const;
   MHD_RESULT CreateMemoryDownloadResponse(struct MHD_Connection *connection, const void *data, size_t size, bool free, bool copy, struct MHD_Response *&response) const;
 
   MHD_RESULT SendResponse(const HTTPRequest& request, int responseStatus, MHD_Response *response) const;
@@ -97,6 +120,10 @@ private:
 
   // MHD callback implementations
   static void* UriRequestLogger(void *cls, const char *uri);
+  static void RequestCompleted(void* cls,
+                               struct MHD_Connection* connection,
+                               void** con_cls,
+                               enum MHD_RequestTerminationCode toe);
 
   static ssize_t ContentReaderCallback (void *cls, uint64_t pos, char *buf, size_t max);
   static void ContentReaderFreeCallback(void *cls);
@@ -119,12 +146,19 @@ private:
   struct MHD_Daemon *m_daemon_ip4 = nullptr;
   bool m_running = false;
   size_t m_thread_stacksize = 0;
+  unsigned int m_workerThreads = 0;
   bool m_authenticationRequired = false;
   std::string m_authenticationUsername;
   std::string m_authenticationPassword;
   std::string m_key;
   std::string m_cert;
   mutable CCriticalSection m_critSection;
+
+  // connections suspended while their requests are handled on job threads
+  CCriticalSection m_suspendedSection;
+  unsigned int m_suspendedRequests = 0;
+  CEvent m_suspendedRequestsDone{true, true};
+  bool m_stopping = false;
   std::vector<IHTTPRequestHandler *> m_requestHandlers;
 
   Logger m_logger;
@@ -8,8 +8,11 @@
 
 #include "HTTPImageTransformationHandler.h"
 
+#include "ServiceBroker.h"
+#include "TextureCache.h"
 #include "TextureCacheJob.h"
 #include "URL.h"
+#include "filesystem/File.h"
 #include "filesystem/ImageFile.h"
 #include "network/WebServer.h"
 #include "network/httprequesthandler/HTTPRequestHandlerUtils.h"
@@ -87,7 +90,7 @@ CHTTPImageTransformationHandler::CHTTPImageTransformationHandler(const HTTPReque
 CHTTPImageTransformationHandler::~CHTTPImageTransformationHandler()
 {
   m_responseData.clear();
-  delete m_buffer;
+  delete[] m_buffer;
   m_buffer = NULL;
 }
 
@@ -134,9 +137,28 @@ MHD_RESULT CHTTPImageTransformationHandler::HandleRequest()
     imagePath += StringUtils::Join(urlOptions, "&");
   }
 
-  // resize the image into the local buffer
-  size_t bufferSize;
-  if (!CTextureCacheJob::ResizeTexture(imagePath, m_buffer, bufferSize))
+  // get the resized image from the texture cache, or resize it into the local buffer if it can't
+  // be cached
+  std::string ext = URIUtils::GetExtension(CURL(m_url).GetHostName());
+  StringUtils::ToLower(ext);
+  if (!ext.empty() && ext[0] == '.')
+    ext.erase(0, 1);
+
+  const uint8_t* data = nullptr;
+  size_t bufferSize = 0;
+  std::string cachedImage;
+  const std::shared_ptr<CTextureCache> textureCache = CServiceBroker::GetTextureCache();
+  if (textureCache)
+    cachedImage = textureCache->CacheResizedImage(imagePath, ext);
+
+  if (!cachedImage.empty() && XFILE::CFile().LoadFile(cachedImage, m_cachedImage) > 0)
+  {
+    data = m_cachedImage.data();
+    bufferSize = m_cachedImage.size();
+  }
+  else if (CTextureCacheJob::ResizeTexture(imagePath, m_buffer, bufferSize))
+    data = m_buffer;
+  else
   {
     m_response.status = MHD_HTTP_INTERNAL_SERVER_ERROR;
     m_response.type = HTTPError;
@@ -150,12 +172,12 @@ MHD_RESULT CHTTPImageTransformationHandler::HandleRequest()
   // nothing else to do if the request is not ranged
   if (!GetRequestedRanges(m_response.totalLength))
   {
-    m_responseData.push_back(CHttpResponseRange(m_buffer, 0, m_response.totalLength - 1));
+    m_responseData.push_back(CHttpResponseRange(data, 0, m_response.totalLength - 1));
     return MHD_YES;
   }
 
   for (HttpRanges::const_iterator range = m_request.ranges.Begin(); range != m_request.ranges.End(); ++range)
-    m_responseData.push_back(CHttpResponseRange(m_buffer + range->GetFirstPosition(), range->GetFirstPosition(), range->GetLastPosition()));
+    m_responseData.push_back(CHttpResponseRange(data + range->GetFirstPosition(), range->GetFirstPosition(), range->GetLastPosition()));
 
   return MHD_YES;
 }
@@ -13,6 +13,7 @@
 
 #include <stdint.h>
 #include <string>
+#include <vector>
 
 class CHTTPImageTransformationHandler : public IHTTPRequestHandler
 {
@@ -24,6 +25,7 @@ public:
   bool CanHandleRequest(const HTTPRequest &request)const  override;
 
   MHD_RESULT HandleRequest() override;
+  bool IsLongRunning() const override { return true; }
 
   bool CanHandleRanges() const override { return true; }
   bool CanBeCached() const override { return true; }
@@ -42,5 +44,6 @@ private:
   CDateTime m_lastModified;
 
   uint8_t* m_buffer;
+  std::vector<uint8_t> m_cachedImage;
   HttpResponseRanges m_responseData;
 };
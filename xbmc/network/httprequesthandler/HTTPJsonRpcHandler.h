@@ -25,6 +25,7 @@ public:
   bool CanHandleRequest(const HTTPRequest &request) const override;
 
   MHD_RESULT HandleRequest() override;
+  bool IsLongRunning() const override { return true; }
 
   HttpResponseRanges GetResponseData() const override;
 
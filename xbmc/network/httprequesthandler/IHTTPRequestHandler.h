@@ -122,6 +122,15 @@ public:
    */
   virtual MHD_RESULT HandleRequest() = 0;
 
+  /*!
+   * \brief Whether handling the request may take a long time.
+   *
+   * \details When the web server serves connections from a pool of worker
+   * threads, such requests are handled on a job thread while their connection
+   * is suspended so they don't hold up the other connections of the worker.
+   */
+  virtual bool IsLongRunning() const { return false; }
+
   /*!
    * \brief Whether the HTTP response could also be provided in ranges.
    */
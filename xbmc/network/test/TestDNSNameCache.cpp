@@ -0,0 +1,208 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "ServiceBroker.h"
+#include "network/DNSNameCache.h"
+#include "test/MtTestUtils.h"
+#include "threads/Event.h"
+#include "utils/JobManager.h"
+
+#include <atomic>
+#include <chrono>
+#include <string>
+
+#include <gtest/gtest.h>
+
+using namespace std::chrono_literals;
+
+class TestDNSNameCache : public testing::Test
+{
+protected:
+  TestDNSNameCache()
+  {
+    CServiceBroker::RegisterJobManager(std::make_shared<CJobManager>());
+
+    CDNSNameCache::Clear();
+    CDNSNameCache::SetResolver(
+        [this](const std::string& strHostName, std::string& strIpAddress, std::chrono::seconds& ttl)
+        {
+          m_resolutions++;
+          if (strHostName == "media.local")
+          {
+            strIpAddress = "192.168.1.10";
+            ttl = 3600s;
+            return true;
+          }
+          if (strHostName == "expired.local")
+          {
+            strIpAddress = "192.168.1.11";
+            ttl = 0s;
+            return true;
+          }
+          if (strHostName == "expiredmissing.local")
+            ttl = 0s;
+          return false;
+        });
+  }
+
+  ~TestDNSNameCache() override
+  {
+    CServiceBroker::GetJobManager()->CancelJobs();
+    CServiceBroker::UnregisterJobManager();
+
+    CDNSNameCache::SetResolver(nullptr);
+    CDNSNameCache::SetDiscoveryLookup(nullptr);
+    CDNSNameCache::Clear();
+  }
+
+  std::atomic<int> m_resolutions{0};
+};
+
+TEST_F(TestDNSNameCache, IpAddress)
+{
+  std::string ip;
+  EXPECT_TRUE(CDNSNameCache::Lookup("10.0.0.1", ip));
+  EXPECT_EQ("10.0.0.1", ip);
+  EXPECT_EQ(0, m_resolutions);
+}
+
+TEST_F(TestDNSNameCache, CachesAddress)
+{
+  std::string ip;
+  EXPECT_FALSE(CDNSNameCache::GetCached("media.local", ip));
+
+  EXPECT_TRUE(CDNSNameCache::Lookup("media.local", ip));
+  EXPECT_EQ("192.168.1.10", ip);
+  EXPECT_TRUE(CDNSNameCache::Lookup("media.local", ip));
+  EXPECT_EQ("192.168.1.10", ip);
+  EXPECT_EQ(1, m_resolutions);
+
+  ip.clear();
+  EXPECT_TRUE(CDNSNameCache::GetCached("media.local", ip));
+  EXPECT_EQ("192.168.1.10", ip);
+
+  const CDNSNameCache::Stats stats = CDNSNameCache::GetStats();
+  EXPECT_EQ(2u, stats.lookups);
+  EXPECT_EQ(1u, stats.hits);
+  EXPECT_EQ(1u, stats.resolutions);
+}
+
+TEST_F(TestDNSNameCache, CachesUnresolvableName)
+{
+  std::string ip;
+  EXPECT_FALSE(CDNSNameCache::Lookup("missing.local", ip));
+  EXPECT_FALSE(CDNSNameCache::Lookup("missing.local", ip));
+  EXPECT_TRUE(ip.empty());
+  EXPECT_EQ(1, m_resolutions);
+  EXPECT_FALSE(CDNSNameCache::GetCached("missing.local", ip));
+
+  const CDNSNameCache::Stats stats = CDNSNameCache::GetStats();
+  EXPECT_EQ(1u, stats.negativeHits);
+  EXPECT_EQ(1u, stats.failures);
+}
+
+TEST_F(TestDNSNameCache, DiscoveryAnswersUnresolvableName)
+{
+  std::atomic<bool> discovered{false};
+  CDNSNameCache::SetDiscoveryLookup(
+      [&discovered](const std::string& strHostName, std::string& strIpAddress)
+      {
+        if (!discovered || strHostName != "missing.local")
+          return false;
+        strIpAddress = "192.168.1.20";
+        return true;
+      });
+
+  std::string ip;
+  EXPECT_FALSE(CDNSNameCache::Lookup("missing.local", ip));
+  EXPECT_EQ(1, m_resolutions);
+
+  // the host announced itself after the resolver failed, the negative entry doesn't hide it
+  discovered = true;
+  EXPECT_TRUE(CDNSNameCache::Lookup("missing.local", ip));
+  EXPECT_EQ("192.168.1.20", ip);
+  EXPECT_EQ(1, m_resolutions);
+  EXPECT_EQ(0u, CDNSNameCache::GetStats().negativeHits);
+}
+
+TEST_F(TestDNSNameCache, ResolvesExpiredUnresolvableName)
+{
+  std::string ip;
+  EXPECT_FALSE(CDNSNameCache::Lookup("expiredmissing.local", ip));
+  EXPECT_FALSE(CDNSNameCache::Lookup("expiredmissing.local", ip));
+  EXPECT_EQ(2, m_resolutions);
+}
+
+TEST_F(TestDNSNameCache, RefreshesExpiredAddress)
+{
+  std::string ip;
+  EXPECT_TRUE(CDNSNameCache::Lookup("expired.local", ip));
+  EXPECT_EQ(1, m_resolutions);
+
+  // the expired address is returned right away and refreshed in the background
+  EXPECT_TRUE(CDNSNameCache::Lookup("expired.local", ip));
+  EXPECT_EQ("192.168.1.11", ip);
+  EXPECT_EQ(1u, CDNSNameCache::GetStats().staleHits);
+  EXPECT_TRUE(ConditionPoll::poll([this]() { return m_resolutions == 2; }));
+}
+
+TEST_F(TestDNSNameCache, CustomEntry)
+{
+  CDNSNameCache::Add("custom.local", "10.1.2.3");
+
+  std::string ip;
+  EXPECT_TRUE(CDNSNameCache::Lookup("custom.local", ip));
+  EXPECT_EQ("10.1.2.3", ip);
+  EXPECT_EQ(0, m_resolutions);
+}
+
+TEST_F(TestDNSNameCache, Prefetch)
+{
+  CDNSNameCache::Prefetch({"media.local", "10.0.0.1", ""});
+
+  // the lookup either waits for the prefetch or finds its result
+  std::string ip;
+  EXPECT_TRUE(CDNSNameCache::Lookup("media.local", ip));
+  EXPECT_EQ("192.168.1.10", ip);
+  EXPECT_EQ(1, m_resolutions);
+
+  // prefetching cached names doesn't resolve them again
+  CDNSNameCache::Prefetch({"media.local"});
+  EXPECT_EQ(1, m_resolutions);
+}
+
+TEST_F(TestDNSNameCache, PrefetchWhileJobWorkersLookUp)
+{
+  // all workers for low priority jobs wait for the prefetch, which must not need one of them
+  constexpr int LOOKUPS = 3;
+  CEvent start(true);
+  std::atomic<int> started{0};
+  std::atomic<int> found{0};
+  for (int i = 0; i < LOOKUPS; i++)
+  {
+    CServiceBroker::GetJobManager()->Submit(
+        [&]()
+        {
+          started++;
+          start.Wait();
+          std::string ip;
+          if (CDNSNameCache::Lookup("media.local", ip))
+            found++;
+        });
+
+    // a new worker is only started for a job if the existing ones are busy
+    ASSERT_TRUE(ConditionPoll::poll([&]() { return started == i + 1; }));
+  }
+
+  CDNSNameCache::Prefetch({"media.local"});
+  start.Set();
+
+  // sooner than the lookups stop waiting and resolve the name themselves
+  EXPECT_TRUE(ConditionPoll::poll(5000, [&]() { return found == LOOKUPS; }));
+  EXPECT_EQ(1, m_resolutions);
+}
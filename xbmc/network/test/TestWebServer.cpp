@@ -28,7 +28,10 @@
 #include "utils/URIUtils.h"
 #include "utils/Variant.h"
 
+#include <atomic>
 #include <random>
+#include <thread>
+#include <vector>
 
 using namespace XFILE;
 
@@ -82,6 +85,47 @@ protected:
     TearDownMediaSources();
   }
 
+  void RestartWithWorkerThreads(unsigned int workerThreads)
+  {
+    webserver.Stop();
+    webserver.SetWorkerThreads(workerThreads);
+    ASSERT_TRUE(webserver.Start(webserverPort, "", ""));
+  }
+
+  void RunConcurrentJsonRpcRequests(unsigned int clients, unsigned int requestsPerClient)
+  {
+    JSONRPC::CJSONRPC::Initialize();
+
+    std::atomic<unsigned int> succeeded{0};
+    std::vector<std::thread> threads;
+
+    for (unsigned int client = 0; client < clients; ++client)
+    {
+      threads.emplace_back([this, requestsPerClient, &succeeded]() {
+        for (unsigned int i = 0; i < requestsPerClient; ++i)
+        {
+          std::string result;
+          CCurlFile curl;
+          curl.SetMimeType("application/json");
+          if (curl.Post(GetUrl(TEST_URL_JSONRPC),
+                        "{ \"jsonrpc\": \"2.0\", \"method\": \"JSONRPC.Version\", \"id\": 1 }",
+                        result))
+          {
+            CVariant resultObj;
+            if (CJSONVariantParser::Parse(result, resultObj) && resultObj.isMember("result"))
+              ++succeeded;
+          }
+        }
+      });
+    }
+    for (auto& thread : threads)
+      thread.join();
+
+    JSONRPC::CJSONRPC::Cleanup();
+
+    EXPECT_EQ(clients * requestsPerClient, succeeded.load());
+  }
+
   void SetupMediaSources()
   {
     CMediaSource source;
@@ -536,6 +580,18 @@ TEST_F(TestWebServer, CanModifyOverJsonRpcWithHttpPost)
   JSONRPC::CJSONRPC::Cleanup();
 }
 
+TEST_F(TestWebServer, CanHandleConcurrentJsonRpcRequestsWithThreadPerConnection)
+{
+  RunConcurrentJsonRpcRequests(8, 5);
+}
+
+TEST_F(TestWebServer, CanHandleConcurrentJsonRpcRequestsWithWorkerThreads)
+{
+  // more clients than worker threads
+  RestartWithWorkerThreads(4);
+  RunConcurrentJsonRpcRequests(8, 5);
+}
+
 TEST_F(TestWebServer, CanNotHeadNonExistingFile)
 {
   CCurlFile curl;
@@ -56,6 +56,12 @@ namespace UPNP
 
 NPT_UInt32 CUPnPServer::m_MaxReturnedItems = 0;
 
+// items fetched from the database at once when browsing a paged container
+static const NPT_UInt32 BROWSE_PAGE_SIZE = 500;
+// browse windows kept for clients paging through containers
+static const size_t BROWSE_MAX_WINDOWS = 8;
+static const std::chrono::seconds BROWSE_WINDOW_TIMEOUT(60);
+
 const char* audio_containers[] = { "musicdb://genres/", "musicdb://artists/", "musicdb://albums/",
                                    "musicdb://songs/", "musicdb://recentlyaddedalbums/", "musicdb://years/",
                                    "musicdb://singles/" };
@@ -151,6 +157,7 @@ CUPnPServer::UpdateContainer(const std::string& id)
     if (itr != m_UpdateIDs.end())
         count = ++itr->second.second;
     m_UpdateIDs[id] = std::make_pair(true, count);
+    ClearBrowseWindows();
     PropagateUpdates();
 }
 
@@ -684,7 +691,6 @@ CUPnPServer::OnBrowseDirectChildren(PLT_ActionReference&          action,
                                     const char*                   sort_criteria,
                                     const PLT_HttpRequestContext& context)
 {
-    CFileItemList items;
     const NPT_String decodedObjectId = DecodeObjectId(object_id);
     m_logger->info("Received Browse DirectChildren request for encoded object '{}' (plain value: '{}'), with sort criteria {}",
                    object_id, decodedObjectId.GetChars(), sort_criteria);
@@ -696,87 +702,158 @@ CUPnPServer::OnBrowseDirectChildren(PLT_ActionReference&          action,
         return NPT_FAILURE;
     }
 
-    items.SetPath(std::string(parent_id));
+    auto browse_start = std::chrono::steady_clock::now();
+
+    // clients page through containers with consecutive requests, so the items
+    // are kept for the client's following requests
+    const std::string key = StringUtils::Format(
+        "{}|{}|{}|{}", context.GetRemoteAddress().GetIpAddress().ToString().GetChars(),
+        parent_id.GetChars(), filter ? filter : "", sort_criteria ? sort_criteria : "");
+    const NPT_UInt32 max_count = GetMaxCount(requested_count);
+    const bool paged = IsPagedContainer(std::string(parent_id));
+
+    std::shared_ptr<BrowseWindow> window = FindBrowseWindow(key, starting_index, max_count);
+    const bool cached = window != nullptr;
+    if (!window) {
+        window = std::make_shared<BrowseWindow>();
+        window->key = key;
+        window->items = std::make_shared<CFileItemList>();
+
+        CFileItemList& items = *window->items;
+        items.SetPath(std::string(parent_id));
+
+        SortDescription sorting;
+        const bool sort_requested = ParseSortCriteria(sort_criteria, items.GetPath(), sorting);
+
+        if (paged) {
+            // let the database sort and limit the items, fetching whole pages
+            // for the client's following requests
+            if (!sort_requested)
+                GetDefaultSort(items, sorting);
+
+            window->start = starting_index - starting_index % BROWSE_PAGE_SIZE;
+            sorting.limitStart = window->start;
+            sorting.limitEnd = std::max(window->start + BROWSE_PAGE_SIZE, starting_index + max_count);
+            if (!GetPagedItems(items.GetPath(), filter, sorting, items)) {
+                action->SetError(800, "Internal Error");
+                return NPT_SUCCESS;
+            }
 
-    // guard against loading while saving to the same cache file
-    // as CArchive currently performs no locking itself
-    bool load;
-    { NPT_AutoLock lock(m_CacheMutex);
-      load = items.Load();
-    }
+            if (items.HasProperty("total")) {
+                window->total = static_cast<int>(items.GetProperty("total").asInteger());
+            } else if (window->start == 0) {
+                window->total = items.Size();
+            } else {
+                // past the end, the database didn't count the items
+                CFileItemList first;
+                sorting.limitStart = 0;
+                sorting.limitEnd = 1;
+                if (!GetPagedItems(items.GetPath(), filter, sorting, first)) {
+                    action->SetError(800, "Internal Error");
+                    return NPT_SUCCESS;
+                }
+                window->total = static_cast<int>(first.GetProperty("total").asInteger());
+            }
+        } else {
+            // guard against loading while saving to the same cache file
+            // as CArchive currently performs no locking itself
+            bool load;
+            { NPT_AutoLock lock(m_CacheMutex);
+              load = items.Load();
+            }
 
-    if (!load) {
-        // cache anything that takes more than a second to retrieve
-        auto start = std::chrono::steady_clock::now();
+            if (!load) {
+                // cache anything that takes more than a second to retrieve
+                auto start = std::chrono::steady_clock::now();
 
-        if (parent_id.StartsWith("virtualpath://upnproot")) {
-            CFileItemPtr item;
+                if (parent_id.StartsWith("virtualpath://upnproot")) {
+                    CFileItemPtr item;
 
-            // music library
-            item.reset(new CFileItem("musicdb://", true));
-            item->SetLabel("Music Library");
-            item->SetLabelPreformatted(true);
-            items.Add(item);
+                    // music library
+                    item.reset(new CFileItem("musicdb://", true));
+                    item->SetLabel("Music Library");
+                    item->SetLabelPreformatted(true);
+                    items.Add(item);
 
-            // video library
-            item.reset(new CFileItem("library://video/", true));
-            item->SetLabel("Video Library");
-            item->SetLabelPreformatted(true);
-            items.Add(item);
+                    // video library
+                    item.reset(new CFileItem("library://video/", true));
+                    item->SetLabel("Video Library");
+                    item->SetLabelPreformatted(true);
+                    items.Add(item);
+
+                    items.Sort(SortByLabel, SortOrderAscending);
+                } else {
+                    // this is the only way to hide unplayable items in the 'files'
+                    // view as we cannot tell what context (eg music vs video) the
+                    // request came from
+                    std::string supported = CServiceBroker::GetFileExtensionProvider().GetPictureExtensions() + "|"
+                                          + CServiceBroker::GetFileExtensionProvider().GetVideoExtensions() + "|"
+                                          + CServiceBroker::GetFileExtensionProvider().GetMusicExtensions() + "|"
+                                          + CServiceBroker::GetFileExtensionProvider().GetPictureExtensions();
+                    CDirectory::GetDirectory((const char*)parent_id, items, supported, DIR_FLAG_DEFAULTS);
+                    DefaultSortItems(items);
+                }
 
-            items.Sort(SortByLabel, SortOrderAscending);
-        } else {
-            // this is the only way to hide unplayable items in the 'files'
-            // view as we cannot tell what context (eg music vs video) the
-            // request came from
-            std::string supported = CServiceBroker::GetFileExtensionProvider().GetPictureExtensions() + "|"
-                                  + CServiceBroker::GetFileExtensionProvider().GetVideoExtensions() + "|"
-                                  + CServiceBroker::GetFileExtensionProvider().GetMusicExtensions() + "|"
-                                  + CServiceBroker::GetFileExtensionProvider().GetPictureExtensions();
-            CDirectory::GetDirectory((const char*)parent_id, items, supported, DIR_FLAG_DEFAULTS);
-            DefaultSortItems(items);
-        }
+                auto end = std::chrono::steady_clock::now();
+                auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
 
-        auto end = std::chrono::steady_clock::now();
-        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
+                if (items.CacheToDiscAlways() || (items.CacheToDiscIfSlow() && duration.count() > 1000))
+                {
+                  NPT_AutoLock lock(m_CacheMutex);
+                  items.Save();
+                }
+            }
 
-        if (items.CacheToDiscAlways() || (items.CacheToDiscIfSlow() && duration.count() > 1000))
-        {
-          NPT_AutoLock lock(m_CacheMutex);
-          items.Save();
-        }
-    }
+            // as there's no library://music support, manually add playlists and music
+            // video nodes
+            if (items.GetPath() == "musicdb://") {
+              CFileItemPtr playlists(new CFileItem("special://musicplaylists/", true));
+              playlists->SetLabel(g_localizeStrings.Get(136));
+              items.Add(playlists);
+
+              CVideoDatabase database;
+              database.Open();
+              if (database.HasContent(VideoDbContentType::MUSICVIDEOS))
+              {
+                CFileItemPtr mvideos(new CFileItem("library://video/musicvideos/", true));
+                mvideos->SetLabel(g_localizeStrings.Get(20389));
+                items.Add(mvideos);
+              }
+            }
 
-    // as there's no library://music support, manually add playlists and music
-    // video nodes
-    if (items.GetPath() == "musicdb://") {
-      CFileItemPtr playlists(new CFileItem("special://musicplaylists/", true));
-      playlists->SetLabel(g_localizeStrings.Get(136));
-      items.Add(playlists);
+            if (sort_requested)
+                items.Sort(sorting);
+        }
 
-      CVideoDatabase database;
-      database.Open();
-      if (database.HasContent(VideoDbContentType::MUSICVIDEOS))
-      {
-        CFileItemPtr mvideos(new CFileItem("library://video/musicvideos/", true));
-        mvideos->SetLabel(g_localizeStrings.Get(20389));
-        items.Add(mvideos);
-      }
+        AddBrowseWindow(window);
     }
 
     // Don't pass parent_id if action is Search not BrowseDirectChildren, as
     // we want the engine to determine the best parent id, not necessarily the one
     // passed
     NPT_String action_name = action->GetActionDesc().GetName();
-    return BuildResponse(
-        action,
-        items,
-        filter,
-        starting_index,
-        requested_count,
-        sort_criteria,
-        context,
-        (action_name.Compare("Search", true)==0)?NULL:parent_id.GetChars());
+    NPT_Result result;
+    { NPT_AutoLock lock(window->mutex);
+      result = BuildResponse(
+          action,
+          *window->items,
+          filter,
+          starting_index,
+          requested_count,
+          sort_criteria,
+          context,
+          (action_name.Compare("Search", true)==0)?NULL:parent_id.GetChars(),
+          window->start,
+          window->total);
+    }
+
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - browse_start);
+    m_logger->debug("Browsing '{}' from {} took {} ms ({})", parent_id.GetChars(), starting_index,
+                    duration.count(),
+                    cached ? "cached window" : (paged ? "database page" : "full listing"));
+
+    return result;
 }
 
 /*----------------------------------------------------------------------
@@ -790,13 +867,21 @@ CUPnPServer::BuildResponse(PLT_ActionReference&          action,
                            NPT_UInt32                    requested_count,
                            const char*                   sort_criteria,
                            const PLT_HttpRequestContext& context,
-                           const char*                   parent_id /* = NULL */)
+                           const char*                   parent_id /* = NULL */,
+                           NPT_UInt32                    items_offset /* = 0 */,
+                           int                           total_matches /* = -1 */)
 {
     NPT_COMPILER_UNUSED(sort_criteria);
 
     m_logger->debug("Building UPnP response with filter '{}', starting @ {} with {} requested",
                     filter, starting_index, requested_count);
 
+    // the items may start further into the container
+    if (starting_index < items_offset) {
+        action->SetError(800, "Internal Error");
+        return NPT_FAILURE;
+    }
+
     // we will reuse this ThumbLoader for all items
     NPT_Reference<CThumbLoader> thumb_loader;
 
@@ -826,15 +911,15 @@ CUPnPServer::BuildResponse(PLT_ActionReference&          action,
 
     // won't return more than UPNP_MAX_RETURNED_ITEMS items at a time to keep things smooth
     // 0 requested means as many as possible
-    NPT_UInt32 max_count  = (requested_count == 0)?m_MaxReturnedItems:std::min((unsigned long)requested_count, (unsigned long)m_MaxReturnedItems);
-    NPT_UInt32 stop_index = std::min((unsigned long)(starting_index + max_count), (unsigned long)items.Size()); // don't return more than we can
+    NPT_UInt32 max_count  = GetMaxCount(requested_count);
+    NPT_UInt32 stop_index = std::min((unsigned long)(starting_index + max_count), (unsigned long)(items_offset + items.Size())); // don't return more than we can
 
     NPT_Cardinal count = 0;
-    NPT_Cardinal total = items.Size();
+    NPT_Cardinal total = (total_matches >= 0) ? total_matches : items.Size();
     NPT_String didl = didl_header;
     PLT_MediaObjectReference object;
     for (unsigned long i=starting_index; i<stop_index; ++i) {
-        object = Build(items[i], true, context, thumb_loader, parent_id);
+        object = Build(items[i - items_offset], true, context, thumb_loader, parent_id);
         if (object.IsNull()) {
             // don't tell the client this item ever existed
             --total;
@@ -844,9 +929,12 @@ CUPnPServer::BuildResponse(PLT_ActionReference&          action,
         NPT_String tmp;
         NPT_CHECK(PLT_Didl::ToDidl(*object.AsPointer(), filter, tmp));
 
-        // Neptunes string growing is dead slow for small additions
+        // Neptunes string growing is dead slow for small additions, so room
+        // for the remaining items is reserved at the size of the average item
         if (didl.GetCapacity() < tmp.GetLength() + didl.GetLength()) {
-            didl.Reserve((tmp.GetLength() + didl.GetLength())*2);
+            NPT_Size average = (didl.GetLength() + tmp.GetLength()) / (count + 1);
+            didl.Reserve(std::max<NPT_Size>((tmp.GetLength() + didl.GetLength())*2,
+                                  didl.GetLength() + average * (stop_index - i) + NPT_StringLength(didl_footer)));
         }
         didl += tmp;
         ++count;
@@ -1021,21 +1109,7 @@ CUPnPServer::OnSearchContainer(PLT_ActionReference&          action,
     } else if (searchClass.Find("object.container.playlistContainer") >= 0) {
         return OnBrowseDirectChildren(action, "special://musicplaylists/", filter, starting_index, requested_count, sort_criteria, context);
     } else if (searchClass.Find("object.container.album.videoAlbum.videoBroadcastShow") >= 0) {
-      CVideoDatabase database;
-      if (!database.Open()) {
-        action->SetError(800, "Internal Error");
-        return NPT_SUCCESS;
-      }
-
-      CFileItemList items;
-      if (!database.GetTvShowsByWhere("videodb://tvshows/titles/?local", CDatabase::Filter(),
-        items, SortDescription(), GetRequiredVideoDbDetails(NPT_String(filter)))) {
-        action->SetError(800, "Internal Error");
-        return NPT_SUCCESS;
-      }
-
-      items.SetPath("videodb://tvshows/titles/");
-      return BuildResponse(action, items, filter, starting_index, requested_count, sort_criteria, context, NULL);
+      return OnBrowseDirectChildren(action, "videodb://tvshows/titles/", filter, starting_index, requested_count, sort_criteria, context);
     } else if (searchClass.Find("object.container.album.videoAlbum.videoBroadcastSeason") >= 0) {
       CVideoDatabase database;
       if (!database.Open()) {
@@ -1051,6 +1125,10 @@ CUPnPServer::OnSearchContainer(PLT_ActionReference&          action,
 
       items.SetPath("videodb://tvshows/titles/-1/");
       return BuildResponse(action, items, filter, starting_index, requested_count, sort_criteria, context, NULL);
+    } else if (searchClass.Find("object.item.videoItem.movie") >= 0) {
+      return OnBrowseDirectChildren(action, "videodb://movies/titles/", filter, starting_index, requested_count, sort_criteria, context);
+    } else if (searchClass.Find("object.item.videoItem.musicVideoClip") >= 0) {
+      return OnBrowseDirectChildren(action, "videodb://musicvideos/titles/", filter, starting_index, requested_count, sort_criteria, context);
     } else if (searchClass.Find("object.item.videoItem") >= 0) {
       CFileItemList items, allItems;
 
@@ -1065,7 +1143,7 @@ CUPnPServer::OnSearchContainer(PLT_ActionReference&          action,
       // determine the required videodb details to be retrieved
       int requiredVideoDbDetails = GetRequiredVideoDbDetails(NPT_String(filter));
 
-      if (allVideoItems || searchClass.Find("object.item.videoItem.movie") >= 0)
+      if (allVideoItems)
       {
         if (!database.GetMoviesByWhere("videodb://movies/titles/?local", CDatabase::Filter(), items, SortDescription(), requiredVideoDbDetails)) {
           action->SetError(800, "Internal Error");
@@ -1074,9 +1152,6 @@ CUPnPServer::OnSearchContainer(PLT_ActionReference&          action,
 
         allItems.Append(items);
         items.Clear();
-
-        if (!allVideoItems)
-          allItems.SetPath("videodb://movies/titles/");
       }
 
       if (allVideoItems || searchClass.Find("object.item.videoItem.videoBroadcast") >= 0)
@@ -1093,7 +1168,7 @@ CUPnPServer::OnSearchContainer(PLT_ActionReference&          action,
           allItems.SetPath("videodb://tvshows/titles/");
       }
 
-      if (allVideoItems || searchClass.Find("object.item.videoItem.musicVideoClip") >= 0)
+      if (allVideoItems)
       {
         if (!database.GetMusicVideosByWhere("videodb://musicvideos/titles/?local", CDatabase::Filter(), items, true, SortDescription(), requiredVideoDbDetails)) {
           action->SetError(800, "Internal Error");
@@ -1102,9 +1177,6 @@ CUPnPServer::OnSearchContainer(PLT_ActionReference&          action,
 
         allItems.Append(items);
         items.Clear();
-
-        if (!allVideoItems)
-          allItems.SetPath("videodb://musicvideos/titles/");
       }
 
       if (allVideoItems)
@@ -1353,14 +1425,214 @@ CUPnPServer::ServeFile(const NPT_HttpRequest&              request,
 
 void
 CUPnPServer::DefaultSortItems(CFileItemList& items)
+{
+  SortDescription sorting;
+  if (GetDefaultSort(items, sorting))
+    items.Sort(sorting.sortBy, sorting.sortOrder, sorting.sortAttributes);
+}
+
+bool
+CUPnPServer::GetDefaultSort(const CFileItemList& items, SortDescription& sorting)
 {
   CGUIViewState* viewState = CGUIViewState::GetViewState(items.IsVideoDb() ? WINDOW_VIDEO_NAV : -1, items);
-  if (viewState)
+  if (!viewState)
+    return false;
+
+  sorting = viewState->GetSortMethod();
+  delete viewState;
+  return true;
+}
+
+bool
+CUPnPServer::ParseSortCriteria(const char* sort_criteria,
+                               const std::string& path,
+                               SortDescription& sorting)
+{
+  if (!sort_criteria)
+    return false;
+
+  // the properties advertised in the SortCapabilities
+  static const std::map<std::string, SortBy> properties = {
+      {"dc:title", SortByTitle},
+      {"dc:date", SortByYear},
+      {"dc:size", SortBySize},
+      {"res@duration", SortByTime},
+      {"res@size", SortBySize},
+      {"res@bitrate", SortByBitrate},
+      {"upnp:album", SortByAlbum},
+      {"upnp:artist", SortByArtist},
+      {"upnp:albumArtist", SortByArtist},
+      {"upnp:episodeNumber", SortByEpisodeNumber},
+      {"upnp:episodeCount", SortByNumberOfEpisodes},
+      {"upnp:episodeSeason", SortBySeason},
+      {"upnp:genre", SortByGenre},
+      {"upnp:originalTrackNumber", SortByTrackNumber},
+      {"upnp:rating", SortByRating},
+      {"xbmc:rating", SortByRating},
+      {"xbmc:dateadded", SortByDateAdded},
+      {"xbmc:votes", SortByVotes},
+  };
+
+  // only the first known property is used, the others merely break ties
+  for (std::string property : StringUtils::Split(sort_criteria, ','))
   {
-    SortDescription sorting = viewState->GetSortMethod();
-    items.Sort(sorting.sortBy, sorting.sortOrder, sorting.sortAttributes);
-    delete viewState;
+    StringUtils::Trim(property);
+    SortOrder order = SortOrderAscending;
+    if (!property.empty() && (property[0] == '+' || property[0] == '-'))
+    {
+      if (property[0] == '-')
+        order = SortOrderDescending;
+      property.erase(0, 1);
+    }
+
+    auto it = properties.find(property);
+    if (it == properties.end())
+      continue;
+
+    sorting.sortBy = it->second;
+    // albums are titled by their name
+    if (sorting.sortBy == SortByTitle && StringUtils::StartsWith(path, "musicdb://albums/"))
+      sorting.sortBy = SortByAlbum;
+    sorting.sortOrder = order;
+    if (CServiceBroker::GetSettingsComponent()->GetSettings()->GetBool(
+            CSettings::SETTING_FILELISTS_IGNORETHEWHENSORTING))
+      sorting.sortAttributes = SortAttributeIgnoreArticle;
+    return true;
+  }
+
+  return false;
+}
+
+bool
+CUPnPServer::IsPagedContainer(const std::string& path)
+{
+  // containers listing the library's items without grouping them, which may
+  // be too large to load in full for each request
+  return path == "musicdb://songs/" || path == "musicdb://albums/" ||
+         path == "videodb://movies/titles/" || path == "videodb://tvshows/titles/" ||
+         path == "videodb://musicvideos/titles/";
+}
+
+NPT_UInt32
+CUPnPServer::GetMaxCount(NPT_UInt32 requested_count)
+{
+  // won't return more than UPNP_MAX_RETURNED_ITEMS items at a time to keep things smooth
+  // 0 requested means as many as possible
+  return (requested_count == 0) ? m_MaxReturnedItems : std::min(requested_count, m_MaxReturnedItems);
+}
+
+bool
+CUPnPServer::GetPagedItems(const std::string& path,
+                           const char* filter,
+                           const SortDescription& sorting,
+                           CFileItemList& items)
+{
+  bool result;
+  if (URIUtils::IsMusicDb(path))
+  {
+    CMusicDatabase database;
+    if (!database.Open())
+      return false;
+
+    if (path == "musicdb://songs/")
+      result = database.GetSongsFullByWhere(path, CDatabase::Filter(), items, sorting, true);
+    else
+      result = database.GetAlbumsByWhere(path, CDatabase::Filter(), items, sorting);
+  }
+  else
+  {
+    CVideoDatabase database;
+    if (!database.Open())
+      return false;
+
+    const int details = GetRequiredVideoDbDetails(NPT_String(filter));
+    if (path == "videodb://movies/titles/")
+      result = database.GetMoviesByWhere(path, CDatabase::Filter(), items, sorting, details);
+    else if (path == "videodb://tvshows/titles/")
+      result = database.GetTvShowsByWhere(path, CDatabase::Filter(), items, sorting, details);
+    else
+      result = database.GetMusicVideosByWhere(path, CDatabase::Filter(), items, true, sorting,
+                                              details);
+
+    // as done by the videodb:// directory
+    for (int i = 0; i < items.Size(); ++i)
+    {
+      if (items[i]->HasVideoInfoTag())
+        items[i]->SetDynPath(items[i]->GetVideoInfoTag()->GetPath());
+    }
   }
+
+  // items sorted in memory aren't limited if the limits start past the end,
+  // all of them are returned instead
+  if (result && items.Size() > sorting.limitEnd - sorting.limitStart)
+  {
+    for (int i = items.Size() - 1; i >= 0; --i)
+    {
+      if (i < sorting.limitStart || i >= sorting.limitEnd)
+        items.Remove(i);
+    }
+  }
+
+  return result;
+}
+
+std::shared_ptr<CUPnPServer::BrowseWindow>
+CUPnPServer::FindBrowseWindow(const std::string& key,
+                              NPT_UInt32 starting_index,
+                              NPT_UInt32 count)
+{
+  NPT_AutoLock lock(m_WindowMutex);
+
+  // drop the windows of clients which stopped paging
+  const auto now = std::chrono::steady_clock::now();
+  m_BrowseWindows.remove_if([&now](const std::shared_ptr<BrowseWindow>& window) {
+    return now - window->time > BROWSE_WINDOW_TIMEOUT;
+  });
+
+  for (auto it = m_BrowseWindows.begin(); it != m_BrowseWindows.end(); ++it)
+  {
+    const std::shared_ptr<BrowseWindow>& window = *it;
+    if (window->key != key)
+      continue;
+
+    // a window of a paged container has to hold the requested items, or all
+    // items up to the end of the container
+    if (window->total >= 0)
+    {
+      const NPT_UInt32 end = window->start + window->items->Size();
+      if (starting_index < window->start ||
+          (starting_index + count > end && end < static_cast<NPT_UInt32>(window->total)))
+        return {};
+    }
+
+    window->time = now;
+    m_BrowseWindows.splice(m_BrowseWindows.begin(), m_BrowseWindows, it);
+    return m_BrowseWindows.front();
+  }
+
+  return {};
+}
+
+void
+CUPnPServer::AddBrowseWindow(const std::shared_ptr<BrowseWindow>& window)
+{
+  NPT_AutoLock lock(m_WindowMutex);
+
+  const std::string& key = window->key;
+  m_BrowseWindows.remove_if(
+      [&key](const std::shared_ptr<BrowseWindow>& other) { return other->key == key; });
+
+  window->time = std::chrono::steady_clock::now();
+  m_BrowseWindows.push_front(window);
+  while (m_BrowseWindows.size() > BROWSE_MAX_WINDOWS)
+    m_BrowseWindows.pop_back();
+}
+
+void
+CUPnPServer::ClearBrowseWindows()
+{
+  NPT_AutoLock lock(m_WindowMutex);
+  m_BrowseWindows.clear();
 }
 
 NPT_Result CUPnPServer::AddSubtitleUriForSecResponse(const NPT_String& movie_md5,
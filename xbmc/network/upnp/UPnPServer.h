@@ -11,6 +11,8 @@
 #include "interfaces/IAnnouncer.h"
 #include "utils/logtypes.h"
 
+#include <chrono>
+#include <list>
 #include <map>
 #include <memory>
 #include <string>
@@ -24,6 +26,7 @@ class CThumbLoader;
 class CVariant;
 class PLT_MediaObject;
 class PLT_HttpRequestContext;
+struct SortDescription;
 
 namespace UPNP
 {
@@ -109,6 +112,17 @@ public:
 
 
   private:
+    // window of a container's items kept for a client paging through it
+    struct BrowseWindow
+    {
+      std::string key; // client, container, filter and sort criteria
+      NPT_UInt32 start = 0; // index of the first item in the container
+      int total = -1; // items in the container, -1 if the window holds all of them
+      std::chrono::steady_clock::time_point time;
+      NPT_Mutex mutex; // held while building a response from the items
+      std::shared_ptr<CFileItemList> items;
+    };
+
     void OnScanCompleted(int type);
     void UpdateContainer(const std::string& id);
     void PropagateUpdates();
@@ -125,10 +139,28 @@ public:
                              NPT_UInt32                    requested_count,
                              const char*                   sort_criteria,
                              const PLT_HttpRequestContext& context,
-                             const char*                   parent_id /* = NULL */);
+                             const char*                   parent_id /* = NULL */,
+                             NPT_UInt32                    items_offset = 0,
+                             int                           total_matches = -1);
+
+    std::shared_ptr<BrowseWindow> FindBrowseWindow(const std::string& key,
+                                                   NPT_UInt32 starting_index,
+                                                   NPT_UInt32 count);
+    void AddBrowseWindow(const std::shared_ptr<BrowseWindow>& window);
+    void ClearBrowseWindows();
+    bool GetPagedItems(const std::string& path,
+                       const char* filter,
+                       const SortDescription& sorting,
+                       CFileItemList& items);
 
     // class methods
     static void DefaultSortItems(CFileItemList& items);
+    static bool GetDefaultSort(const CFileItemList& items, SortDescription& sorting);
+    static bool ParseSortCriteria(const char* sort_criteria,
+                                  const std::string& path,
+                                  SortDescription& sorting);
+    static bool IsPagedContainer(const std::string& path);
+    static NPT_UInt32 GetMaxCount(NPT_UInt32 requested_count);
     static NPT_String GetParentFolder(const NPT_String& file_path)
     {
       int index = file_path.ReverseFind("\\");
@@ -142,6 +174,9 @@ public:
 
     NPT_Mutex m_CacheMutex;
 
+    NPT_Mutex m_WindowMutex;
+    std::list<std::shared_ptr<BrowseWindow>> m_BrowseWindows; // most recently used first
+
     NPT_Mutex m_FileMutex;
     NPT_Map<NPT_String, NPT_String> m_FileMap;
 
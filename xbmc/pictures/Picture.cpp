@@ -7,6 +7,7 @@
  */
 
 #include <algorithm>
+#include <thread>
 
 #include "Picture.h"
 #include "URL.h"
@@ -22,11 +23,53 @@
 #include "guilib/imagefactory.h"
 
 extern "C" {
+#include <libavutil/buffer.h>
+#include <libavutil/frame.h>
+#include <libavutil/opt.h>
 #include <libswscale/swscale.h>
 }
 
 using namespace XFILE;
 
+namespace
+{
+// Images with at least this many pixels are scaled by several threads
+constexpr unsigned int PARALLEL_SCALE_MIN_PIXELS = 1024 * 1024;
+// Images are often scaled by several jobs at once, so each one only gets a few threads
+constexpr unsigned int MAX_SCALE_THREADS = 4;
+
+// The frames passed to swscale only refer to the buffers of the caller
+void NoFree(void* opaque, uint8_t* data)
+{
+}
+
+AVFrame* CreateFrame(uint8_t* pixels,
+                     unsigned int width,
+                     unsigned int height,
+                     unsigned int pitch,
+                     AVPixelFormat format)
+{
+  AVFrame* frame = av_frame_alloc();
+  if (frame == nullptr)
+    return nullptr;
+
+  frame->buf[0] = av_buffer_create(pixels, static_cast<size_t>(pitch) * height, NoFree, nullptr, 0);
+  if (frame->buf[0] == nullptr)
+  {
+    av_frame_free(&frame);
+    return nullptr;
+  }
+
+  frame->data[0] = pixels;
+  frame->linesize[0] = static_cast<int>(pitch);
+  frame->width = static_cast<int>(width);
+  frame->height = static_cast<int>(height);
+  frame->format = format;
+
+  return frame;
+}
+} // namespace
+
 bool CPicture::GetThumbnailFromSurface(const unsigned char* buffer, int width, int height, int stride, const std::string &thumbFile, uint8_t* &result, size_t& result_size)
 {
   unsigned char *thumb = NULL;
@@ -361,22 +404,39 @@ bool CPicture::ScaleImage(uint8_t* in_pixels,
                           CPictureScalingAlgorithm::Algorithm
                               scalingAlgorithm /* = CPictureScalingAlgorithm::NoAlgorithm */)
 {
-  struct SwsContext* context =
-      sws_getContext(in_width, in_height, in_format, out_width, out_height, out_format,
-                     CPictureScalingAlgorithm::ToSwscale(scalingAlgorithm), NULL, NULL, NULL);
+  struct SwsContext* context = sws_alloc_context();
+  if (context == nullptr)
+    return false;
 
-  uint8_t *src[] = { in_pixels, 0, 0, 0 };
-  int     srcStride[] = { (int)in_pitch, 0, 0, 0 };
-  uint8_t *dst[] = { out_pixels , 0, 0, 0 };
-  int     dstStride[] = { (int)out_pitch, 0, 0, 0 };
+  // large images are scaled in slices by a few threads
+  unsigned int threads = 1;
+  if (in_width * in_height >= PARALLEL_SCALE_MIN_PIXELS)
+    threads = std::clamp(std::thread::hardware_concurrency(), 1u, MAX_SCALE_THREADS);
 
-  if (context)
+  av_opt_set_int(context, "srcw", in_width, 0);
+  av_opt_set_int(context, "srch", in_height, 0);
+  av_opt_set_pixel_fmt(context, "src_format", in_format, 0);
+  av_opt_set_int(context, "dstw", out_width, 0);
+  av_opt_set_int(context, "dsth", out_height, 0);
+  av_opt_set_pixel_fmt(context, "dst_format", out_format, 0);
+  av_opt_set_int(context, "sws_flags", CPictureScalingAlgorithm::ToSwscale(scalingAlgorithm), 0);
+  av_opt_set_int(context, "threads", threads, 0);
+
+  bool success = false;
+  if (sws_init_context(context, nullptr, nullptr) >= 0)
   {
-    sws_scale(context, src, srcStride, 0, in_height, dst, dstStride);
-    sws_freeContext(context);
-    return true;
+    AVFrame* src = CreateFrame(in_pixels, in_width, in_height, in_pitch, in_format);
+    AVFrame* dst = CreateFrame(out_pixels, out_width, out_height, out_pitch, out_format);
+
+    if (src && dst)
+      success = sws_scale_frame(context, dst, src) >= 0;
+
+    av_frame_free(&src);
+    av_frame_free(&dst);
   }
-  return false;
+
+  sws_freeContext(context);
+  return success;
 }
 
 bool CPicture::OrientateImage(uint32_t *&pixels, unsigned int &width, unsigned int &height, int orientation)
@@ -13,8 +13,12 @@
 
 #include <algorithm>
 #include <array>
+#include <cstring>
 #include <limits.h>
+#include <string>
+#include <vector>
 
+#include <sched.h>
 #include <sys/resource.h>
 #include <unistd.h>
 
@@ -52,6 +56,42 @@ constexpr int ThreadPriorityToNativePriority(const ThreadPriority& priority)
   }
 }
 
+int SchedulingPolicyToNativePolicy(XbmcThreads::SchedulingPolicy policy)
+{
+  switch (policy)
+  {
+    case XbmcThreads::SchedulingPolicy::BATCH:
+      return SCHED_BATCH;
+    case XbmcThreads::SchedulingPolicy::IDLE:
+      return SCHED_IDLE;
+    case XbmcThreads::SchedulingPolicy::FIFO:
+      return SCHED_FIFO;
+    case XbmcThreads::SchedulingPolicy::RR:
+      return SCHED_RR;
+    default:
+      return SCHED_OTHER;
+  }
+}
+
+const char* NativePolicyName(int policy)
+{
+  switch (policy)
+  {
+    case SCHED_OTHER:
+      return "other";
+    case SCHED_BATCH:
+      return "batch";
+    case SCHED_IDLE:
+      return "idle";
+    case SCHED_FIFO:
+      return "fifo";
+    case SCHED_RR:
+      return "rr";
+    default:
+      return "unknown";
+  }
+}
+
 #if !defined(TARGET_ANDROID) && (defined(__GLIBC__) || defined(__UCLIBC__))
 #if defined(__UCLIBC__) || !__GLIBC_PREREQ(2, 30)
 static pid_t gettid()
@@ -169,3 +209,89 @@ bool CThreadImplLinux::SetPriority(const ThreadPriority& priority)
 
   return true;
 }
+
+bool CThreadImplLinux::SetRolePolicy(const XbmcThreads::ThreadRolePolicy& policy)
+{
+  bool applied = true;
+
+  if (!policy.m_cpus.empty())
+  {
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    for (const unsigned int cpu : policy.m_cpus)
+    {
+      if (cpu < CPU_SETSIZE)
+        CPU_SET(cpu, &cpus);
+    }
+
+    if (sched_setaffinity(m_threadID, sizeof(cpus), &cpus) != 0)
+    {
+      CLog::Log(LOGWARNING, "[threads] failed to set affinity to cpus {}: {}",
+                XbmcThreads::CThreadRoles::FormatCpus(policy.m_cpus), strerror(errno));
+      applied = false;
+    }
+  }
+
+  if (policy.m_policy != XbmcThreads::SchedulingPolicy::DEFAULT)
+  {
+    const int nativePolicy = SchedulingPolicyToNativePolicy(policy.m_policy);
+    sched_param param = {};
+    if (nativePolicy == SCHED_FIFO || nativePolicy == SCHED_RR)
+      param.sched_priority =
+          std::clamp(policy.m_realtimePriority, sched_get_priority_min(nativePolicy),
+                     sched_get_priority_max(nativePolicy));
+
+    // realtime policies need CAP_SYS_NICE or an RLIMIT_RTPRIO entry in limits.conf
+    if (sched_setscheduler(m_threadID, nativePolicy, &param) != 0)
+    {
+      CLog::Log(LOGWARNING, "[threads] failed to set scheduling policy {}: {}",
+                XbmcThreads::CThreadRoles::GetPolicyName(policy.m_policy), strerror(errno));
+      applied = false;
+    }
+  }
+
+  if (policy.m_nice)
+  {
+    const int appNice = getpriority(PRIO_PROCESS, getpid());
+    const int newNice = std::clamp(appNice + *policy.m_nice, -20, 19);
+    if (setpriority(PRIO_PROCESS, m_threadID, newNice) != 0)
+    {
+      CLog::Log(LOGWARNING, "[threads] failed to set nice value {}: {}", newNice, strerror(errno));
+      applied = false;
+    }
+  }
+
+  return applied;
+}
+
+std::string CThreadImplLinux::GetPlacement() const
+{
+  std::string placement;
+
+  cpu_set_t cpus;
+  if (sched_getaffinity(m_threadID, sizeof(cpus), &cpus) == 0)
+  {
+    std::vector<unsigned int> cpuList;
+    for (unsigned int cpu = 0; cpu < CPU_SETSIZE; cpu++)
+    {
+      if (CPU_ISSET(cpu, &cpus))
+        cpuList.push_back(cpu);
+    }
+    placement += "cpus " + XbmcThreads::CThreadRoles::FormatCpus(cpuList) + ", ";
+  }
+
+  const int nativePolicy = sched_getscheduler(m_threadID);
+  if (nativePolicy >= 0)
+  {
+    placement += std::string("policy ") + NativePolicyName(nativePolicy) + ", ";
+
+    sched_param param;
+    if ((nativePolicy == SCHED_FIFO || nativePolicy == SCHED_RR) &&
+        sched_getparam(m_threadID, &param) == 0)
+      placement += "priority " + std::to_string(param.sched_priority) + ", ";
+  }
+
+  placement += "nice " + std::to_string(getpriority(PRIO_PROCESS, m_threadID));
+
+  return placement;
+}
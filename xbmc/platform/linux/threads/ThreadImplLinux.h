@@ -21,6 +21,10 @@ public:
 
   bool SetPriority(const ThreadPriority& priority) override;
 
+  bool SetRolePolicy(const XbmcThreads::ThreadRolePolicy& policy) override;
+
+  std::string GetPlacement() const override;
+
 private:
   pid_t m_threadID;
 };
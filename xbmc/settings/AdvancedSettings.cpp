@@ -12,6 +12,7 @@
 #include "ServiceBroker.h"
 #include "URL.h"
 #include "application/AppParams.h"
+#include "cores/paplayer/DecodedAudioCache.h"
 #include "filesystem/SpecialProtocol.h"
 #include "network/DNSNameCache.h"
 #include "profiles/ProfileManager.h"
@@ -19,6 +20,8 @@
 #include "settings/SettingsComponent.h"
 #include "settings/lib/Setting.h"
 #include "settings/lib/SettingsManager.h"
+#include "threads/LockStatistics.h"
+#include "threads/ThreadRoles.h"
 #include "utils/FileUtils.h"
 #include "utils/LangCodeExpander.h"
 #include "utils/StringUtils.h"
@@ -30,6 +33,7 @@
 
 #include <algorithm>
 #include <climits>
+#include <optional>
 #include <regex>
 #include <string>
 #include <vector>
@@ -306,6 +310,8 @@ void CAdvancedSettings::Initialize()
   m_iMusicLibraryRecentlyAddedItems = 25;
   m_strMusicLibraryAlbumFormat = "";
   m_prioritiseAPEv2tags = false;
+  m_musicTagReadersLocal = 2;
+  m_musicTagReadersRemote = 8;
   m_musicItemSeparator = " / ";
   m_musicArtistSeparators = { ";", " feat. ", " ft. " };
   m_videoItemSeparator = " / ";
@@ -418,11 +424,17 @@ void CAdvancedSettings::Initialize()
   m_jsonOutputCompact = true;
   m_jsonTcpPort = 9090;
 
+  m_webserverWorkerThreads = 0;
+
+  m_gamesRewindMemory = 256;
+  m_gamesRunAheadFrames = 0;
+
   m_enableMultimediaKeys = false;
 
   m_canWindowed = true;
   m_guiVisualizeDirtyRegions = false;
   m_guiAlgorithmDirtyRegions = 3;
+  m_guiDirtyRegionTileSize = 64;
   m_guiSmartRedraw = false;
   m_airTunesPort = 36666;
   m_airPlayPort = 36667;
@@ -471,6 +483,9 @@ bool CAdvancedSettings::Load(const CProfileManager &profileManager)
 
   ParseSettingsFile(profileManager.GetUserDataItem("advancedsettings.xml"));
 
+  CDecodedAudioCache::GetInstance().SetMaxMemory(static_cast<size_t>(m_musicDecodeCacheSize) *
+                                                 1024 * 1024);
+
   // Add the list of disc stub extensions (if any) to the list of video extensions
   if (!m_discStubExtensions.empty())
     m_videoExtensions += "|" + m_discStubExtensions;
@@ -594,6 +609,9 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetFloat(pElement, "limiterrelease", m_limiterRelease, 0.001f, 100.0f);
     XMLUtils::GetUInt(pElement, "maxpassthroughoffsyncduration", m_maxPassthroughOffSyncDuration,
                       10, 100);
+    XMLUtils::GetUInt(pElement, "decodebuffertime", m_musicDecodeBufferTime, 500, 30000);
+    XMLUtils::GetUInt(pElement, "decodebuffersize", m_musicDecodeBufferSize, 1024, 262144);
+    XMLUtils::GetUInt(pElement, "decodecachesize", m_musicDecodeCacheSize, 0, 4096);
   }
 
   pElement = pRootElement->FirstChildElement("x11");
@@ -790,6 +808,8 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
   {
     XMLUtils::GetInt(pElement, "recentlyaddeditems", m_iMusicLibraryRecentlyAddedItems, 1, INT_MAX);
     XMLUtils::GetBoolean(pElement, "prioritiseapetags", m_prioritiseAPEv2tags);
+    XMLUtils::GetUInt(pElement, "localtagreaders", m_musicTagReadersLocal, 1, 32);
+    XMLUtils::GetUInt(pElement, "remotetagreaders", m_musicTagReadersRemote, 1, 32);
     XMLUtils::GetBoolean(pElement, "allitemsonbottom", m_bMusicLibraryAllItemsOnBottom);
     XMLUtils::GetBoolean(pElement, "cleanonupdate", m_bMusicLibraryCleanOnUpdate);
     XMLUtils::GetBoolean(pElement, "artistsortonupdate", m_bMusicLibraryArtistSortOnUpdate);
@@ -883,6 +903,10 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetUInt(pElement, "tcpport", m_jsonTcpPort);
   }
 
+  pElement = pRootElement->FirstChildElement("webserver");
+  if (pElement)
+    XMLUtils::GetUInt(pElement, "workerthreads", m_webserverWorkerThreads, 0, 64);
+
   pElement = pRootElement->FirstChildElement("samba");
   if (pElement)
   {
@@ -917,6 +941,71 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     CServiceBroker::GetLogging().SetLogLevel(m_logLevel);
   }
 
+  // drop log messages rather than stall the logging thread when the log writer falls behind
+  bool logDropOnOverflow = false;
+  if (XMLUtils::GetBoolean(pRootElement, "logdroponoverflow", logDropOnOverflow))
+    CServiceBroker::GetLogging().SetDropOnOverflow(logDropOnOverflow);
+
+  // collect contention statistics of critical sections, optionally logging them periodically
+  pElement = pRootElement->FirstChildElement("lockstatistics");
+  if (pElement)
+  {
+    bool enabled = false;
+    int logInterval = 0;
+    XMLUtils::GetBoolean(pElement, "enabled", enabled);
+    XMLUtils::GetInt(pElement, "loginterval", logInterval, 0, 86400);
+    XbmcThreads::CLockStatistics::SetEnabled(enabled, std::chrono::seconds(logInterval));
+  }
+
+  pElement = pRootElement->FirstChildElement("threadroles");
+  if (pElement)
+  {
+    using XbmcThreads::CThreadRoles;
+
+    for (const ThreadRole role :
+         {ThreadRole::REALTIME, ThreadRole::INTERACTIVE, ThreadRole::BACKGROUND})
+    {
+      const TiXmlElement* pRole = pElement->FirstChildElement(CThreadRoles::GetRoleName(role));
+      if (!pRole)
+        continue;
+
+      XbmcThreads::ThreadRolePolicy policy;
+      std::string value;
+      if (XMLUtils::GetString(pRole, "cpus", value) &&
+          !CThreadRoles::ParseCpus(value, policy.m_cpus))
+        CLog::Log(LOGWARNING, "Invalid cpu list '{}' for {} threads", value,
+                  CThreadRoles::GetRoleName(role));
+      int nice;
+      if (XMLUtils::GetInt(pRole, "nice", nice, -20, 19))
+        policy.m_nice = nice;
+      if (XMLUtils::GetString(pRole, "policy", value))
+      {
+        StringUtils::ToLower(value);
+        const auto schedulingPolicy = CThreadRoles::ParsePolicy(value);
+        if (schedulingPolicy)
+          policy.m_policy = *schedulingPolicy;
+        else
+          CLog::Log(LOGWARNING, "Invalid scheduling policy '{}' for {} threads", value,
+                    CThreadRoles::GetRoleName(role));
+      }
+      XMLUtils::GetInt(pRole, "priority", policy.m_realtimePriority, 1, 99);
+      CThreadRoles::SetPolicy(role, policy);
+    }
+
+    for (const TiXmlElement* pThread = pElement->FirstChildElement("thread"); pThread;
+         pThread = pThread->NextSiblingElement("thread"))
+    {
+      const char* name = pThread->Attribute("name");
+      std::optional<ThreadRole> role;
+      if (pThread->FirstChild())
+        role = CThreadRoles::ParseRole(StringUtils::ToLower(pThread->FirstChild()->ValueStr()));
+      if (name && role)
+        CThreadRoles::SetThreadRole(name, *role);
+      else
+        CLog::Log(LOGWARNING, "Invalid thread role in advancedsettings.xml");
+    }
+  }
+
   XMLUtils::GetString(pRootElement, "cddbaddress", m_cddbAddress);
   XMLUtils::GetBoolean(pRootElement, "addsourceontop", m_addSourceOnTop);
 
@@ -946,6 +1035,8 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
 
   XMLUtils::GetBoolean(pRootElement,"virtualshares", m_bVirtualShares);
   XMLUtils::GetUInt(pRootElement, "packagefoldersize", m_addonPackageFolderSize);
+  XMLUtils::GetUInt(pRootElement, "gamesrewindmemory", m_gamesRewindMemory, 16, 4096);
+  XMLUtils::GetUInt(pRootElement, "gamesrunaheadframes", m_gamesRunAheadFrames, 0, 4);
 
   // EPG
   pElement = pRootElement->FirstChildElement("epg");
@@ -1242,6 +1333,7 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
   {
     XMLUtils::GetBoolean(pElement, "visualizedirtyregions", m_guiVisualizeDirtyRegions);
     XMLUtils::GetInt(pElement, "algorithmdirtyregions",     m_guiAlgorithmDirtyRegions);
+    XMLUtils::GetInt(pElement, "dirtyregiontilesize", m_guiDirtyRegionTileSize, 8, 1024);
     XMLUtils::GetBoolean(pElement, "smartredraw", m_guiSmartRedraw);
   }
 
@@ -160,6 +160,9 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     float m_videoIgnorePercentAtEnd;
     float m_audioApplyDrc;
     unsigned int m_maxPassthroughOffSyncDuration = 10; // when 10 ms off adjust
+    unsigned int m_musicDecodeBufferTime = 2000; ///< ms of audio decoded ahead per music stream
+    unsigned int m_musicDecodeBufferSize = 16384; ///< upper bound of the decode buffer in KiB
+    unsigned int m_musicDecodeCacheSize = 0; ///< MiB of decoded music kept for replays, 0 disables
 
     int   m_videoVDPAUScaling;
     float m_videoNonLinStretchRatio;
@@ -253,6 +256,8 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     bool m_bMusicLibraryUseISODates;
     std::string m_strMusicLibraryAlbumFormat;
     bool m_prioritiseAPEv2tags;
+    unsigned int m_musicTagReadersLocal; ///< files whose tags are read in parallel on local sources
+    unsigned int m_musicTagReadersRemote; ///< files whose tags are read in parallel on network sources
     std::string m_musicItemSeparator;
     std::vector<std::string> m_musicArtistSeparators;
     std::string m_videoItemSeparator;
@@ -340,6 +345,7 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
 
     bool m_guiVisualizeDirtyRegions;
     int  m_guiAlgorithmDirtyRegions;
+    int m_guiDirtyRegionTileSize;
     bool m_guiSmartRedraw;
     unsigned int m_addonPackageFolderSize;
 
@@ -351,6 +357,11 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     bool m_jsonOutputCompact;
     unsigned int m_jsonTcpPort;
 
+    unsigned int m_webserverWorkerThreads; ///< 0 for one thread per connection
+
+    unsigned int m_gamesRewindMemory; ///< maximum size of the rewind history of games in MB
+    unsigned int m_gamesRunAheadFrames; ///< frames run ahead to hide the input lag of games
+
     bool m_enableMultimediaKeys;
     std::vector<std::string> m_settingsFiles;
     void ParseSettingsFile(const std::string &file);
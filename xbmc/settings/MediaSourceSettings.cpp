@@ -12,6 +12,7 @@
 #include "URL.h"
 #include "Util.h"
 #include "media/MediaLockState.h"
+#include "network/DNSNameCache.h"
 #include "network/WakeOnAccess.h"
 #include "profiles/ProfileManager.h"
 #include "settings/SettingsComponent.h"
@@ -22,6 +23,7 @@
 #include "utils/XMLUtils.h"
 #include "utils/log.h"
 
+#include <algorithm>
 #include <cstdlib>
 #include <string>
 
@@ -101,9 +103,39 @@ bool CMediaSourceSettings::Load(const std::string &file)
   GetSources(pRootElement, "music", m_musicSources, m_defaultMusicSource);
   GetSources(pRootElement, "games", m_gameSources, dummy);
 
+  PrefetchHostNames();
+
   return true;
 }
 
+void CMediaSourceSettings::PrefetchHostNames() const
+{
+  // the sources are about to be browsed, so their hosts are resolved up front
+  std::vector<std::string> hostNames;
+  for (const VECSOURCES* sources : {&m_programSources, &m_pictureSources, &m_fileSources,
+                                    &m_musicSources, &m_videoSources, &m_gameSources})
+  {
+    for (const CMediaSource& source : *sources)
+    {
+      for (const std::string& path : source.vecPaths)
+      {
+        const CURL url(path);
+        if (!url.IsProtocol("smb") && !url.IsProtocol("nfs") && !url.IsProtocol("ftp") &&
+            !url.IsProtocol("ftps") && !url.IsProtocol("sftp") && !url.IsProtocol("http") &&
+            !url.IsProtocol("https") && !url.IsProtocol("dav") && !url.IsProtocol("davs"))
+          continue;
+
+        const std::string& hostName = url.GetHostName();
+        if (!hostName.empty() &&
+            std::find(hostNames.begin(), hostNames.end(), hostName) == hostNames.end())
+          hostNames.push_back(hostName);
+      }
+    }
+  }
+
+  CDNSNameCache::Prefetch(hostNames);
+}
+
 bool CMediaSourceSettings::Save()
 {
   return Save(GetSourcesFile());
@@ -51,6 +51,7 @@ private:
   bool GetSource(const std::string &category, const TiXmlNode *source, CMediaSource &share);
   void GetSources(const TiXmlNode* pRootElement, const std::string& strTagName, VECSOURCES& items, std::string& strDefault);
   bool SetSources(TiXmlNode *root, const char *section, const VECSOURCES &shares, const std::string &defaultPath) const;
+  void PrefetchHostNames() const;
 
   VECSOURCES m_programSources;
   VECSOURCES m_pictureSources;
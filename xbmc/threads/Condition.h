@@ -37,16 +37,20 @@ namespace XbmcThreads
     {
       int count = lock.count;
       lock.count = 0;
+      lock.EndHold();
       cond.wait(lock.get_underlying(), std::move(predicate));
       lock.count = count;
+      lock.BeginHold();
     }
 
     inline void wait(CCriticalSection& lock)
     {
       int count  = lock.count;
       lock.count = 0;
+      lock.EndHold();
       cond.wait(lock.get_underlying());
       lock.count = count;
+      lock.BeginHold();
     }
 
     template<typename Rep, typename Period>
@@ -56,8 +60,10 @@ namespace XbmcThreads
     {
       int count = lock.count;
       lock.count = 0;
+      lock.EndHold();
       bool ret = cond.wait_for(lock.get_underlying(), duration, predicate);
       lock.count = count;
+      lock.BeginHold();
       return ret;
     }
 
@@ -66,8 +72,10 @@ namespace XbmcThreads
     {
       int count  = lock.count;
       lock.count = 0;
+      lock.EndHold();
       std::cv_status res = cond.wait_for(lock.get_underlying(), duration);
       lock.count = count;
+      lock.BeginHold();
       return res == std::cv_status::no_timeout;
     }
 
@@ -15,6 +15,12 @@
 
 class CCriticalSection : public XbmcThreads::CountingLockable<XbmcThreads::CRecursiveMutex>
 {
+public:
+  // the default arguments name the critical section after the code constructing it
+  explicit CCriticalSection(const char* file = __builtin_FILE(), unsigned int line = __builtin_LINE())
+    : CountingLockable(file, line)
+  {
+  }
 };
 
 #elif defined(TARGET_WINDOWS)
@@ -22,6 +28,12 @@ class CCriticalSection : public XbmcThreads::CountingLockable<XbmcThreads::CRecu
 
 class CCriticalSection : public XbmcThreads::CountingLockable<std::recursive_mutex>
 {
+public:
+  // the default arguments name the critical section after the code constructing it
+  explicit CCriticalSection(const char* file = __builtin_FILE(), unsigned int line = __builtin_LINE())
+    : CountingLockable(file, line)
+  {
+  }
 };
 
 #endif
@@ -74,8 +74,10 @@ namespace XbmcThreads
     return wait(std::chrono::milliseconds::max());
   }
 
-  CEventGroup::CEventGroup(std::initializer_list<CEvent*> eventsList)
-  : events{eventsList}
+  CEventGroup::CEventGroup(std::initializer_list<CEvent*> eventsList,
+                           const char* file,
+                           unsigned int line)
+    : events{eventsList}, mutex(file, line)
   {
     // we preping for a wait, so we need to set the group value on
     // all of the CEvents.
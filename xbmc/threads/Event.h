@@ -62,8 +62,11 @@ class CEvent
   CEvent& operator=(const CEvent&) = delete;
 
 public:
-  inline CEvent(bool manual = false, bool signaled_ = false)
-    : manualReset(manual), signaled(signaled_)
+  inline CEvent(bool manual = false,
+                bool signaled_ = false,
+                const char* file = __builtin_FILE(),
+                unsigned int line = __builtin_LINE())
+    : manualReset(manual), signaled(signaled_), groupListMutex(file, line), mutex(file, line)
   {
   }
 
@@ -162,7 +165,9 @@ public:
    * @brief Create a CEventGroup from a number of CEvents.
    *
    */
-  CEventGroup(std::initializer_list<CEvent*> events);
+  CEventGroup(std::initializer_list<CEvent*> events,
+              const char* file = __builtin_FILE(),
+              unsigned int line = __builtin_LINE());
 
   ~CEventGroup();
 
@@ -9,6 +9,7 @@
 #pragma once
 
 #include "threads/Thread.h"
+#include "threads/ThreadRoles.h"
 
 #include <memory>
 #include <string>
@@ -33,6 +34,21 @@ public:
    */
   virtual bool SetPriority(const ThreadPriority& priority) = 0;
 
+  /*!
+   * \brief Apply the placement policy of a thread role, must be called
+   *        from the thread itself. Returns false if any part of the
+   *        policy could not be applied.
+   *
+   */
+  virtual bool SetRolePolicy(const XbmcThreads::ThreadRolePolicy& policy) { return false; }
+
+  /*!
+   * \brief Describe where the thread is actually scheduled, empty if the
+   *        platform can't tell.
+   *
+   */
+  virtual std::string GetPlacement() const { return {}; }
+
 protected:
   IThreadImpl(std::thread::native_handle_type handle) : m_handle(handle) {}
 
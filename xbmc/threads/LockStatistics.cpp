@@ -0,0 +1,190 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "LockStatistics.h"
+
+#include "utils/log.h"
+
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+using namespace XbmcThreads;
+
+std::atomic<bool> CLockStatistics::m_enabled{false};
+
+namespace
+{
+struct SiteCounters
+{
+  uint64_t m_locks = 0;
+  uint64_t m_contentions = 0;
+  int64_t m_waitTime = 0;
+  int64_t m_maxWaitTime = 0;
+  int64_t m_holdTime = 0;
+  int64_t m_maxHoldTime = 0;
+};
+
+struct SiteKey
+{
+  const char* m_file;
+  unsigned int m_line;
+
+  bool operator==(const SiteKey& other) const
+  {
+    return m_file == other.m_file && m_line == other.m_line;
+  }
+};
+
+struct SiteKeyHash
+{
+  size_t operator()(const SiteKey& key) const
+  {
+    return std::hash<const void*>()(key.m_file) ^ (static_cast<size_t>(key.m_line) << 16);
+  }
+};
+
+/* The counters are spread over several maps, so that threads unlocking different critical
+   sections rarely wait for each other. These are plain std::mutex, locking a CCriticalSection
+   here would record statistics again. */
+struct Shard
+{
+  std::mutex m_mutex;
+  std::unordered_map<SiteKey, SiteCounters, SiteKeyHash> m_sites;
+};
+
+constexpr size_t SHARDS = 16;
+Shard shards[SHARDS];
+
+std::mutex logMutex;
+std::chrono::seconds logInterval{0};
+std::chrono::steady_clock::time_point nextLog;
+} // unnamed namespace
+
+void CLockStatistics::SetEnabled(bool enabled,
+                                 std::chrono::seconds interval /* = std::chrono::seconds::zero() */)
+{
+  {
+    std::unique_lock<std::mutex> lock(logMutex);
+    logInterval = interval;
+    nextLog = std::chrono::steady_clock::now() + interval;
+  }
+
+  if (enabled != m_enabled.exchange(enabled))
+    CLog::Log(LOGINFO, "CLockStatistics: lock contention statistics {}",
+              enabled ? "enabled" : "disabled");
+}
+
+void CLockStatistics::Record(
+    const char* file, unsigned int line, bool contended, int64_t waitTime, int64_t holdTime)
+{
+  const SiteKey key{file, line};
+  Shard& shard = shards[SiteKeyHash()(key) % SHARDS];
+
+  std::unique_lock<std::mutex> lock(shard.m_mutex);
+  SiteCounters& counters = shard.m_sites[key];
+  counters.m_locks++;
+  if (contended)
+    counters.m_contentions++;
+  counters.m_waitTime += waitTime;
+  counters.m_maxWaitTime = std::max(counters.m_maxWaitTime, waitTime);
+  counters.m_holdTime += holdTime;
+  counters.m_maxHoldTime = std::max(counters.m_maxHoldTime, holdTime);
+}
+
+std::vector<CLockStatistics::SiteStatistics> CLockStatistics::GetStatistics(
+    size_t maxSites /* = 0 */)
+{
+  // the same file may be named by different pointers in different translation units
+  std::map<std::pair<std::string, unsigned int>, SiteCounters> sites;
+  for (Shard& shard : shards)
+  {
+    std::unique_lock<std::mutex> lock(shard.m_mutex);
+    for (const auto& site : shard.m_sites)
+    {
+      SiteCounters& counters = sites[{site.first.m_file, site.first.m_line}];
+      counters.m_locks += site.second.m_locks;
+      counters.m_contentions += site.second.m_contentions;
+      counters.m_waitTime += site.second.m_waitTime;
+      counters.m_maxWaitTime = std::max(counters.m_maxWaitTime, site.second.m_maxWaitTime);
+      counters.m_holdTime += site.second.m_holdTime;
+      counters.m_maxHoldTime = std::max(counters.m_maxHoldTime, site.second.m_maxHoldTime);
+    }
+  }
+
+  std::vector<SiteStatistics> statistics;
+  statistics.reserve(sites.size());
+  for (const auto& site : sites)
+  {
+    SiteStatistics stats;
+    stats.m_site = site.first.first + ":" + std::to_string(site.first.second);
+    stats.m_locks = site.second.m_locks;
+    stats.m_contentions = site.second.m_contentions;
+    stats.m_waitTime = std::chrono::nanoseconds(site.second.m_waitTime);
+    stats.m_maxWaitTime = std::chrono::nanoseconds(site.second.m_maxWaitTime);
+    stats.m_holdTime = std::chrono::nanoseconds(site.second.m_holdTime);
+    stats.m_maxHoldTime = std::chrono::nanoseconds(site.second.m_maxHoldTime);
+    statistics.emplace_back(std::move(stats));
+  }
+
+  std::sort(statistics.begin(), statistics.end(),
+            [](const SiteStatistics& a, const SiteStatistics& b) {
+              return a.m_waitTime > b.m_waitTime;
+            });
+  if (maxSites > 0 && statistics.size() > maxSites)
+    statistics.resize(maxSites);
+
+  return statistics;
+}
+
+void CLockStatistics::Reset()
+{
+  for (Shard& shard : shards)
+  {
+    std::unique_lock<std::mutex> lock(shard.m_mutex);
+    shard.m_sites.clear();
+  }
+}
+
+void CLockStatistics::Process()
+{
+  if (!IsEnabled())
+    return;
+
+  {
+    std::unique_lock<std::mutex> lock(logMutex);
+    const auto now = std::chrono::steady_clock::now();
+    if (logInterval == std::chrono::seconds::zero() || now < nextLog)
+      return;
+    nextLog = now + logInterval;
+  }
+
+  Log(20);
+}
+
+void CLockStatistics::Log(size_t maxSites)
+{
+  using namespace std::chrono;
+
+  const auto statistics = GetStatistics(maxSites);
+  CLog::Log(LOGINFO, "CLockStatistics: {} most contended critical sections", statistics.size());
+  for (const auto& site : statistics)
+  {
+    CLog::Log(LOGINFO,
+              "CLockStatistics: {} locks: {} contended: {} wait: {} ms (max {} us) hold: {} ms "
+              "(max {} us)",
+              site.m_site, site.m_locks, site.m_contentions,
+              duration_cast<milliseconds>(site.m_waitTime).count(),
+              duration_cast<microseconds>(site.m_maxWaitTime).count(),
+              duration_cast<milliseconds>(site.m_holdTime).count(),
+              duration_cast<microseconds>(site.m_maxHoldTime).count());
+  }
+}
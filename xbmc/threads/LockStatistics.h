@@ -0,0 +1,85 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace XbmcThreads
+{
+
+/*!
+ \brief Contention statistics of CCriticalSection, collected per construction site.
+
+ Collection is off by default. While it is off locking costs one relaxed atomic load more than
+ before. While it is on every outermost lock and unlock of a critical section takes two clock
+ reads, and the statistics of its construction site are updated after it has been unlocked.
+
+ Critical sections are named after the place they were constructed, which for members is the
+ constructor of the owning class. CEvent, CSharedSection and CThread pass the place they were
+ constructed at on to the critical sections they own. Waiting on a condition variable ends a hold, and the time spent
+ waiting is not recorded.
+ */
+class CLockStatistics
+{
+public:
+  struct SiteStatistics
+  {
+    std::string m_site; ///< "file:line" the critical section was constructed at
+    uint64_t m_locks{0};
+    uint64_t m_contentions{0}; ///< locks which had to wait for another thread
+    std::chrono::nanoseconds m_waitTime{0};
+    std::chrono::nanoseconds m_maxWaitTime{0};
+    std::chrono::nanoseconds m_holdTime{0};
+    std::chrono::nanoseconds m_maxHoldTime{0};
+  };
+
+  static bool IsEnabled() { return m_enabled.load(std::memory_order_relaxed); }
+
+  /*!
+   \brief Start or stop collecting statistics.
+   \param enabled whether to collect statistics.
+   \param logInterval interval to log the most contended sites at, zero to never log them.
+   */
+  static void SetEnabled(bool enabled,
+                         std::chrono::seconds logInterval = std::chrono::seconds::zero());
+
+  /*!
+   \brief Get the collected statistics, sorted by total wait time, most contended first.
+   \param maxSites maximum number of sites to return, zero for all of them.
+   */
+  static std::vector<SiteStatistics> GetStatistics(size_t maxSites = 0);
+
+  static void Reset();
+
+  /*!
+   \brief Log the most contended sites if the log interval passed since they were last logged.
+   */
+  static void Process();
+
+  static int64_t Now()
+  {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+  }
+
+  static void Record(
+      const char* file, unsigned int line, bool contended, int64_t waitTime, int64_t holdTime);
+
+private:
+  static void Log(size_t maxSites);
+
+  static std::atomic<bool> m_enabled;
+};
+
+} // namespace XbmcThreads
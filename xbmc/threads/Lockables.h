@@ -8,6 +8,8 @@
 
 #pragma once
 
+#include "threads/LockStatistics.h"
+
 namespace XbmcThreads
 {
 
@@ -32,6 +34,9 @@ namespace XbmcThreads
    * undo it, and then restore that (See class CSingleExit).
    *
    * All xbmc code expects Lockables to be recursive.
+   *
+   * While CLockStatistics is enabled the wait and hold times of the outermost
+   * lock are recorded for the site the Lockable was constructed at.
    */
   template<class L> class CountingLockable
   {
@@ -43,13 +48,106 @@ namespace XbmcThreads
     L mutex;
     unsigned int count = 0;
 
+  private:
+    const char* m_file;
+    unsigned int m_line;
+    // only accessed by the thread holding the lock
+    int64_t m_acquired = 0;
+    int64_t m_waitTime = 0;
+    bool m_contended = false;
+
+    void ProfiledLock()
+    {
+      bool contended = false;
+      int64_t waitTime = 0;
+      if (!mutex.try_lock())
+      {
+        contended = true;
+        const int64_t start = CLockStatistics::Now();
+        mutex.lock();
+        waitTime = CLockStatistics::Now() - start;
+      }
+      if (count++ == 0)
+      {
+        m_acquired = CLockStatistics::Now();
+        m_waitTime = waitTime;
+        m_contended = contended;
+      }
+    }
+
+    void ProfiledUnlock()
+    {
+      const int64_t holdTime = CLockStatistics::Now() - m_acquired;
+      const int64_t waitTime = m_waitTime;
+      const bool contended = m_contended;
+      m_acquired = 0;
+      count--;
+      mutex.unlock();
+      CLockStatistics::Record(m_file, m_line, contended, waitTime, holdTime);
+    }
+
+    // A condition variable unlocks the mutex while waiting, so the hold ends before the wait and
+    // a new one begins once the mutex is locked again.
+    void EndHold()
+    {
+      if (m_acquired == 0)
+        return;
+      const int64_t holdTime = CLockStatistics::Now() - m_acquired;
+      m_acquired = 0;
+      CLockStatistics::Record(m_file, m_line, m_contended, m_waitTime, holdTime);
+    }
+
+    void BeginHold()
+    {
+      if (CLockStatistics::IsEnabled())
+      {
+        m_acquired = CLockStatistics::Now();
+        m_waitTime = 0;
+        m_contended = false;
+      }
+    }
+
   public:
-    inline CountingLockable() = default;
+    inline explicit CountingLockable(const char* file = __builtin_FILE(),
+                                      unsigned int line = __builtin_LINE())
+      : m_file(file), m_line(line)
+    {
+    }
 
     // STL Lockable concept
-    inline void lock() { mutex.lock(); count++; }
-    inline bool try_lock() { return mutex.try_lock() ? count++, true : false; }
-    inline void unlock() { count--; mutex.unlock(); }
+    inline void lock()
+    {
+      if (CLockStatistics::IsEnabled())
+        ProfiledLock();
+      else
+      {
+        mutex.lock();
+        count++;
+      }
+    }
+    inline bool try_lock()
+    {
+      if (!mutex.try_lock())
+        return false;
+      if (count++ == 0 && CLockStatistics::IsEnabled())
+      {
+        m_acquired = CLockStatistics::Now();
+        m_waitTime = 0;
+        m_contended = false;
+      }
+      return true;
+    }
+    inline void unlock()
+    {
+      // m_acquired is only set if statistics were enabled when the lock was taken
+      if (count == 1 && m_acquired != 0)
+        ProfiledUnlock();
+      else
+      {
+        count--;
+        mutex.unlock();
+      }
+    }
 
     /*!
      * \brief Check if have a lock owned
@@ -15,33 +15,128 @@
 
 /**
  * A CSharedSection is a mutex that satisfies the Shared Lockable concept (see Lockables.h).
+ *
+ * By default shared locks are granted while a thread waits for an exclusive lock, so a steady
+ * stream of readers can starve writers. A section preferring writers makes new readers wait
+ * while a writer is waiting instead. The thread holding the exclusive lock can always take
+ * shared and exclusive locks recursively, but with writers preferred a thread taking a second
+ * shared lock while a writer waits deadlocks. The upgradable lock counts as a shared lock here.
+ *
+ * Besides shared and exclusive locks a section supports one upgradable lock at a time. It
+ * coexists with shared locks but excludes writers and other upgradable locks, and can be turned
+ * into an exclusive lock without letting another writer in between (see CUpgradableLock).
+ * Upgrading while holding a shared lock on the same section deadlocks.
  */
 class CSharedSection
 {
+public:
+  enum class Preference
+  {
+    READERS,
+    WRITERS,
+  };
+
+private:
   CCriticalSection sec;
+  // held by writers and the upgradable lock, so that upgrading can't be overtaken by a writer
+  CCriticalSection upgradeSec;
   XbmcThreads::ConditionVariable actualCv;
 
+  const Preference preference;
   unsigned int sharedCount = 0;
+  unsigned int waitingWriters = 0;
+  unsigned int exclusiveCount = 0;
+
+  // must be called with sec locked once by this thread
+  inline void waitForReaders(std::unique_lock<CCriticalSection>& l)
+  {
+    if (sharedCount)
+    {
+      waitingWriters++;
+      actualCv.wait(l, [this]() { return sharedCount == 0; });
+      waitingWriters--;
+      if (!waitingWriters)
+        actualCv.notifyAll(); // let readers waiting for writers in
+    }
+  }
+
+  // readers only wait for writers if they don't hold the exclusive lock themselves
+  inline bool mustWaitForWriters() const
+  {
+    return preference == Preference::WRITERS && waitingWriters && !exclusiveCount;
+  }
 
 public:
-  inline CSharedSection() = default;
+  inline explicit CSharedSection(Preference preference_ = Preference::READERS,
+                                 const char* file = __builtin_FILE(),
+                                 unsigned int line = __builtin_LINE())
+    : sec(file, line), upgradeSec(file, line), preference(preference_)
+  {
+  }
 
   inline void lock()
   {
-    std::unique_lock<CCriticalSection> l(sec);
-    while (sharedCount)
-      actualCv.wait(l, [this]() { return sharedCount == 0; });
+    std::unique_lock<CCriticalSection> l(sec, std::defer_lock);
+    if (!upgradeSec.try_lock())
+    {
+      // waiting for another writer or the upgradable lock counts as waiting for readers too, so
+      // new readers don't get in meanwhile if writers are preferred
+      l.lock();
+      waitingWriters++;
+      l.unlock();
+      upgradeSec.lock();
+      l.lock();
+      waitingWriters--;
+      if (!waitingWriters)
+        actualCv.notifyAll(); // let readers waiting for writers in
+    }
+    else
+      l.lock();
+    if (!exclusiveCount)
+      waitForReaders(l);
     sec.lock();
+    exclusiveCount++;
+  }
+  inline bool try_lock()
+  {
+    if (!upgradeSec.try_lock())
+      return false;
+    if (sec.try_lock())
+    {
+      if (sharedCount == 0 || exclusiveCount)
+      {
+        exclusiveCount++;
+        return true;
+      }
+      sec.unlock();
+    }
+    upgradeSec.unlock();
+    return false;
+  }
+  inline void unlock()
+  {
+    exclusiveCount--;
+    sec.unlock();
+    upgradeSec.unlock();
   }
-  inline bool try_lock() { return (sec.try_lock() ? ((sharedCount == 0) ? true : (sec.unlock(), false)) : false); }
-  inline void unlock() { sec.unlock(); }
 
   inline void lock_shared()
   {
     std::unique_lock<CCriticalSection> l(sec);
+    if (mustWaitForWriters())
+      actualCv.wait(l, [this]() { return !mustWaitForWriters(); });
     sharedCount++;
   }
-  inline bool try_lock_shared() { return (sec.try_lock() ? sharedCount++, sec.unlock(), true : false); }
+  inline bool try_lock_shared()
+  {
+    if (!sec.try_lock())
+      return false;
+    const bool locked = !mustWaitForWriters();
+    if (locked)
+      sharedCount++;
+    sec.unlock();
+    return locked;
+  }
   inline void unlock_shared()
   {
     std::unique_lock<CCriticalSection> l(sec);
@@ -51,4 +146,67 @@ public:
       actualCv.notifyAll();
     }
   }
+
+  inline void lock_upgrade()
+  {
+    upgradeSec.lock();
+    std::unique_lock<CCriticalSection> l(sec);
+    sharedCount++;
+  }
+  inline void unlock_upgrade()
+  {
+    unlock_shared();
+    upgradeSec.unlock();
+  }
+  /**
+   * Turn the upgradable lock into an exclusive lock, released with unlock().
+   */
+  inline void unlock_upgrade_and_lock()
+  {
+    std::unique_lock<CCriticalSection> l(sec);
+    sharedCount--;
+    waitForReaders(l);
+    sec.lock();
+    exclusiveCount++;
+  }
+};
+
+/**
+ * Holds the upgradable lock of a CSharedSection and releases it, or the exclusive lock it was
+ * upgraded to, when going out of scope.
+ */
+class CUpgradableLock
+{
+public:
+  inline explicit CUpgradableLock(CSharedSection& section) : m_section(section)
+  {
+    m_section.lock_upgrade();
+  }
+  inline ~CUpgradableLock()
+  {
+    if (m_upgraded)
+      m_section.unlock();
+    else
+      m_section.unlock_upgrade();
+  }
+
+  CUpgradableLock(const CUpgradableLock&) = delete;
+  CUpgradableLock& operator=(const CUpgradableLock&) = delete;
+
+  /**
+   * Wait for all readers to leave and take the exclusive lock.
+   */
+  inline void Upgrade()
+  {
+    if (!m_upgraded)
+    {
+      m_section.unlock_upgrade_and_lock();
+      m_upgraded = true;
+    }
+  }
+  inline bool IsUpgraded() const { return m_upgraded; }
+
+private:
+  CSharedSection& m_section;
+  bool m_upgraded = false;
 };
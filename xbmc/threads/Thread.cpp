@@ -14,6 +14,7 @@
 #include "commons/Exception.h"
 #include "threads/IThreadImpl.h"
 #include "threads/SingleLock.h"
+#include "threads/ThreadRoles.h"
 #include "utils/log.h"
 
 #include <atomic>
@@ -35,17 +36,23 @@ static thread_local CThread* currentThread;
 // Construction/Destruction
 //////////////////////////////////////////////////////////////////////
 
-CThread::CThread(const char* ThreadName)
-:
-    m_bStop(false), m_StopEvent(true, true), m_StartEvent(true, true), m_pRunnable(nullptr)
+CThread::CThread(const char* ThreadName, const char* file, unsigned int line)
+  : m_bStop(false),
+    m_StopEvent(true, true, file, line),
+    m_StartEvent(true, true, file, line),
+    m_CriticalSection(file, line),
+    m_pRunnable(nullptr)
 {
   if (ThreadName)
     m_ThreadName = ThreadName;
 }
 
-CThread::CThread(IRunnable* pRunnable, const char* ThreadName)
-:
-    m_bStop(false), m_StopEvent(true, true), m_StartEvent(true, true), m_pRunnable(pRunnable)
+CThread::CThread(IRunnable* pRunnable, const char* ThreadName, const char* file, unsigned int line)
+  : m_bStop(false),
+    m_StopEvent(true, true, file, line),
+    m_StartEvent(true, true, file, line),
+    m_CriticalSection(file, line),
+    m_pRunnable(pRunnable)
 {
   if (ThreadName)
     m_ThreadName = ThreadName;
@@ -126,6 +133,7 @@ void CThread::Create(bool bAutoDelete)
 
         pThread->m_impl = IThreadImpl::CreateThreadImpl(pThread->m_thread->native_handle());
         pThread->m_impl->SetThreadInfo(pThread->m_ThreadName);
+        pThread->ApplyRole();
 
         CLog::Log(LOGDEBUG, "Thread {} start, auto delete: {}", pThread->m_ThreadName,
                   (pThread->m_bAutoDelete ? "true" : "false"));
@@ -178,9 +186,44 @@ bool CThread::IsRunning() const
 
 bool CThread::SetPriority(const ThreadPriority& priority)
 {
+  if (m_roleControlsPriority)
+  {
+    CLog::Log(LOGDEBUG, "Thread {} priority is set by its role", m_ThreadName);
+    return false;
+  }
+
   return m_impl->SetPriority(priority);
 }
 
+void CThread::SetRole(ThreadRole role)
+{
+  m_role = role;
+  if (IsCurrentThread())
+    ApplyRole();
+}
+
+void CThread::ApplyRole()
+{
+  using XbmcThreads::CThreadRoles;
+
+  const ThreadRole role = CThreadRoles::GetThreadRole(m_ThreadName, m_role);
+  const XbmcThreads::ThreadRolePolicy policy = CThreadRoles::GetPolicy(role);
+  if (policy.IsEmpty())
+  {
+    m_roleControlsPriority = false;
+    return;
+  }
+
+  const bool applied = m_impl->SetRolePolicy(policy);
+  m_roleControlsPriority = applied && policy.ControlsPriority();
+  if (!applied)
+    CLog::Log(LOGWARNING, "Thread {} could not be fully placed as {} thread", m_ThreadName,
+              CThreadRoles::GetRoleName(role));
+
+  CLog::Log(LOGINFO, "Thread {} role: {} placement: {}", m_ThreadName,
+            CThreadRoles::GetRoleName(role), m_impl->GetPlacement());
+}
+
 bool CThread::IsAutoDelete() const
 {
   return m_bAutoDelete;
@@ -39,15 +39,39 @@ enum class ThreadPriority
   PRIORITY_COUNT,
 };
 
+/*!
+ * \brief What a thread does, which decides where it is scheduled (see XbmcThreads::CThreadRoles).
+ *
+ */
+enum class ThreadRole
+{
+  DEFAULT,
+  REALTIME, ///< must meet deadlines, e.g. audio output
+  INTERACTIVE, ///< the user waits for it, e.g. video decoding
+  BACKGROUND, ///< nobody waits for it, e.g. library scanning
+
+  /*!
+   * \brief Do not use this for a role. It is only needed to count the
+   *        amount of values in the ThreadRole enum.
+   *
+   */
+  ROLE_COUNT,
+};
+
 class IRunnable;
 class IThreadImpl;
 class CThread
 {
 protected:
-  explicit CThread(const char* ThreadName);
+  explicit CThread(const char* ThreadName,
+                   const char* file = __builtin_FILE(),
+                   unsigned int line = __builtin_LINE());
 
 public:
-  CThread(IRunnable* pRunnable, const char* ThreadName);
+  CThread(IRunnable* pRunnable,
+          const char* ThreadName,
+          const char* file = __builtin_FILE(),
+          unsigned int line = __builtin_LINE());
   virtual ~CThread();
   void Create(bool bAutoDelete = false);
 
@@ -79,6 +103,16 @@ public:
    */
   bool SetPriority(const ThreadPriority& priority);
 
+  /*!
+   * \brief Set the role of the thread. The placement policy of the role
+   *        is applied when the thread starts, or right away when called
+   *        from the running thread itself.
+   *        While the policy sets a nice value or a scheduling policy
+   *        SetPriority() is ignored.
+   *
+   */
+  void SetRole(ThreadRole role);
+
   static CThread* GetCurrentThread();
 
   virtual void OnException(){} // signal termination handler
@@ -110,6 +144,7 @@ protected:
 
 private:
   void Action();
+  void ApplyRole();
 
   bool m_bAutoDelete = false;
   CEvent m_StopEvent;
@@ -122,4 +157,7 @@ private:
   std::future<bool> m_future;
 
   std::unique_ptr<IThreadImpl> m_impl;
+
+  ThreadRole m_role = ThreadRole::DEFAULT;
+  std::atomic<bool> m_roleControlsPriority{false};
 };
@@ -0,0 +1,192 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "ThreadRoles.h"
+
+#include "threads/CriticalSection.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <utility>
+
+using namespace XbmcThreads;
+
+namespace
+{
+constexpr size_t ROLE_COUNT = static_cast<size_t>(ThreadRole::ROLE_COUNT);
+
+struct RoleName
+{
+  ThreadRole m_role;
+  const char* m_name;
+};
+
+constexpr std::array<RoleName, ROLE_COUNT> roleNames = {{
+    {ThreadRole::DEFAULT, "default"},
+    {ThreadRole::REALTIME, "realtime"},
+    {ThreadRole::INTERACTIVE, "interactive"},
+    {ThreadRole::BACKGROUND, "background"},
+}};
+
+struct PolicyName
+{
+  SchedulingPolicy m_policy;
+  const char* m_name;
+};
+
+constexpr std::array<PolicyName, 6> policyNames = {{
+    {SchedulingPolicy::DEFAULT, "default"},
+    {SchedulingPolicy::OTHER, "other"},
+    {SchedulingPolicy::BATCH, "batch"},
+    {SchedulingPolicy::IDLE, "idle"},
+    {SchedulingPolicy::FIFO, "fifo"},
+    {SchedulingPolicy::RR, "rr"},
+}};
+
+CCriticalSection rolesSection;
+std::array<ThreadRolePolicy, ROLE_COUNT> policies;
+std::map<std::string, ThreadRole> threadRoles;
+
+bool ParseCpu(const std::string& text, unsigned int& cpu)
+{
+  if (text.empty() || text.find_first_not_of("0123456789") != std::string::npos ||
+      text.size() > 4)
+    return false;
+  cpu = static_cast<unsigned int>(std::strtoul(text.c_str(), nullptr, 10));
+  return true;
+}
+} // unnamed namespace
+
+void CThreadRoles::SetPolicy(ThreadRole role, const ThreadRolePolicy& policy)
+{
+  std::unique_lock<CCriticalSection> lock(rolesSection);
+  policies[static_cast<size_t>(role)] = policy;
+}
+
+ThreadRolePolicy CThreadRoles::GetPolicy(ThreadRole role)
+{
+  std::unique_lock<CCriticalSection> lock(rolesSection);
+  return policies[static_cast<size_t>(role)];
+}
+
+void CThreadRoles::SetThreadRole(const std::string& threadName, ThreadRole role)
+{
+  std::unique_lock<CCriticalSection> lock(rolesSection);
+  threadRoles[threadName] = role;
+}
+
+ThreadRole CThreadRoles::GetThreadRole(const std::string& threadName, ThreadRole role)
+{
+  std::unique_lock<CCriticalSection> lock(rolesSection);
+  const auto it = threadRoles.find(threadName);
+  return it != threadRoles.end() ? it->second : role;
+}
+
+void CThreadRoles::Reset()
+{
+  std::unique_lock<CCriticalSection> lock(rolesSection);
+  policies.fill(ThreadRolePolicy());
+  threadRoles.clear();
+}
+
+const char* CThreadRoles::GetRoleName(ThreadRole role)
+{
+  for (const auto& roleName : roleNames)
+  {
+    if (roleName.m_role == role)
+      return roleName.m_name;
+  }
+  return "unknown";
+}
+
+std::optional<ThreadRole> CThreadRoles::ParseRole(const std::string& name)
+{
+  for (const auto& roleName : roleNames)
+  {
+    if (name == roleName.m_name)
+      return roleName.m_role;
+  }
+  return {};
+}
+
+const char* CThreadRoles::GetPolicyName(SchedulingPolicy policy)
+{
+  for (const auto& policyName : policyNames)
+  {
+    if (policyName.m_policy == policy)
+      return policyName.m_name;
+  }
+  return "unknown";
+}
+
+std::optional<SchedulingPolicy> CThreadRoles::ParsePolicy(const std::string& name)
+{
+  for (const auto& policyName : policyNames)
+  {
+    if (name == policyName.m_name)
+      return policyName.m_policy;
+  }
+  return {};
+}
+
+bool CThreadRoles::ParseCpus(const std::string& list, std::vector<unsigned int>& cpus)
+{
+  std::vector<unsigned int> result;
+  size_t start = 0;
+  while (start <= list.size())
+  {
+    size_t end = list.find(',', start);
+    if (end == std::string::npos)
+      end = list.size();
+    const std::string range = list.substr(start, end - start);
+
+    unsigned int first;
+    unsigned int last;
+    const size_t dash = range.find('-');
+    if (dash == std::string::npos)
+    {
+      if (!ParseCpu(range, first))
+        return false;
+      last = first;
+    }
+    else if (!ParseCpu(range.substr(0, dash), first) || !ParseCpu(range.substr(dash + 1), last) ||
+             last < first)
+      return false;
+
+    for (unsigned int cpu = first; cpu <= last; cpu++)
+      result.push_back(cpu);
+    start = end + 1;
+  }
+
+  std::sort(result.begin(), result.end());
+  result.erase(std::unique(result.begin(), result.end()), result.end());
+  cpus = std::move(result);
+  return true;
+}
+
+std::string CThreadRoles::FormatCpus(const std::vector<unsigned int>& cpus)
+{
+  std::string list;
+  for (size_t i = 0; i < cpus.size();)
+  {
+    size_t last = i;
+    while (last + 1 < cpus.size() && cpus[last + 1] == cpus[last] + 1)
+      last++;
+
+    if (!list.empty())
+      list += ',';
+    list += std::to_string(cpus[i]);
+    if (last > i)
+      list += '-' + std::to_string(cpus[last]);
+    i = last + 1;
+  }
+  return list;
+}
@@ -0,0 +1,101 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/Thread.h"
+
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace XbmcThreads
+{
+
+enum class SchedulingPolicy
+{
+  DEFAULT, ///< leave the policy the thread inherited
+  OTHER,
+  BATCH,
+  IDLE,
+  FIFO,
+  RR,
+};
+
+/*!
+ \brief How the threads of a role are placed, see CThreadRoles.
+ */
+struct ThreadRolePolicy
+{
+  std::vector<unsigned int> m_cpus; ///< cpus the threads may run on, empty for all of them
+  std::optional<int> m_nice; ///< nice value relative to the one of the application
+  SchedulingPolicy m_policy{SchedulingPolicy::DEFAULT};
+  int m_realtimePriority{1}; ///< priority for the FIFO and RR policies
+
+  bool IsEmpty() const
+  {
+    return m_cpus.empty() && !m_nice && m_policy == SchedulingPolicy::DEFAULT;
+  }
+  bool ControlsPriority() const { return m_nice || m_policy != SchedulingPolicy::DEFAULT; }
+};
+
+/*!
+ \brief Placement policies of the thread roles.
+
+ Threads declare their role with CThread::SetRole(), the policy of that role is applied when the
+ thread starts. No role has a policy by default, they are configured from advancedsettings.xml.
+ The role of a thread may also be overridden there by its name:
+
+ \code{.xml}
+ <threadroles>
+   <realtime>
+     <cpus>2-3</cpus>
+     <policy>fifo</policy>
+     <priority>10</priority>
+   </realtime>
+   <background>
+     <cpus>0-1</cpus>
+     <nice>10</nice>
+     <policy>batch</policy>
+   </background>
+   <thread name="FileCache">background</thread>
+ </threadroles>
+ \endcode
+
+ Threads started before advancedsettings.xml is loaded keep their placement.
+ */
+class CThreadRoles
+{
+public:
+  static void SetPolicy(ThreadRole role, const ThreadRolePolicy& policy);
+  static ThreadRolePolicy GetPolicy(ThreadRole role);
+
+  static void SetThreadRole(const std::string& threadName, ThreadRole role);
+  /*!
+   \brief Get the role of a thread, the one configured for its name if there is one.
+   \param threadName name of the thread.
+   \param role role the thread declared itself.
+   */
+  static ThreadRole GetThreadRole(const std::string& threadName, ThreadRole role);
+
+  static void Reset();
+
+  static const char* GetRoleName(ThreadRole role);
+  static std::optional<ThreadRole> ParseRole(const std::string& name);
+  static const char* GetPolicyName(SchedulingPolicy policy);
+  static std::optional<SchedulingPolicy> ParsePolicy(const std::string& name);
+
+  /*!
+   \brief Parse a cpu list like "0-3,6".
+   \return false if the list is malformed.
+   */
+  static bool ParseCpus(const std::string& list, std::vector<unsigned int>& cpus);
+  static std::string FormatCpus(const std::vector<unsigned int>& cpus);
+};
+
+} // namespace XbmcThreads
@@ -0,0 +1,164 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "threads/Condition.h"
+#include "threads/CriticalSection.h"
+#include "threads/LockStatistics.h"
+#include "threads/SharedSection.h"
+
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace XbmcThreads;
+using namespace std::chrono_literals;
+
+namespace
+{
+const CLockStatistics::SiteStatistics* FindSite(
+    const std::vector<CLockStatistics::SiteStatistics>& statistics, const std::string& site)
+{
+  const auto it = std::find_if(statistics.begin(), statistics.end(),
+                               [&site](const CLockStatistics::SiteStatistics& stats) {
+                                 return stats.m_site == site;
+                               });
+  return it != statistics.end() ? &*it : nullptr;
+}
+
+class TestLockStatistics : public testing::Test
+{
+protected:
+  TestLockStatistics() { CLockStatistics::Reset(); }
+  ~TestLockStatistics() override
+  {
+    CLockStatistics::SetEnabled(false);
+    CLockStatistics::Reset();
+  }
+};
+} // namespace
+
+TEST_F(TestLockStatistics, DisabledRecordsNothing)
+{
+  CCriticalSection section(__FILE__, 1);
+  {
+    std::unique_lock<CCriticalSection> lock(section);
+  }
+
+  EXPECT_EQ(nullptr, FindSite(CLockStatistics::GetStatistics(), std::string(__FILE__) + ":1"));
+}
+
+TEST_F(TestLockStatistics, RecordsOutermostLocks)
+{
+  CLockStatistics::SetEnabled(true);
+
+  CCriticalSection section(__FILE__, 2);
+  for (int i = 0; i < 10; i++)
+  {
+    std::unique_lock<CCriticalSection> lock(section);
+    std::unique_lock<CCriticalSection> recursive(section);
+  }
+
+  const auto* site = FindSite(CLockStatistics::GetStatistics(), std::string(__FILE__) + ":2");
+  ASSERT_NE(nullptr, site);
+  EXPECT_EQ(10u, site->m_locks);
+  EXPECT_EQ(0u, site->m_contentions);
+}
+
+TEST_F(TestLockStatistics, RecordsContention)
+{
+  CLockStatistics::SetEnabled(true);
+
+  CCriticalSection section(__FILE__, 3);
+  std::unique_lock<CCriticalSection> lock(section);
+
+  std::thread waiter([&section]() { std::unique_lock<CCriticalSection> lock(section); });
+  std::this_thread::sleep_for(50ms);
+  lock.unlock();
+  waiter.join();
+
+  const auto* site = FindSite(CLockStatistics::GetStatistics(), std::string(__FILE__) + ":3");
+  ASSERT_NE(nullptr, site);
+  EXPECT_EQ(2u, site->m_locks);
+  EXPECT_EQ(1u, site->m_contentions);
+  EXPECT_GE(site->m_maxWaitTime, 20ms);
+  EXPECT_GE(site->m_maxHoldTime, 20ms);
+}
+
+TEST_F(TestLockStatistics, NamedAfterConstructingCode)
+{
+  CLockStatistics::SetEnabled(true);
+
+  const unsigned int line = __LINE__ + 1;
+  CCriticalSection section;
+  {
+    std::unique_lock<CCriticalSection> lock(section);
+  }
+
+  EXPECT_NE(nullptr, FindSite(CLockStatistics::GetStatistics(),
+                              std::string(__FILE__) + ":" + std::to_string(line)));
+}
+
+TEST_F(TestLockStatistics, WrappersNamedAfterConstructingCode)
+{
+  CLockStatistics::SetEnabled(true);
+
+  const unsigned int line = __LINE__ + 1;
+  CSharedSection section;
+  {
+    std::unique_lock<CSharedSection> lock(section);
+  }
+
+  EXPECT_NE(nullptr, FindSite(CLockStatistics::GetStatistics(),
+                              std::string(__FILE__) + ":" + std::to_string(line)));
+}
+
+TEST_F(TestLockStatistics, WaitEndsHold)
+{
+  CLockStatistics::SetEnabled(true);
+
+  CCriticalSection section(__FILE__, 4);
+  ConditionVariable cv;
+  {
+    std::unique_lock<CCriticalSection> lock(section);
+    cv.wait(lock, 100ms);
+  }
+
+  const auto* site = FindSite(CLockStatistics::GetStatistics(), std::string(__FILE__) + ":4");
+  ASSERT_NE(nullptr, site);
+  EXPECT_EQ(2u, site->m_locks);
+  EXPECT_LT(site->m_maxHoldTime, 50ms);
+}
+
+TEST_F(TestLockStatistics, LockCost)
+{
+  const int iterations = 1000000;
+  CCriticalSection section;
+
+  auto measure = [&]() {
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++)
+    {
+      std::unique_lock<CCriticalSection> lock(section);
+    }
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now() - start)
+               .count() /
+           iterations;
+  };
+
+  const auto disabled = measure();
+  CLockStatistics::SetEnabled(true);
+  const auto enabled = measure();
+
+  RecordProperty("DisabledNsPerLock", static_cast<int>(disabled));
+  RecordProperty("EnabledNsPerLock", static_cast<int>(enabled));
+}
@@ -11,9 +11,14 @@
 #include "threads/SharedSection.h"
 #include "threads/test/TestHelpers.h"
 
+#include <functional>
+#include <future>
+#include <memory>
 #include <mutex>
 #include <shared_mutex>
 #include <stdio.h>
+#include <thread>
+#include <vector>
 
 using namespace std::chrono_literals;
 
@@ -213,3 +218,216 @@ TEST(TestMultipleSharedSection, General)
   }
 }
 
+
+TEST(TestSharedSection, WriterPreference)
+{
+  std::atomic<long> mutex(0L);
+  CEvent event;
+
+  CSharedSection sec(CSharedSection::Preference::WRITERS);
+
+  std::shared_lock<CSharedSection> l1(sec); // get a shared lock
+
+  locker<std::unique_lock<CSharedSection>> l2(sec, &mutex);
+  thread waitThread1(l2); // try to get an exclusive lock
+
+  EXPECT_TRUE(waitForThread(mutex, 1, 10000ms));
+  std::this_thread::sleep_for(10ms);
+  EXPECT_TRUE(!l2.obtainedlock);
+
+  // a new reader has to wait for the waiting writer
+  locker<std::shared_lock<CSharedSection>> l3(sec, &mutex);
+  thread waitThread3(l3);
+  EXPECT_TRUE(waitForThread(mutex, 2, 10000ms));
+  std::this_thread::sleep_for(10ms);
+  EXPECT_TRUE(!l3.obtainedlock);
+  EXPECT_FALSE(sec.try_lock_shared());
+
+  l1.unlock(); // the last shared lock leaves
+
+  EXPECT_TRUE(waitThread1.timed_join(10000ms));
+  EXPECT_TRUE(l2.obtainedlock);
+  EXPECT_TRUE(waitThread3.timed_join(10000ms));
+  EXPECT_TRUE(l3.obtainedlock);
+}
+
+TEST(TestSharedSection, WriterPreferenceBehindUpgradableLock)
+{
+  std::atomic<long> mutex(0L);
+
+  CSharedSection sec(CSharedSection::Preference::WRITERS);
+
+  auto upgradable = std::make_unique<CUpgradableLock>(sec);
+
+  locker<std::unique_lock<CSharedSection>> l1(sec, &mutex);
+  thread waitThread1(l1); // try to get an exclusive lock
+
+  EXPECT_TRUE(waitForThread(mutex, 1, 10000ms));
+  std::this_thread::sleep_for(10ms);
+  EXPECT_TRUE(!l1.obtainedlock);
+
+  // a writer waiting for the upgradable lock keeps new readers out as well
+  EXPECT_FALSE(sec.try_lock_shared());
+
+  upgradable.reset();
+
+  EXPECT_TRUE(waitThread1.timed_join(10000ms));
+  EXPECT_TRUE(l1.obtainedlock);
+  EXPECT_TRUE(sec.try_lock_shared());
+  sec.unlock_shared();
+}
+
+TEST(TestSharedSection, WriterPreferenceRecursiveExclusive)
+{
+  CSharedSection sec(CSharedSection::Preference::WRITERS);
+
+  std::unique_lock<CSharedSection> l1(sec);
+  std::unique_lock<CSharedSection> l2(sec);
+  std::shared_lock<CSharedSection> l3(sec);
+  EXPECT_TRUE(sec.try_lock_shared());
+  sec.unlock_shared();
+}
+
+TEST(TestSharedSection, UpgradableLock)
+{
+  std::atomic<long> mutex(0L);
+  CEvent event;
+
+  CSharedSection sec;
+  locker<std::shared_lock<CSharedSection>> reader(sec, &mutex, &event);
+  locker<std::unique_lock<CSharedSection>> writer(sec, &mutex);
+  std::unique_ptr<thread> writerThread;
+
+  {
+    CUpgradableLock upgradable(sec);
+
+    // readers can still get in, writers can't
+    EXPECT_TRUE(std::async(std::launch::async, [&sec]() {
+                  const bool locked = sec.try_lock_shared();
+                  if (locked)
+                    sec.unlock_shared();
+                  return locked;
+                }).get());
+    EXPECT_FALSE(std::async(std::launch::async, [&sec]() {
+                   const bool locked = sec.try_lock();
+                   if (locked)
+                     sec.unlock();
+                   return locked;
+                 }).get());
+
+    thread readerThread(reader);
+    EXPECT_TRUE(waitForThread(mutex, 1, 10000ms));
+    EXPECT_TRUE(waitForWaiters(event, 1, 10000ms));
+    EXPECT_TRUE(reader.haslock);
+
+    writerThread = std::make_unique<thread>(writer);
+    EXPECT_TRUE(waitForThread(mutex, 2, 10000ms));
+
+    // let the reader go once the upgrade waits for it
+    std::thread releaseReader([&event]() {
+      std::this_thread::sleep_for(50ms);
+      event.Set();
+    });
+
+    upgradable.Upgrade();
+    EXPECT_TRUE(upgradable.IsUpgraded());
+    EXPECT_TRUE(readerThread.timed_join(10000ms));
+    EXPECT_TRUE(!reader.haslock);
+
+    // the upgrade wasn't overtaken by the waiting writer
+    std::this_thread::sleep_for(10ms);
+    EXPECT_TRUE(!writer.obtainedlock);
+
+    releaseReader.join();
+  }
+
+  // releasing the exclusive lock lets the writer in
+  EXPECT_TRUE(writerThread->timed_join(10000ms));
+  EXPECT_TRUE(writer.obtainedlock);
+}
+
+TEST(TestSharedSection, UpgradableLockReleasesExclusive)
+{
+  CSharedSection sec;
+  {
+    CUpgradableLock upgradable(sec);
+    upgradable.Upgrade();
+    EXPECT_FALSE(std::async(std::launch::async, [&sec]() {
+                   return sec.try_lock_shared();
+                 }).get());
+  }
+  EXPECT_TRUE(sec.try_lock());
+  sec.unlock();
+  {
+    CUpgradableLock upgradable(sec);
+  }
+  EXPECT_TRUE(sec.try_lock());
+  sec.unlock();
+}
+
+namespace
+{
+// readers continuously take shared locks while one writer takes the exclusive lock
+template<class S>
+void RunReadMostlyBenchmark(S& sec,
+                            const char* name,
+                            std::function<void(const std::string&, int)> record)
+{
+  const int readers = 4;
+  const int writes = 50;
+  std::atomic<bool> stop(false);
+  std::atomic<int64_t> reads(0);
+
+  std::vector<std::thread> readerThreads;
+  for (int i = 0; i < readers; i++)
+  {
+    readerThreads.emplace_back([&]() {
+      int64_t count = 0;
+      while (!stop)
+      {
+        std::shared_lock<S> lock(sec);
+        count++;
+      }
+      reads += count;
+    });
+  }
+
+  std::chrono::nanoseconds maxWait(0);
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < writes; i++)
+  {
+    const auto before = std::chrono::steady_clock::now();
+    {
+      std::unique_lock<S> lock(sec);
+    }
+    maxWait = std::max<std::chrono::nanoseconds>(maxWait, std::chrono::steady_clock::now() - before);
+    std::this_thread::sleep_for(100us);
+  }
+  const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - start);
+
+  stop = true;
+  for (auto& thread : readerThreads)
+    thread.join();
+
+  record(std::string(name) + "ReadsPerMs",
+         static_cast<int>(reads / std::max<int64_t>(1, elapsed.count())));
+  record(std::string(name) + "MaxWriteWaitUs",
+         static_cast<int>(std::chrono::duration_cast<std::chrono::microseconds>(maxWait).count()));
+}
+} // namespace
+
+// a measurement rather than a test, run it with --gtest_also_run_disabled_tests
+TEST(TestSharedSection, DISABLED_ReadMostlyBenchmark)
+{
+  auto record = [this](const std::string& key, int value) { RecordProperty(key, value); };
+
+  CSharedSection readers;
+  RunReadMostlyBenchmark(readers, "PreferReaders", record);
+
+  CSharedSection writers(CSharedSection::Preference::WRITERS);
+  RunReadMostlyBenchmark(writers, "PreferWriters", record);
+
+  std::shared_mutex sharedMutex;
+  RunReadMostlyBenchmark(sharedMutex, "StdSharedMutex", record);
+}
@@ -0,0 +1,129 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "threads/Thread.h"
+#include "threads/ThreadRoles.h"
+
+#include <vector>
+
+#if defined(TARGET_LINUX)
+#include <sched.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+#include <gtest/gtest.h>
+
+using namespace XbmcThreads;
+
+namespace
+{
+class TestThreadRoles : public testing::Test
+{
+protected:
+  ~TestThreadRoles() override { CThreadRoles::Reset(); }
+};
+
+#if defined(TARGET_LINUX)
+class PlacementThread : public CThread
+{
+public:
+  explicit PlacementThread(ThreadRole role) : CThread("PlacementThread") { SetRole(role); }
+  ~PlacementThread() override { StopThread(); }
+
+  cpu_set_t m_cpus;
+  int m_nice{0};
+  bool m_prioritySet{true};
+
+protected:
+  void Process() override
+  {
+    sched_getaffinity(0, sizeof(m_cpus), &m_cpus);
+    m_prioritySet = SetPriority(ThreadPriority::HIGHEST);
+    m_nice = getpriority(PRIO_PROCESS, 0);
+  }
+};
+#endif
+} // namespace
+
+TEST_F(TestThreadRoles, ParseCpus)
+{
+  std::vector<unsigned int> cpus;
+  EXPECT_TRUE(CThreadRoles::ParseCpus("0-3,6", cpus));
+  EXPECT_EQ(std::vector<unsigned int>({0, 1, 2, 3, 6}), cpus);
+  EXPECT_EQ("0-3,6", CThreadRoles::FormatCpus(cpus));
+
+  EXPECT_TRUE(CThreadRoles::ParseCpus("5,1,1-2", cpus));
+  EXPECT_EQ(std::vector<unsigned int>({1, 2, 5}), cpus);
+  EXPECT_EQ("1-2,5", CThreadRoles::FormatCpus(cpus));
+
+  for (const char* invalid : {"", "3-1", "a", "1,,2", "1-", "-1", "1-2-3"})
+    EXPECT_FALSE(CThreadRoles::ParseCpus(invalid, cpus)) << invalid;
+  EXPECT_EQ(std::vector<unsigned int>({1, 2, 5}), cpus);
+}
+
+TEST_F(TestThreadRoles, Names)
+{
+  for (const ThreadRole role : {ThreadRole::DEFAULT, ThreadRole::REALTIME, ThreadRole::INTERACTIVE,
+                                ThreadRole::BACKGROUND})
+    EXPECT_EQ(role, CThreadRoles::ParseRole(CThreadRoles::GetRoleName(role)));
+  EXPECT_FALSE(CThreadRoles::ParseRole("idle"));
+
+  EXPECT_EQ(SchedulingPolicy::FIFO, CThreadRoles::ParsePolicy("fifo"));
+  EXPECT_FALSE(CThreadRoles::ParsePolicy("background"));
+}
+
+TEST_F(TestThreadRoles, ThreadRoleOverride)
+{
+  CThreadRoles::SetThreadRole("Scanner", ThreadRole::BACKGROUND);
+
+  EXPECT_EQ(ThreadRole::BACKGROUND, CThreadRoles::GetThreadRole("Scanner", ThreadRole::DEFAULT));
+  EXPECT_EQ(ThreadRole::REALTIME, CThreadRoles::GetThreadRole("AESink", ThreadRole::REALTIME));
+}
+
+#if defined(TARGET_LINUX)
+TEST_F(TestThreadRoles, PolicyAppliedAtStart)
+{
+  cpu_set_t allowed;
+  ASSERT_EQ(0, sched_getaffinity(0, sizeof(allowed), &allowed));
+  unsigned int cpu = 0;
+  while (!CPU_ISSET(cpu, &allowed))
+    cpu++;
+
+  // moving away from the cpus and lowering the priority need no privileges
+  ThreadRolePolicy policy;
+  policy.m_cpus = {cpu};
+  policy.m_nice = 1;
+  CThreadRoles::SetPolicy(ThreadRole::BACKGROUND, policy);
+
+  PlacementThread thread(ThreadRole::BACKGROUND);
+  thread.Create();
+  ASSERT_TRUE(thread.Join(std::chrono::seconds(10)));
+
+  EXPECT_EQ(1, CPU_COUNT(&thread.m_cpus));
+  EXPECT_TRUE(CPU_ISSET(cpu, &thread.m_cpus));
+  EXPECT_EQ(getpriority(PRIO_PROCESS, 0) + 1, thread.m_nice);
+  EXPECT_FALSE(thread.m_prioritySet);
+}
+
+TEST_F(TestThreadRoles, DefaultRoleUntouched)
+{
+  cpu_set_t allowed;
+  ASSERT_EQ(0, sched_getaffinity(0, sizeof(allowed), &allowed));
+
+  ThreadRolePolicy policy;
+  policy.m_cpus = {0};
+  CThreadRoles::SetPolicy(ThreadRole::BACKGROUND, policy);
+
+  PlacementThread thread(ThreadRole::DEFAULT);
+  thread.Create();
+  ASSERT_TRUE(thread.Join(std::chrono::seconds(10)));
+
+  EXPECT_TRUE(CPU_EQUAL(&allowed, &thread.m_cpus));
+}
+#endif
@@ -0,0 +1,192 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "AsyncLogSink.h"
+
+#include <cstdio>
+#include <exception>
+#include <string>
+#include <utility>
+#include <vector>
+
+CAsyncLogSink::CAsyncLogSink(std::shared_ptr<spdlog::sinks::sink> sink,
+                             size_t capacity,
+                             OverflowPolicy policy /* = OverflowPolicy::BLOCK */)
+  : m_sink(std::move(sink)), m_capacity(capacity > 0 ? capacity : 1), m_policy(policy)
+{
+  // not a CThread: creating it would log, and the writer must never log itself
+  m_thread = std::thread(&CAsyncLogSink::Process, this);
+}
+
+CAsyncLogSink::~CAsyncLogSink()
+{
+  {
+    std::unique_lock<std::mutex> lock(m_queueMutex);
+    m_stop = true;
+  }
+  m_queueCondition.notify_one();
+  m_thread.join();
+}
+
+CAsyncLogSink::Stats CAsyncLogSink::GetStats() const
+{
+  std::unique_lock<std::mutex> lock(m_queueMutex);
+  return m_stats;
+}
+
+void CAsyncLogSink::Drain()
+{
+  std::unique_lock<std::mutex> lock(m_queueMutex);
+  const uint64_t target = m_queued;
+  m_queueCondition.notify_one();
+  m_spaceCondition.wait(lock, [this, target]() { return m_done >= target || m_stop; });
+}
+
+void CAsyncLogSink::log(const spdlog::details::log_msg& msg)
+{
+  if (!should_log(msg.level))
+    return;
+
+  {
+    std::unique_lock<std::mutex> lock(m_queueMutex);
+    if (m_queue.size() >= m_capacity)
+    {
+      if (m_policy == OverflowPolicy::DROP && msg.level < spdlog::level::err)
+      {
+        m_stats.m_dropped++;
+        m_droppedUnreported++;
+        return;
+      }
+
+      m_stats.m_blocked++;
+      m_spaceCondition.wait(lock, [this]() { return m_queue.size() < m_capacity || m_stop; });
+    }
+
+    m_queue.emplace_back(msg);
+    m_queued++;
+  }
+  m_queueCondition.notify_one();
+}
+
+void CAsyncLogSink::flush()
+{
+  // every batch is flushed by the writer thread
+}
+
+void CAsyncLogSink::set_pattern(const std::string& pattern)
+{
+  std::unique_lock<std::mutex> lock(m_sinkMutex);
+  m_sink->set_pattern(pattern);
+}
+
+void CAsyncLogSink::set_formatter(std::unique_ptr<spdlog::formatter> sinkFormatter)
+{
+  std::unique_lock<std::mutex> lock(m_sinkMutex);
+  m_sink->set_formatter(std::move(sinkFormatter));
+}
+
+void CAsyncLogSink::Process()
+{
+  std::vector<spdlog::details::log_msg_buffer> batch;
+
+  while (true)
+  {
+    uint64_t dropped;
+    {
+      std::unique_lock<std::mutex> lock(m_queueMutex);
+      m_queueCondition.wait(lock, [this]() { return !m_queue.empty() || m_stop; });
+      // report messages dropped after the last batch before stopping
+      if (m_queue.empty() && m_droppedUnreported == 0 && m_stop)
+        break;
+
+      batch.assign(std::make_move_iterator(m_queue.begin()),
+                   std::make_move_iterator(m_queue.end()));
+      m_queue.clear();
+      dropped = m_droppedUnreported;
+      m_droppedUnreported = 0;
+    }
+    // room for more messages while this batch is written
+    m_spaceCondition.notify_all();
+
+    bool failed = false;
+    try
+    {
+      std::unique_lock<std::mutex> lock(m_sinkMutex);
+      if (dropped > 0)
+        WriteDropped(dropped);
+      for (const auto& msg : batch)
+        m_sink->log(msg);
+      m_sink->flush();
+    }
+    catch (const std::exception& ex)
+    {
+      failed = true;
+      ReportError(ex.what());
+    }
+    catch (...)
+    {
+      failed = true;
+      ReportError("unknown exception");
+    }
+
+    {
+      std::unique_lock<std::mutex> lock(m_queueMutex);
+      // messages of a failed batch count as done, nobody must wait for them forever
+      m_done += batch.size();
+      if (failed)
+        m_stats.m_failed++;
+      else
+        m_stats.m_written += batch.size();
+      m_stats.m_batches++;
+    }
+    m_spaceCondition.notify_all();
+    batch.clear();
+  }
+
+  m_spaceCondition.notify_all();
+}
+
+void CAsyncLogSink::ReportError(const char* error)
+{
+  // like spdlog's own error handler there's nowhere else to report it to than stderr, and only
+  // the first error is reported to not flood it while e.g. the disk is full
+  if (m_errorReported)
+    return;
+
+  m_errorReported = true;
+  std::fprintf(stderr, "[*** LOG ERROR ***] failed to write the log: %s\n", error);
+}
+
+void CAsyncLogSink::WriteDropped(uint64_t dropped)
+{
+  const std::string message = std::to_string(dropped) + " log messages dropped";
+  const spdlog::details::log_msg msg("general", spdlog::level::warn, message);
+  m_sink->log(msg);
+}
+
+void CAsyncLogWriteThroughSink::SetSink(std::shared_ptr<CAsyncLogSink> sink)
+{
+  std::unique_lock<std::mutex> lock(m_sinkMutex);
+  m_sink = std::move(sink);
+}
+
+void CAsyncLogWriteThroughSink::log(const spdlog::details::log_msg& msg)
+{
+  if (msg.level < spdlog::level::err)
+    return;
+
+  std::shared_ptr<CAsyncLogSink> sink;
+  {
+    std::unique_lock<std::mutex> lock(m_sinkMutex);
+    sink = m_sink;
+  }
+
+  // make sure errors are on disk before carrying on
+  if (sink != nullptr)
+    sink->Drain();
+}
@@ -0,0 +1,115 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include <spdlog/details/log_msg_buffer.h>
+#include <spdlog/sinks/sink.h>
+
+/*!
+ \brief spdlog sink handing log messages over to a background thread which writes them to
+ another sink.
+
+ Formatting and writing a message (plus the flush after every message) happens on the writer
+ thread, so logging threads only pay for copying the message into the queue. Messages are
+ written in batches with one flush per batch. Errors thrown by the wrapped sink are caught on
+ the writer thread and the first one is reported on stderr.
+
+ Errors and fatal messages are only written through by a CAsyncLogWriteThroughSink.
+ */
+class CAsyncLogSink : public spdlog::sinks::sink
+{
+public:
+  enum class OverflowPolicy
+  {
+    BLOCK, ///< wait for the writer thread to make room
+    DROP, ///< drop the message and report the number of dropped messages later
+  };
+
+  struct Stats
+  {
+    uint64_t m_written{0};
+    uint64_t m_dropped{0};
+    uint64_t m_blocked{0};
+    uint64_t m_batches{0};
+    uint64_t m_failed{0}; ///< batches the wrapped sink failed to write
+  };
+
+  CAsyncLogSink(std::shared_ptr<spdlog::sinks::sink> sink,
+                size_t capacity,
+                OverflowPolicy policy = OverflowPolicy::BLOCK);
+  ~CAsyncLogSink() override;
+
+  void SetOverflowPolicy(OverflowPolicy policy) { m_policy = policy; }
+  Stats GetStats() const;
+
+  /*!
+   \brief Wait until all queued messages have been written and flushed.
+   */
+  void Drain();
+
+  // implementations of spdlog::sinks::sink
+  void log(const spdlog::details::log_msg& msg) override;
+  void flush() override;
+  void set_pattern(const std::string& pattern) override;
+  void set_formatter(std::unique_ptr<spdlog::formatter> sinkFormatter) override;
+
+private:
+  void Process();
+  void ReportError(const char* error);
+  void WriteDropped(uint64_t dropped);
+
+  std::shared_ptr<spdlog::sinks::sink> m_sink;
+  const size_t m_capacity;
+  std::atomic<OverflowPolicy> m_policy;
+
+  mutable std::mutex m_queueMutex;
+  std::condition_variable m_queueCondition; // signalled when messages are queued
+  std::condition_variable m_spaceCondition; // signalled when a batch has been written
+  std::deque<spdlog::details::log_msg_buffer> m_queue;
+  uint64_t m_queued{0};
+  uint64_t m_done{0};
+  uint64_t m_droppedUnreported{0};
+  bool m_stop{false};
+  Stats m_stats;
+  bool m_errorReported{false}; // only accessed by the writer thread
+
+  std::mutex m_sinkMutex; // serializes access to m_sink
+  std::thread m_thread;
+};
+
+/*!
+ \brief spdlog sink waiting for errors and fatal messages to be written by a CAsyncLogSink.
+
+ Errors make it into the log even if the application crashes right after. The sink is added to
+ the loggers next to the sink the CAsyncLogSink is part of (e.g. a dist_sink), so the logging
+ thread doesn't wait while holding the lock of that sink, blocking all other logging threads.
+ */
+class CAsyncLogWriteThroughSink : public spdlog::sinks::sink
+{
+public:
+  void SetSink(std::shared_ptr<CAsyncLogSink> sink);
+
+  // implementations of spdlog::sinks::sink
+  void log(const spdlog::details::log_msg& msg) override;
+  void flush() override {}
+  void set_pattern(const std::string& pattern) override {}
+  void set_formatter(std::unique_ptr<spdlog::formatter> sinkFormatter) override {}
+
+private:
+  std::mutex m_sinkMutex;
+  std::shared_ptr<CAsyncLogSink> m_sink;
+};
@@ -18,6 +18,9 @@
 #include "utils/Utf8Utils.h"
 
 #include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
 #include <mutex>
 
 #include <fribidi.h>
@@ -89,7 +92,10 @@ public:
   CConverterType(const CConverterType& other);
   ~CConverterType();
 
-  iconv_t GetConverter(std::unique_lock<CCriticalSection>& converterLock);
+  /* Opens a new iconv descriptor for this conversion, to be closed by the caller */
+  iconv_t OpenConverter(void);
+  /* Incremented whenever the charsets change, descriptors opened before are outdated */
+  unsigned int GetGeneration(void) const { return m_generation; }
 
   void Reset(void);
   void ReinitTo(const std::string& sourceCharset, const std::string& targetCharset, unsigned int targetSingleCharMaxLen = 1);
@@ -104,8 +110,8 @@ private:
   std::string         m_sourceCharset;
   enum SpecialCharset m_targetSpecialCharset;
   std::string         m_targetCharset;
-  iconv_t             m_iconv;
   unsigned int        m_targetSingleCharMaxLen;
+  std::atomic<unsigned int> m_generation;
 };
 
 CConverterType::CConverterType(const std::string& sourceCharset, const std::string& targetCharset, unsigned int targetSingleCharMaxLen /*= 1*/) : CCriticalSection(),
@@ -113,8 +119,8 @@ CConverterType::CConverterType(const std::string& sourceCharset, const std::stri
   m_sourceCharset(sourceCharset),
   m_targetSpecialCharset(NotSpecialCharset),
   m_targetCharset(targetCharset),
-  m_iconv(NO_ICONV),
-  m_targetSingleCharMaxLen(targetSingleCharMaxLen)
+  m_targetSingleCharMaxLen(targetSingleCharMaxLen),
+  m_generation(1)
 {
 }
 
@@ -123,8 +129,8 @@ CConverterType::CConverterType(enum SpecialCharset sourceSpecialCharset, const s
   m_sourceCharset(),
   m_targetSpecialCharset(NotSpecialCharset),
   m_targetCharset(targetCharset),
-  m_iconv(NO_ICONV),
-  m_targetSingleCharMaxLen(targetSingleCharMaxLen)
+  m_targetSingleCharMaxLen(targetSingleCharMaxLen),
+  m_generation(1)
 {
 }
 
@@ -133,8 +139,8 @@ CConverterType::CConverterType(const std::string& sourceCharset, enum SpecialCha
   m_sourceCharset(sourceCharset),
   m_targetSpecialCharset(targetSpecialCharset),
   m_targetCharset(),
-  m_iconv(NO_ICONV),
-  m_targetSingleCharMaxLen(targetSingleCharMaxLen)
+  m_targetSingleCharMaxLen(targetSingleCharMaxLen),
+  m_generation(1)
 {
 }
 
@@ -143,8 +149,8 @@ CConverterType::CConverterType(enum SpecialCharset sourceSpecialCharset, enum Sp
   m_sourceCharset(),
   m_targetSpecialCharset(targetSpecialCharset),
   m_targetCharset(),
-  m_iconv(NO_ICONV),
-  m_targetSingleCharMaxLen(targetSingleCharMaxLen)
+  m_targetSingleCharMaxLen(targetSingleCharMaxLen),
+  m_generation(1)
 {
 }
 
@@ -153,56 +159,39 @@ CConverterType::CConverterType(const CConverterType& other) : CCriticalSection()
   m_sourceCharset(other.m_sourceCharset),
   m_targetSpecialCharset(other.m_targetSpecialCharset),
   m_targetCharset(other.m_targetCharset),
-  m_iconv(NO_ICONV),
-  m_targetSingleCharMaxLen(other.m_targetSingleCharMaxLen)
+  m_targetSingleCharMaxLen(other.m_targetSingleCharMaxLen),
+  m_generation(other.m_generation.load())
 {
 }
 
-CConverterType::~CConverterType()
-{
-  std::unique_lock<CCriticalSection> lock(*this);
-  if (m_iconv != NO_ICONV)
-    iconv_close(m_iconv);
-  lock.unlock(); // ensure unlocking before final destruction
-}
+CConverterType::~CConverterType() = default;
 
-iconv_t CConverterType::GetConverter(std::unique_lock<CCriticalSection>& converterLock)
+iconv_t CConverterType::OpenConverter(void)
 {
-  // ensure that this unique instance is locked externally
-  if (converterLock.mutex() != this)
-    return NO_ICONV;
-
-  if (m_iconv == NO_ICONV)
-  {
-    if (m_sourceSpecialCharset)
-      m_sourceCharset = ResolveSpecialCharset(m_sourceSpecialCharset);
-    if (m_targetSpecialCharset)
-      m_targetCharset = ResolveSpecialCharset(m_targetSpecialCharset);
+  std::unique_lock<CCriticalSection> lock(*this);
+  if (m_sourceSpecialCharset && m_sourceCharset.empty())
+    m_sourceCharset = ResolveSpecialCharset(m_sourceSpecialCharset);
+  if (m_targetSpecialCharset && m_targetCharset.empty())
+    m_targetCharset = ResolveSpecialCharset(m_targetSpecialCharset);
 
-    m_iconv = iconv_open(m_targetCharset.c_str(), m_sourceCharset.c_str());
+  iconv_t converter = iconv_open(m_targetCharset.c_str(), m_sourceCharset.c_str());
 
-    if (m_iconv == NO_ICONV)
-      CLog::Log(LOGERROR, "{}: iconv_open() for \"{}\" -> \"{}\" failed, errno = {} ({})",
-                __FUNCTION__, m_sourceCharset, m_targetCharset, errno, strerror(errno));
-  }
+  if (converter == NO_ICONV)
+    CLog::Log(LOGERROR, "{}: iconv_open() for \"{}\" -> \"{}\" failed, errno = {} ({})",
+              __FUNCTION__, m_sourceCharset, m_targetCharset, errno, strerror(errno));
 
-  return m_iconv;
+  return converter;
 }
 
 void CConverterType::Reset(void)
 {
   std::unique_lock<CCriticalSection> lock(*this);
-  if (m_iconv != NO_ICONV)
-  {
-    iconv_close(m_iconv);
-    m_iconv = NO_ICONV;
-  }
-
   if (m_sourceSpecialCharset)
     m_sourceCharset.clear();
   if (m_targetSpecialCharset)
     m_targetCharset.clear();
 
+  m_generation++;
 }
 
 void CConverterType::ReinitTo(const std::string& sourceCharset, const std::string& targetCharset, unsigned int targetSingleCharMaxLen /*= 1*/)
@@ -210,17 +199,12 @@ void CConverterType::ReinitTo(const std::string& sourceCharset, const std::strin
   std::unique_lock<CCriticalSection> lock(*this);
   if (sourceCharset != m_sourceCharset || targetCharset != m_targetCharset)
   {
-    if (m_iconv != NO_ICONV)
-    {
-      iconv_close(m_iconv);
-      m_iconv = NO_ICONV;
-    }
-
     m_sourceSpecialCharset = NotSpecialCharset;
     m_sourceCharset = sourceCharset;
     m_targetSpecialCharset = NotSpecialCharset;
     m_targetCharset = targetCharset;
     m_targetSingleCharMaxLen = targetSingleCharMaxLen;
+    m_generation++;
   }
 }
 
@@ -263,6 +247,92 @@ enum StdConversionType /* Keep it in sync with CCharsetConverter::CInnerConverte
   NumberOfStdConversionTypes /* Dummy sentinel entry */
 };
 
+/* iconv descriptors can't be used by several threads at once, so instead of sharing one descriptor
+   per conversion behind a lock every thread opens its own on first use. They are reopened after
+   the charsets of a conversion changed and closed when the thread exits. */
+class CThreadConverters
+{
+public:
+  ~CThreadConverters()
+  {
+    for (const auto& entry : m_converters)
+    {
+      if (entry.m_iconv != NO_ICONV)
+        iconv_close(entry.m_iconv);
+    }
+  }
+
+  iconv_t Get(StdConversionType convertType, CConverterType& convType)
+  {
+    Entry& entry = m_converters[convertType];
+    // read the generation first, so a concurrent reset makes the next call reopen again
+    const unsigned int generation = convType.GetGeneration();
+    if (entry.m_generation != generation)
+    {
+      if (entry.m_iconv != NO_ICONV)
+        iconv_close(entry.m_iconv);
+      entry.m_iconv = convType.OpenConverter();
+      entry.m_generation = entry.m_iconv != NO_ICONV ? generation : 0;
+    }
+    return entry.m_iconv;
+  }
+
+private:
+  struct Entry
+  {
+    iconv_t m_iconv = NO_ICONV;
+    unsigned int m_generation = 0;
+  };
+  Entry m_converters[NumberOfStdConversionTypes];
+};
+
+/* Conversions between Unicode encodings which leave ASCII characters as they are, a string
+   consisting of ASCII characters only is converted by widening or narrowing its code units */
+static bool IsAsciiPreservingConversion(StdConversionType convertType)
+{
+  switch (convertType)
+  {
+  case Utf8ToUtf32:
+  case Utf32ToUtf8:
+  case Utf32ToW:
+  case WToUtf32:
+  case WtoUtf8:
+  case Utf8toW:
+    return true;
+  default:
+    return false;
+  }
+}
+
+static bool IsAscii(const std::string& str)
+{
+  const char* data = str.data();
+  const size_t length = str.length();
+  size_t i = 0;
+  // check eight characters at a time, the high bit is set in any non ASCII byte of UTF-8
+  for (; i + sizeof(uint64_t) <= length; i += sizeof(uint64_t))
+  {
+    uint64_t chunk;
+    std::memcpy(&chunk, data + i, sizeof(chunk));
+    if (chunk & UINT64_C(0x8080808080808080))
+      return false;
+  }
+  for (; i < length; i++)
+  {
+    if (static_cast<unsigned char>(data[i]) >= 0x80)
+      return false;
+  }
+  return true;
+}
+
+template<class STRING>
+static bool IsAscii(const STRING& str)
+{
+  return std::all_of(str.begin(), str.end(), [](typename STRING::value_type c) {
+    return static_cast<uint32_t>(c) < 0x80;
+  });
+}
+
 /* We don't want to pollute header file with many additional includes and definitions, so put
    here all staff that require usage of types defined in this file or in additional headers */
 class CCharsetConverter::CInnerConverter
@@ -326,10 +396,20 @@ bool CCharsetConverter::CInnerConverter::stdConvert(StdConversionType convertTyp
   if (convertType < 0 || convertType >= NumberOfStdConversionTypes)
     return false;
 
+  if (IsAsciiPreservingConversion(convertType) && IsAscii(strSource))
+  {
+    strDest.resize(strSource.length());
+    std::transform(strSource.begin(), strSource.end(), strDest.begin(),
+                   [](typename INPUT::value_type c) {
+                     return static_cast<typename OUTPUT::value_type>(c);
+                   });
+    return true;
+  }
+
+  static thread_local CThreadConverters converters;
   CConverterType& convType = m_stdConversion[convertType];
-  std::unique_lock<CCriticalSection> converterLock(convType);
 
-  return convert(convType.GetConverter(converterLock), convType.GetTargetSingleCharMaxLen(), strSource, strDest, failOnInvalidChar);
+  return convert(converters.Get(convertType, convType), convType.GetTargetSingleCharMaxLen(), strSource, strDest, failOnInvalidChar);
 }
 
 template<class INPUT,class OUTPUT>
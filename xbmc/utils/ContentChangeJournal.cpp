@@ -0,0 +1,270 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "ContentChangeJournal.h"
+
+#include "filesystem/SpecialProtocol.h"
+#include "utils/URIUtils.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <mutex>
+
+#if defined(HAVE_INOTIFY)
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+namespace
+{
+// anything that changes the entries of a directory or their contents
+constexpr uint32_t WATCH_MASK = IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_MODIFY |
+                                IN_ATTRIB | IN_CLOSE_WRITE | IN_DELETE_SELF | IN_MOVE_SELF |
+                                IN_ONLYDIR;
+}
+#endif
+
+CContentChangeJournal::CContentChangeJournal(size_t maxWatches)
+  : CThread("ContentChangeJournal"), m_maxWatches(maxWatches)
+{
+}
+
+CContentChangeJournal::~CContentChangeJournal()
+{
+  Stop();
+}
+
+void CContentChangeJournal::Start()
+{
+#if defined(HAVE_INOTIFY)
+  std::unique_lock<CCriticalSection> lock(m_critical);
+  if (m_fd >= 0)
+    return;
+
+  m_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (m_fd < 0)
+  {
+    CLog::Log(LOGWARNING, "CContentChangeJournal: unable to initialize inotify ({})",
+              strerror(errno));
+    return;
+  }
+
+  // the limit is shared by all inotify users of the account, leave half of it to others
+  std::ifstream limit("/proc/sys/fs/inotify/max_user_watches");
+  size_t maxUserWatches = 0;
+  if (limit >> maxUserWatches && maxUserWatches > 0)
+    m_maxWatches = std::min(m_maxWatches, maxUserWatches / 2);
+
+  Create();
+#endif
+}
+
+void CContentChangeJournal::Stop()
+{
+  StopThread();
+
+  std::unique_lock<CCriticalSection> lock(m_critical);
+  ForgetAll();
+#if defined(HAVE_INOTIFY)
+  if (m_fd >= 0)
+    close(m_fd);
+#endif
+  m_fd = -1;
+}
+
+std::string CContentChangeJournal::GetHash(const std::string& path,
+                                           const std::string& options) const
+{
+  std::unique_lock<CCriticalSection> lock(m_critical);
+  const auto it = m_directories.find(path);
+  return it != m_directories.end() && it->second.m_options == options ? it->second.m_hash : "";
+}
+
+bool CContentChangeJournal::Track(const std::string& path, const std::vector<std::string>& subDirs)
+{
+  if (!URIUtils::IsHD(path))
+    return false;
+
+  std::unique_lock<CCriticalSection> lock(m_critical);
+  if (m_fd < 0)
+    return false;
+
+  // drop what was tracked before, the subdirectories might have changed
+  auto it = m_directories.find(path);
+  if (it != m_directories.end())
+    Forget(it);
+
+  // an empty hash marks the directory as unchanged until SetHash() is called
+  it = m_directories.emplace(path, CTrackedDirectory{}).first;
+  std::vector<std::string>& watchedPaths = it->second.m_watchedPaths;
+  watchedPaths.reserve(subDirs.size() + 1);
+  if (!Watch(path))
+  {
+    Forget(it);
+    return false;
+  }
+  watchedPaths.push_back(path);
+
+  for (const auto& subDir : subDirs)
+  {
+    if (!Watch(subDir))
+    {
+      Forget(it);
+      return false;
+    }
+    watchedPaths.push_back(subDir);
+  }
+  return true;
+}
+
+void CContentChangeJournal::SetHash(const std::string& path,
+                                    const std::string& hash,
+                                    const std::string& options)
+{
+  std::unique_lock<CCriticalSection> lock(m_critical);
+  const auto it = m_directories.find(path);
+  if (it != m_directories.end())
+  {
+    it->second.m_hash = hash;
+    it->second.m_options = options;
+  }
+}
+
+bool CContentChangeJournal::Watch(const std::string& path)
+{
+#if defined(HAVE_INOTIFY)
+  const auto it = m_watchedPaths.find(path);
+  if (it != m_watchedPaths.end())
+  {
+    it->second.m_users++;
+    return true;
+  }
+
+  if (m_watchedPaths.size() >= m_maxWatches)
+  {
+    CLog::Log(LOGDEBUG, "CContentChangeJournal: not watching {}, {} directories watched already",
+              path, m_watchedPaths.size());
+    return false;
+  }
+
+  const std::string localPath = CSpecialProtocol::TranslatePath(path);
+  const int wd = inotify_add_watch(m_fd, localPath.c_str(), WATCH_MASK);
+  if (wd < 0)
+  {
+    CLog::Log(LOGDEBUG, "CContentChangeJournal: unable to watch {} ({})", localPath,
+              strerror(errno));
+    return false;
+  }
+
+  m_watches[wd] = path;
+  m_watchedPaths[path] = CWatch{wd, 1};
+  return true;
+#else
+  return false;
+#endif
+}
+
+void CContentChangeJournal::Unwatch(const std::string& path)
+{
+  const auto it = m_watchedPaths.find(path);
+  if (it == m_watchedPaths.end() || --it->second.m_users > 0)
+    return;
+
+#if defined(HAVE_INOTIFY)
+  inotify_rm_watch(m_fd, it->second.m_wd);
+#endif
+  m_watches.erase(it->second.m_wd);
+  m_watchedPaths.erase(it);
+}
+
+void CContentChangeJournal::Forget(std::map<std::string, CTrackedDirectory>::iterator it)
+{
+  for (const auto& watchedPath : it->second.m_watchedPaths)
+    Unwatch(watchedPath);
+  m_directories.erase(it);
+}
+
+void CContentChangeJournal::ForgetAll()
+{
+  while (!m_directories.empty())
+    Forget(m_directories.begin());
+}
+
+void CContentChangeJournal::OnChanged(const std::string& path)
+{
+  // forget the hashes of the directory and of all directories containing it, which also removes
+  // the watches nothing relies on anymore
+  for (size_t pos = path.find('/'); pos != std::string::npos; pos = path.find('/', pos + 1))
+  {
+    const auto it = m_directories.find(path.substr(0, pos + 1));
+    if (it != m_directories.end())
+      Forget(it);
+  }
+
+  const auto it = m_directories.find(path);
+  if (it != m_directories.end())
+    Forget(it);
+}
+
+void CContentChangeJournal::Process()
+{
+#if defined(HAVE_INOTIFY)
+  alignas(struct inotify_event) char buffer[4096];
+
+  while (!m_bStop)
+  {
+    struct pollfd pfd = {m_fd, POLLIN, 0};
+    if (poll(&pfd, 1, 500) <= 0)
+      continue;
+
+    const ssize_t length = read(m_fd, buffer, sizeof(buffer));
+    if (length <= 0)
+      continue;
+
+    std::unique_lock<CCriticalSection> lock(m_critical);
+    for (ssize_t i = 0; i < length;)
+    {
+      const struct inotify_event* event = reinterpret_cast<const struct inotify_event*>(buffer + i);
+      i += sizeof(struct inotify_event) + event->len;
+
+      if (event->mask & IN_Q_OVERFLOW)
+      {
+        // events were lost, nothing can be trusted anymore
+        CLog::Log(LOGDEBUG, "CContentChangeJournal: event queue overflow, forgetting all hashes");
+        ForgetAll();
+        continue;
+      }
+
+      const auto watch = m_watches.find(event->wd);
+      if (watch == m_watches.end())
+        continue;
+
+      const std::string path = watch->second;
+      OnChanged(path);
+
+      // the directory has been removed, unmounted or moved away from the watched path, so
+      // nothing else relying on its watch can be trusted anymore either
+      if (event->mask & (IN_IGNORED | IN_MOVE_SELF))
+      {
+        for (auto it = m_directories.begin(); it != m_directories.end();)
+        {
+          const std::vector<std::string>& watchedPaths = it->second.m_watchedPaths;
+          if (std::find(watchedPaths.begin(), watchedPaths.end(), path) != watchedPaths.end())
+            Forget(it++);
+          else
+            ++it;
+        }
+      }
+    }
+  }
+#endif
+}
@@ -0,0 +1,112 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/CriticalSection.h"
+#include "threads/Thread.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+/*!
+ \brief Remembers the hashes of local directories for as long as their contents don't change.
+
+ Library scanners hash every directory of a source on each update to find out what changed.
+ For local directories the journal watches the hashed directories for changes (using inotify
+ where available), so that the hash of an untouched directory can be reused instead of being
+ computed again. Any change within a tracked directory, or losing track of changes, forgets the
+ hash and the scanner falls back to hashing the directory.
+
+ The journal is owned by the application, which starts and stops it, and is available through
+ CServiceBroker::GetContentChangeJournal(). It is not persisted, so the first scan after a
+ restart hashes everything as before.
+ */
+class CContentChangeJournal : private CThread
+{
+public:
+  /*!
+   \param maxWatches the maximum number of directories watched at once, further directories are
+   not tracked. It is also limited to half of the system wide limit per user.
+   */
+  explicit CContentChangeJournal(size_t maxWatches = DEFAULT_MAX_WATCHES);
+  ~CContentChangeJournal() override;
+
+  /*!
+   \brief Start watching for changes. Until then, no directory can be tracked.
+   */
+  void Start();
+
+  /*!
+   \brief Stop watching for changes and forget all hashes.
+   */
+  void Stop();
+
+  /*!
+   \brief Get the hash of the given directory stored with SetHash().
+   \param path the directory.
+   \param options anything else the hash depends on, e.g. exclude patterns.
+   \return the hash, or an empty string if it is unknown, was stored with different options or
+           the directory changed since.
+   */
+  std::string GetHash(const std::string& path, const std::string& options = "") const;
+
+  /*!
+   \brief Start watching a directory before computing its hash.
+
+   Must be called before the directory is hashed, so that changes made while it is being hashed
+   are not missed.
+   \param path the directory whose hash will be stored with SetHash().
+   \param subDirs the subdirectories included in the hash, if any.
+   \return true if the directory is being watched, false if it can't be (e.g. it isn't local).
+   */
+  bool Track(const std::string& path, const std::vector<std::string>& subDirs = {});
+
+  /*!
+   \brief Store the hash of a directory passed to Track().
+
+   The hash is dropped if the directory changed since Track() was called.
+   */
+  void SetHash(const std::string& path, const std::string& hash, const std::string& options = "");
+
+protected:
+  void Process() override;
+
+private:
+  static constexpr size_t DEFAULT_MAX_WATCHES = 8192;
+
+  CContentChangeJournal(const CContentChangeJournal&) = delete;
+  CContentChangeJournal& operator=(const CContentChangeJournal&) = delete;
+
+  struct CTrackedDirectory
+  {
+    std::string m_hash; // empty until SetHash() is called
+    std::string m_options;
+    std::vector<std::string> m_watchedPaths;
+  };
+
+  struct CWatch
+  {
+    int m_wd;
+    unsigned int m_users; // tracked directories relying on the watch
+  };
+
+  bool Watch(const std::string& path);
+  void Unwatch(const std::string& path);
+  void Forget(std::map<std::string, CTrackedDirectory>::iterator it);
+  void ForgetAll();
+  void OnChanged(const std::string& path);
+
+  mutable CCriticalSection m_critical;
+  size_t m_maxWatches;
+  int m_fd = -1;
+  std::map<int, std::string> m_watches;
+  std::map<std::string, CWatch> m_watchedPaths;
+  std::map<std::string, CTrackedDirectory> m_directories;
+};
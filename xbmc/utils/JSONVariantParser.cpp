@@ -8,6 +8,8 @@
 
 #include "JSONVariantParser.h"
 
+#include <utility>
+
 #include <rapidjson/reader.h>
 
 class CJSONVariantParserHandler
@@ -40,7 +42,7 @@ private:
     return true;
   }
 
-  void PushObject(const CVariant& variant);
+  void PushObject(CVariant&& variant);
   void PopObject();
 
   CVariant& m_parsedObject;
@@ -66,7 +68,7 @@ CJSONVariantParserHandler::CJSONVariantParserHandler(CVariant& parsedObject)
 
 bool CJSONVariantParserHandler::Null()
 {
-  PushObject(CVariant::ConstNullVariant);
+  PushObject(CVariant(CVariant::ConstNullVariant));
   PopObject();
 
   return true;
@@ -121,7 +123,7 @@ bool CJSONVariantParserHandler::StartObject()
 
 bool CJSONVariantParserHandler::Key(const char* str, rapidjson::SizeType length, bool copy)
 {
-  m_key = std::string(str, 0, length);
+  m_key.assign(str, length);
 
   return true;
 }
@@ -147,31 +149,31 @@ bool CJSONVariantParserHandler::EndArray(rapidjson::SizeType elementCount)
   return true;
 }
 
-void CJSONVariantParserHandler::PushObject(const CVariant& variant)
+void CJSONVariantParserHandler::PushObject(CVariant&& variant)
 {
+  const PARSE_STATUS status = variant.isObject()  ? PARSE_STATUS::Object
+                              : variant.isArray() ? PARSE_STATUS::Array
+                                                  : PARSE_STATUS::Variable;
+
   if (m_status == PARSE_STATUS::Object)
   {
-    (*m_parse[m_parse.size() - 1])[m_key] = variant;
-    m_parse.push_back(&(*m_parse[m_parse.size() - 1])[m_key]);
+    CVariant& member = (*m_parse[m_parse.size() - 1])[m_key];
+    member = std::move(variant);
+    m_parse.push_back(&member);
   }
   else if (m_status == PARSE_STATUS::Array)
   {
     CVariant *temp = m_parse[m_parse.size() - 1];
-    temp->push_back(variant);
+    temp->push_back(std::move(variant));
     m_parse.push_back(&(*temp)[temp->size() - 1]);
   }
   else if (m_parse.empty())
   {
-    m_root = variant;
+    m_root = std::move(variant);
     m_parse.push_back(&m_root);
   }
 
-  if (variant.isObject())
-    m_status = PARSE_STATUS::Object;
-  else if (variant.isArray())
-    m_status = PARSE_STATUS::Array;
-  else
-    m_status = PARSE_STATUS::Variable;
+  m_status = status;
 }
 
 void CJSONVariantParserHandler::PopObject()
@@ -191,7 +193,7 @@ void CJSONVariantParserHandler::PopObject()
   }
   else
   {
-    m_parsedObject = *variant;
+    m_parsedObject = std::move(*variant);
     m_status = PARSE_STATUS::Variable;
   }
 }
@@ -29,6 +29,7 @@ bool CJob::ShouldCancel(unsigned int progress, unsigned int total) const
 CJobWorker::CJobWorker(CJobManager *manager) : CThread("JobWorker")
 {
   m_jobManager = manager;
+  SetRole(ThreadRole::BACKGROUND);
   Create(true); // start work immediately, and kill ourselves when we're done
 }
 
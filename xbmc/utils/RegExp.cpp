@@ -9,12 +9,16 @@
 #include "RegExp.h"
 
 #include "log.h"
+#include "threads/CriticalSection.h"
 #include "utils/StringUtils.h"
 #include "utils/Utf8Utils.h"
 
 #include <algorithm>
+#include <map>
+#include <mutex>
 #include <stdlib.h>
 #include <string.h>
+#include <tuple>
 
 using namespace PCRE;
 
@@ -41,6 +45,78 @@ int CRegExp::m_Utf8Supported = -1;
 int CRegExp::m_UcpSupported  = -1;
 int CRegExp::m_JitSupported  = -1;
 
+struct CRegExp::CompiledPattern
+{
+  ~CompiledPattern()
+  {
+    if (m_sd)
+      pcre_free_study(m_sd);
+    if (m_re)
+      pcre_free(m_re);
+  }
+
+  pcre* m_re = NULL;
+  pcre_extra* m_sd = NULL;
+  bool m_jitCompiled = false;
+};
+
+struct CRegExp::PatternCache
+{
+  // pattern, compile options and study mode
+  using Key = std::tuple<std::string, int, int>;
+
+  static PatternCache& Get()
+  {
+    static PatternCache cache;
+    return cache;
+  }
+
+  // drop the patterns only referenced by the cache
+  void RemoveUnused()
+  {
+    for (auto it = m_patterns.begin(); it != m_patterns.end();)
+    {
+      if (it->second.use_count() == 1)
+        it = m_patterns.erase(it);
+      else
+        ++it;
+    }
+  }
+
+  CCriticalSection m_critSection;
+  std::map<Key, std::shared_ptr<const CompiledPattern>> m_patterns;
+};
+
+namespace
+{
+// number of cached patterns above which patterns not in use anymore are dropped
+constexpr size_t MAX_CACHED_PATTERNS = 256;
+
+#ifdef PCRE_HAS_JIT_CODE
+/* JIT compiled patterns are shared between threads, but a JIT stack can only be used by one
+   thread at a time, so every thread matching a JIT compiled pattern gets its own stack */
+pcre_jit_stack* GetThreadJitStack(void*)
+{
+  struct CJitStack
+  {
+    CJitStack() : m_stack(pcre_jit_stack_alloc(32 * 1024, 512 * 1024))
+    {
+      if (m_stack == NULL)
+        CLog::Log(LOGWARNING, "{}: can't allocate address space for JIT stack", __FUNCTION__);
+    }
+    ~CJitStack()
+    {
+      if (m_stack)
+        pcre_jit_stack_free(m_stack);
+    }
+    pcre_jit_stack* m_stack;
+  };
+  static thread_local CJitStack jitStack;
+  return jitStack.m_stack;
+}
+#endif
+} // unnamed namespace
+
 
 CRegExp::CRegExp(bool caseless /*= false*/, CRegExp::utf8Mode utf8 /*= asciiOnly*/)
 {
@@ -67,7 +143,6 @@ void CRegExp::InitValues(bool caseless /*= false*/, CRegExp::utf8Mode utf8 /*= a
   m_jitCompiled = false;
   m_bMatched    = false;
   m_iMatchCount = 0;
-  m_jitStack    = NULL;
 
   memset(m_iOvector, 0, sizeof(m_iOvector));
 }
@@ -226,7 +301,6 @@ CRegExp::CRegExp(const CRegExp& re)
 {
   m_re = NULL;
   m_sd = NULL;
-  m_jitStack = NULL;
   m_utf8Mode = re.m_utf8Mode;
   m_iOptions = re.m_iOptions;
   *this = re;
@@ -234,27 +308,24 @@ CRegExp::CRegExp(const CRegExp& re)
 
 CRegExp& CRegExp::operator=(const CRegExp& re)
 {
-  size_t size;
+  if (this == &re)
+    return *this;
+
   Cleanup();
-  m_jitCompiled = false;
   m_pattern = re.m_pattern;
-  if (re.m_re)
+  m_jitCompiled = re.m_jitCompiled;
+  if (re.m_compiled)
   {
-    if (pcre_fullinfo(re.m_re, NULL, PCRE_INFO_SIZE, &size) >= 0)
-    {
-      if ((m_re = (pcre*)malloc(size)))
-      {
-        memcpy(m_re, re.m_re, size);
-        memcpy(m_iOvector, re.m_iOvector, OVECCOUNT*sizeof(int));
-        m_offset = re.m_offset;
-        m_iMatchCount = re.m_iMatchCount;
-        m_bMatched = re.m_bMatched;
-        m_subject = re.m_subject;
-        m_iOptions = re.m_iOptions;
-      }
-      else
-        CLog::Log(LOGFATAL, "{}: Failed to allocate memory", __FUNCTION__);
-    }
+    // compiled patterns are immutable, so the copy can share them
+    m_compiled = re.m_compiled;
+    m_re = re.m_re;
+    m_sd = re.m_sd;
+    memcpy(m_iOvector, re.m_iOvector, OVECCOUNT*sizeof(int));
+    m_offset = re.m_offset;
+    m_iMatchCount = re.m_iMatchCount;
+    m_bMatched = re.m_bMatched;
+    m_subject = re.m_subject;
+    m_iOptions = re.m_iOptions;
   }
   return *this;
 }
@@ -273,49 +344,93 @@ bool CRegExp::RegComp(const char *re, studyMode study /*= NoStudy*/)
   m_jitCompiled      = false;
   m_bMatched         = false;
   m_iMatchCount      = 0;
-  const char *errMsg = NULL;
-  int errOffset      = 0;
   int options        = m_iOptions;
   if (m_utf8Mode == autoUtf8 && requireUtf8(re))
     options |= (IsUtf8Supported() ? PCRE_UTF8 : 0) | (AreUnicodePropertiesSupported() ? PCRE_UCP : 0);
 
   Cleanup();
 
-  m_re = pcre_compile(re, options, &errMsg, &errOffset, NULL);
-  if (!m_re)
+  m_compiled = Compile(re, options, study);
+  if (!m_compiled)
   {
     m_pattern.clear();
-    CLog::Log(LOGERROR, "PCRE: {}. Compilation failed at offset {} in expression '{}'", errMsg,
-              errOffset, re);
     return false;
   }
 
+  m_re = m_compiled->m_re;
+  m_sd = m_compiled->m_sd;
+  m_jitCompiled = m_compiled->m_jitCompiled;
   m_pattern = re;
 
+  return true;
+}
+
+std::shared_ptr<const CRegExp::CompiledPattern> CRegExp::Compile(const char* re,
+                                                                 int options,
+                                                                 studyMode study)
+{
+  PatternCache& cache = PatternCache::Get();
+  PatternCache::Key key(re, options, study);
+  {
+    std::unique_lock<CCriticalSection> lock(cache.m_critSection);
+    const auto it = cache.m_patterns.find(key);
+    if (it != cache.m_patterns.end())
+      return it->second;
+  }
+
+  const char *errMsg = NULL;
+  int errOffset      = 0;
+  auto compiled = std::make_shared<CompiledPattern>();
+
+  compiled->m_re = pcre_compile(re, options, &errMsg, &errOffset, NULL);
+  if (!compiled->m_re)
+  {
+    CLog::Log(LOGERROR, "PCRE: {}. Compilation failed at offset {} in expression '{}'", errMsg,
+              errOffset, re);
+    return nullptr;
+  }
+
   if (study)
   {
     const bool jitCompile = (study == StudyWithJitComp) && IsJitSupported();
     const int studyOptions = jitCompile ? PCRE_STUDY_JIT_COMPILE : 0;
 
-    m_sd = pcre_study(m_re, studyOptions, &errMsg);
+    compiled->m_sd = pcre_study(compiled->m_re, studyOptions, &errMsg);
     if (errMsg != NULL)
     {
       CLog::Log(LOGWARNING, "{}: PCRE error \"{}\" while studying expression", __FUNCTION__,
                 errMsg);
-      if (m_sd != NULL)
+      if (compiled->m_sd != NULL)
       {
-        pcre_free_study(m_sd);
-        m_sd = NULL;
+        pcre_free_study(compiled->m_sd);
+        compiled->m_sd = NULL;
       }
     }
     else if (jitCompile)
     {
       int jitPresent = 0;
-      m_jitCompiled = (pcre_fullinfo(m_re, m_sd, PCRE_INFO_JIT, &jitPresent) == 0 && jitPresent == 1);
+      compiled->m_jitCompiled = (pcre_fullinfo(compiled->m_re, compiled->m_sd, PCRE_INFO_JIT,
+                                               &jitPresent) == 0 &&
+                                 jitPresent == 1);
+#ifdef PCRE_HAS_JIT_CODE
+      if (compiled->m_jitCompiled)
+        pcre_assign_jit_stack(compiled->m_sd, GetThreadJitStack, NULL);
+#endif
     }
   }
 
-  return true;
+  std::unique_lock<CCriticalSection> lock(cache.m_critSection);
+  if (cache.m_patterns.size() >= MAX_CACHED_PATTERNS)
+    cache.RemoveUnused();
+  // another thread may have compiled the same pattern in the meantime, use the cached one then
+  return cache.m_patterns.emplace(std::move(key), std::move(compiled)).first->second;
+}
+
+void CRegExp::ClearCache(void)
+{
+  PatternCache& cache = PatternCache::Get();
+  std::unique_lock<CCriticalSection> lock(cache.m_critSection);
+  cache.RemoveUnused();
 }
 
 int CRegExp::RegFind(const char *str, unsigned int startoffset /*= 0*/, int maxNumberOfCharsToTest /*= -1*/)
@@ -347,22 +462,11 @@ int CRegExp::PrivateRegFind(size_t bufferLen, const char *str, unsigned int star
     return -1;
   }
 
-#ifdef PCRE_HAS_JIT_CODE
-  if (m_jitCompiled && !m_jitStack)
-  {
-    m_jitStack = pcre_jit_stack_alloc(32*1024, 512*1024);
-    if (m_jitStack == NULL)
-      CLog::Log(LOGWARNING, "{}: can't allocate address space for JIT stack", __FUNCTION__);
-
-    pcre_assign_jit_stack(m_sd, NULL, m_jitStack);
-  }
-#endif
-
   if (maxNumberOfCharsToTest >= 0)
     bufferLen = std::min<size_t>(bufferLen, startoffset + maxNumberOfCharsToTest);
 
   m_subject.assign(str + startoffset, bufferLen - startoffset);
-  int rc = pcre_exec(m_re, NULL, m_subject.c_str(), m_subject.length(), 0, 0, m_iOvector, OVECCOUNT);
+  int rc = pcre_exec(m_re, m_sd, m_subject.c_str(), m_subject.length(), 0, 0, m_iOvector, OVECCOUNT);
 
   if (rc<1)
   {
@@ -556,25 +660,9 @@ void CRegExp::DumpOvector(int iLog /* = LOGDEBUG */)
 
 void CRegExp::Cleanup()
 {
-  if (m_re)
-  {
-    pcre_free(m_re);
-    m_re = NULL;
-  }
-
-  if (m_sd)
-  {
-    pcre_free_study(m_sd);
-    m_sd = NULL;
-  }
-
-#ifdef PCRE_HAS_JIT_CODE
-  if (m_jitStack)
-  {
-    pcre_jit_stack_free(m_jitStack);
-    m_jitStack = NULL;
-  }
-#endif
+  m_compiled.reset();
+  m_re = NULL;
+  m_sd = NULL;
 }
 
 inline bool CRegExp::IsValidSubNumber(int iSub) const
@@ -10,6 +10,7 @@
 
 //! @todo - move to std::regex (after switching to gcc 4.9 or higher) and get rid of CRegExp
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -65,6 +66,9 @@ public:
 
   /**
    * Compile (prepare) regular expression
+   *
+   * Compiled expressions are cached process-wide and shared by all CRegExp objects compiling the
+   * same expression with the same options, so compiling a recently used expression again is cheap.
    * @param re          The regular expression
    * @param study (optional) Controls study of expression, useful if expression will be used
    *                         several times
@@ -132,8 +136,16 @@ public:
   static bool AreUnicodePropertiesSupported(void);
   static bool LogCheckUtf8Support(void);
   static bool IsJitSupported(void);
+  /**
+   * Drop all cached compiled expressions not in use by any CRegExp object
+   */
+  static void ClearCache(void);
 
 private:
+  struct CompiledPattern;
+  struct PatternCache;
+  static std::shared_ptr<const CompiledPattern> Compile(const char* re, int options, studyMode study);
+
   int PrivateRegFind(size_t bufferLen, const char *str, unsigned int startoffset = 0, int maxNumberOfCharsToTest = -1);
   void InitValues(bool caseless = false, CRegExp::utf8Mode utf8 = asciiOnly);
   static bool requireUtf8(const std::string& regexp);
@@ -143,8 +155,9 @@ private:
   void Cleanup();
   inline bool IsValidSubNumber(int iSub) const;
 
-  PCRE::pcre* m_re;
-  PCRE::pcre_extra* m_sd;
+  std::shared_ptr<const CompiledPattern> m_compiled;
+  PCRE::pcre* m_re; // owned by m_compiled
+  PCRE::pcre_extra* m_sd; // owned by m_compiled
   static const int OVECCOUNT=(m_MaxNumOfBackrefrences + 1) * 3;
   unsigned int m_offset;
   int         m_iOvector[OVECCOUNT];
@@ -153,7 +166,6 @@ private:
   int         m_iOptions;
   bool        m_jitCompiled;
   bool        m_bMatched;
-  PCRE::pcre_jit_stack* m_jitStack;
   std::string m_subject;
   std::string m_pattern;
   static int  m_Utf8Supported;
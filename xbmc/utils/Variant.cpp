@@ -144,7 +144,7 @@ CVariant::CVariant(VariantType type)
       m_data.dvalue = 0.0;
       break;
     case VariantTypeString:
-      m_data.string = new std::string();
+      assignString("", 0);
       break;
     case VariantTypeWideString:
       m_data.wstring = new std::wstring();
@@ -207,26 +207,22 @@ CVariant::CVariant(bool boolean)
 
 CVariant::CVariant(const char *str)
 {
-  m_type = VariantTypeString;
-  m_data.string = new std::string(str);
+  assignString(str, strlen(str));
 }
 
 CVariant::CVariant(const char *str, unsigned int length)
 {
-  m_type = VariantTypeString;
-  m_data.string = new std::string(str, length);
+  assignString(str, length);
 }
 
 CVariant::CVariant(const std::string &str)
 {
-  m_type = VariantTypeString;
-  m_data.string = new std::string(str);
+  assignString(str.c_str(), str.size());
 }
 
 CVariant::CVariant(std::string &&str)
 {
-  m_type = VariantTypeString;
-  m_data.string = new std::string(std::move(str));
+  assignString(std::move(str));
 }
 
 CVariant::CVariant(const wchar_t *str)
@@ -262,12 +258,21 @@ CVariant::CVariant(const std::vector<std::string> &strArray)
     m_data.array->push_back(CVariant(item));
 }
 
+CVariant::CVariant(std::vector<std::string>&& strArray)
+{
+  m_type = VariantTypeArray;
+  m_data.array = new VariantArray;
+  m_data.array->reserve(strArray.size());
+  for (auto& item : strArray)
+    m_data.array->emplace_back(std::move(item));
+}
+
 CVariant::CVariant(const std::map<std::string, std::string> &strMap)
 {
   m_type = VariantTypeObject;
   m_data.map = new VariantMap;
-  for (std::map<std::string, std::string>::const_iterator it = strMap.begin(); it != strMap.end(); ++it)
-    m_data.map->insert(make_pair(it->first, CVariant(it->second)));
+  for (const auto& it : strMap)
+    m_data.map->emplace_hint(m_data.map->end(), it.first, CVariant(it.second));
 }
 
 CVariant::CVariant(const std::map<std::string, CVariant> &variantMap)
@@ -276,6 +281,12 @@ CVariant::CVariant(const std::map<std::string, CVariant> &variantMap)
   m_data.map = new VariantMap(variantMap.begin(), variantMap.end());
 }
 
+CVariant::CVariant(std::map<std::string, CVariant>&& variantMap)
+{
+  m_type = VariantTypeObject;
+  m_data.map = new VariantMap(std::move(variantMap));
+}
+
 CVariant::CVariant(const CVariant &variant)
 {
   m_type = VariantTypeNull;
@@ -301,8 +312,10 @@ void CVariant::cleanup()
   switch (m_type)
   {
   case VariantTypeString:
-    delete m_data.string;
+    if (!m_smallString)
+      delete m_data.string;
     m_data.string = nullptr;
+    m_smallString = false;
     break;
 
   case VariantTypeWideString:
@@ -325,6 +338,39 @@ void CVariant::cleanup()
   m_type = VariantTypeNull;
 }
 
+void CVariant::assignString(const char* str, size_t length)
+{
+  m_type = VariantTypeString;
+  m_smallString = length < sizeof(m_data.smallString.data);
+  if (m_smallString)
+  {
+    memcpy(m_data.smallString.data, str, length);
+    m_data.smallString.data[length] = '\0';
+    m_data.smallString.length = static_cast<uint8_t>(length);
+  }
+  else
+    m_data.string = new std::string(str, length);
+}
+
+void CVariant::assignString(std::string&& str)
+{
+  if (str.size() < sizeof(m_data.smallString.data))
+    assignString(str.c_str(), str.size());
+  else
+  {
+    m_type = VariantTypeString;
+    m_smallString = false;
+    m_data.string = new std::string(std::move(str));
+  }
+}
+
+std::string_view CVariant::stringValue() const
+{
+  if (m_smallString)
+    return std::string_view(m_data.smallString.data, m_data.smallString.length);
+  return *m_data.string;
+}
+
 bool CVariant::isInteger() const
 {
   return isSignedInteger() || isUnsignedInteger();
@@ -391,7 +437,7 @@ int64_t CVariant::asInteger(int64_t fallback) const
     case VariantTypeDouble:
       return (int64_t)m_data.dvalue;
     case VariantTypeString:
-      return str2int64(*m_data.string, fallback);
+      return str2int64(std::string(stringValue()), fallback);
     case VariantTypeWideString:
       return str2int64(*m_data.wstring, fallback);
     default:
@@ -417,7 +463,7 @@ uint64_t CVariant::asUnsignedInteger(uint64_t fallback) const
     case VariantTypeDouble:
       return (uint64_t)m_data.dvalue;
     case VariantTypeString:
-      return str2uint64(*m_data.string, fallback);
+      return str2uint64(std::string(stringValue()), fallback);
     case VariantTypeWideString:
       return str2uint64(*m_data.wstring, fallback);
     default:
@@ -443,7 +489,7 @@ double CVariant::asDouble(double fallback) const
     case VariantTypeUnsignedInteger:
       return (double)m_data.unsignedinteger;
     case VariantTypeString:
-      return str2double(*m_data.string, fallback);
+      return str2double(std::string(stringValue()), fallback);
     case VariantTypeWideString:
       return str2double(*m_data.wstring, fallback);
     default:
@@ -464,7 +510,7 @@ float CVariant::asFloat(float fallback) const
     case VariantTypeUnsignedInteger:
       return (float)m_data.unsignedinteger;
     case VariantTypeString:
-      return (float)str2double(*m_data.string, static_cast<double>(fallback));
+      return (float)str2double(std::string(stringValue()), static_cast<double>(fallback));
     case VariantTypeWideString:
       return (float)str2double(*m_data.wstring, static_cast<double>(fallback));
     default:
@@ -487,9 +533,10 @@ bool CVariant::asBoolean(bool fallback) const
     case VariantTypeDouble:
       return (m_data.dvalue != 0);
     case VariantTypeString:
-      if (m_data.string->empty() || m_data.string->compare("0") == 0 || m_data.string->compare("false") == 0)
-        return false;
-      return true;
+    {
+      const std::string_view value = stringValue();
+      return !(value.empty() || value == "0" || value == "false");
+    }
     case VariantTypeWideString:
       if (m_data.wstring->empty() || m_data.wstring->compare(L"0") == 0 || m_data.wstring->compare(L"false") == 0)
         return false;
@@ -506,7 +553,7 @@ std::string CVariant::asString(const std::string& fallback /* = "" */) const&
   switch (m_type)
   {
     case VariantTypeString:
-      return *m_data.string;
+      return std::string(stringValue());
     case VariantTypeBoolean:
       return m_data.boolean ? "true" : "false";
     case VariantTypeInteger:
@@ -524,7 +571,7 @@ std::string CVariant::asString(const std::string& fallback /* = "" */) const&
 
 std::string CVariant::asString(const std::string& fallback /*= ""*/) &&
 {
-  if (m_type == VariantTypeString)
+  if (m_type == VariantTypeString && !m_smallString)
     return std::move(*m_data.string);
   else
     return asString(fallback);
@@ -573,6 +620,20 @@ CVariant& CVariant::operator[](const std::string& key) &
     return ConstNullVariant;
 }
 
+CVariant& CVariant::operator[](std::string&& key) &
+{
+  if (m_type == VariantTypeNull)
+  {
+    m_type = VariantTypeObject;
+    m_data.map = new VariantMap;
+  }
+
+  if (m_type == VariantTypeObject)
+    return (*m_data.map)[std::move(key)];
+  else
+    return ConstNullVariant;
+}
+
 const CVariant& CVariant::operator[](const std::string& key) const&
 {
   VariantMap::const_iterator it;
@@ -638,8 +699,11 @@ CVariant &CVariant::operator=(const CVariant &rhs)
     m_data.dvalue = rhs.m_data.dvalue;
     break;
   case VariantTypeString:
-    m_data.string = new std::string(*rhs.m_data.string);
+  {
+    const std::string_view value = rhs.stringValue();
+    assignString(value.data(), value.size());
     break;
+  }
   case VariantTypeWideString:
     m_data.wstring = new std::wstring(*rhs.m_data.wstring);
     break;
@@ -647,7 +711,7 @@ CVariant &CVariant::operator=(const CVariant &rhs)
     m_data.array = new VariantArray(rhs.m_data.array->begin(), rhs.m_data.array->end());
     break;
   case VariantTypeObject:
-    m_data.map = new VariantMap(rhs.m_data.map->begin(), rhs.m_data.map->end());
+    m_data.map = new VariantMap(*rhs.m_data.map);
     break;
   default:
     break;
@@ -666,6 +730,7 @@ CVariant& CVariant::operator=(CVariant&& rhs) noexcept
     cleanup();
 
   m_type = rhs.m_type;
+  m_smallString = rhs.m_smallString;
   m_data = rhs.m_data;
 
   //Should be enough to just set m_type here
@@ -680,6 +745,7 @@ CVariant& CVariant::operator=(CVariant&& rhs) noexcept
     rhs.m_data.map = nullptr;
 
   rhs.m_type = VariantTypeNull;
+  rhs.m_smallString = false;
 
   return *this;
 }
@@ -699,7 +765,7 @@ bool CVariant::operator==(const CVariant &rhs) const
     case VariantTypeDouble:
       return m_data.dvalue == rhs.m_data.dvalue;
     case VariantTypeString:
-      return *m_data.string == *rhs.m_data.string;
+      return stringValue() == rhs.stringValue();
     case VariantTypeWideString:
       return *m_data.wstring == *rhs.m_data.wstring;
     case VariantTypeArray:
@@ -762,21 +828,16 @@ void CVariant::append(CVariant&& variant)
 const char *CVariant::c_str() const
 {
   if (m_type == VariantTypeString)
-    return m_data.string->c_str();
+    return m_smallString ? m_data.smallString.data : m_data.string->c_str();
   else
     return NULL;
 }
 
 void CVariant::swap(CVariant &rhs)
 {
-  VariantType  temp_type = m_type;
-  VariantUnion temp_data = m_data;
-
-  m_type = rhs.m_type;
-  m_data = rhs.m_data;
-
-  rhs.m_type = temp_type;
-  rhs.m_data = temp_data;
+  std::swap(m_type, rhs.m_type);
+  std::swap(m_smallString, rhs.m_smallString);
+  std::swap(m_data, rhs.m_data);
 }
 
 CVariant::iterator_array CVariant::begin_array()
@@ -850,7 +911,7 @@ unsigned int CVariant::size() const
   else if (m_type == VariantTypeArray)
     return m_data.array->size();
   else if (m_type == VariantTypeString)
-    return m_data.string->size();
+    return stringValue().size();
   else if (m_type == VariantTypeWideString)
     return m_data.wstring->size();
   else
@@ -864,7 +925,7 @@ bool CVariant::empty() const
   else if (m_type == VariantTypeArray)
     return m_data.array->empty();
   else if (m_type == VariantTypeString)
-    return m_data.string->empty();
+    return stringValue().empty();
   else if (m_type == VariantTypeWideString)
     return m_data.wstring->empty();
   else if (m_type == VariantTypeNull)
@@ -879,6 +940,8 @@ void CVariant::clear()
     m_data.map->clear();
   else if (m_type == VariantTypeArray)
     m_data.array->clear();
+  else if (m_type == VariantTypeString && m_smallString)
+    assignString("", 0);
   else if (m_type == VariantTypeString)
     m_data.string->clear();
   else if (m_type == VariantTypeWideString)
@@ -11,6 +11,8 @@
 #include <map>
 #include <stdint.h>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 #include <wchar.h>
 
@@ -61,8 +63,10 @@ public:
   CVariant(const std::wstring &str);
   CVariant(std::wstring &&str);
   CVariant(const std::vector<std::string> &strArray);
+  CVariant(std::vector<std::string>&& strArray);
   CVariant(const std::map<std::string, std::string> &strMap);
   CVariant(const std::map<std::string, CVariant> &variantMap);
+  CVariant(std::map<std::string, CVariant>&& variantMap);
   CVariant(const CVariant &variant);
   CVariant(CVariant&& rhs) noexcept;
   ~CVariant();
@@ -95,6 +99,7 @@ public:
   float asFloat(float fallback = 0.0f) const;
 
   CVariant& operator[](const std::string& key) &;
+  CVariant& operator[](std::string&& key) &;
   const CVariant& operator[](const std::string& key) const&;
   CVariant operator[](const std::string& key) &&;
   CVariant& operator[](unsigned int position) &;
@@ -149,6 +154,17 @@ public:
 
 private:
   void cleanup();
+  void assignString(const char* str, size_t length);
+  void assignString(std::string&& str);
+  std::string_view stringValue() const;
+
+  // strings short enough are stored in place instead of on the heap
+  struct SmallString
+  {
+    char data[15]; // null terminated
+    uint8_t length;
+  };
+
   union VariantUnion
   {
     int64_t integer;
@@ -156,12 +172,14 @@ private:
     bool boolean;
     double dvalue;
     std::string *string;
+    SmallString smallString;
     std::wstring *wstring;
     VariantArray *array;
     VariantMap *map;
   };
 
   VariantType m_type;
+  bool m_smallString = false;
   VariantUnion m_data;
 
   static VariantArray EMPTY_ARRAY;
@@ -17,6 +17,7 @@
 #include "settings/SettingsComponent.h"
 #include "settings/lib/Setting.h"
 #include "settings/lib/SettingsManager.h"
+#include "utils/AsyncLogSink.h"
 #include "utils/StringUtils.h"
 #include "utils/URIUtils.h"
 
@@ -32,11 +33,13 @@ namespace
 static constexpr unsigned char Utf8Bom[3] = {0xEF, 0xBB, 0xBF};
 static const std::string LogFileExtension = ".log";
 static const std::string LogPattern = "%Y-%m-%d %T.%e T:%-5t %7l <%n>: %v";
+static constexpr size_t LogQueueSize = 16384;
 } // namespace
 
 CLog::CLog()
   : m_platform(IPlatformLog::CreatePlatformLog()),
     m_sinks(std::make_shared<spdlog::sinks::dist_sink_mt>()),
+    m_writeThroughSink(std::make_shared<CAsyncLogWriteThroughSink>()),
     m_defaultLogger(CreateLogger("general")),
     m_logLevel(LOG_LEVEL_DEBUG),
     m_componentLogEnabled(false),
@@ -127,10 +130,16 @@ void CLog::Initialize(const std::string& path)
       m_platform->GetLogFilename(filePath), false);
   basicFileSink->set_pattern(LogPattern);
   duplicateFilterSink->add_sink(basicFileSink);
-  m_fileSink = duplicateFilterSink;
+
+  // write the file on a background thread
+  m_fileSink = std::make_shared<CAsyncLogSink>(duplicateFilterSink, LogQueueSize,
+                                               m_dropOnOverflow
+                                                   ? CAsyncLogSink::OverflowPolicy::DROP
+                                                   : CAsyncLogSink::OverflowPolicy::BLOCK);
 
   // add it to the existing sinks
   m_sinks->add_sink(m_fileSink);
+  m_writeThroughSink->SetSink(m_fileSink);
 }
 
 void CLog::UnregisterFromSettings()
@@ -151,14 +160,28 @@ void CLog::Deinitialize()
   // flush all loggers
   spdlog::apply_all([](const std::shared_ptr<spdlog::logger>& logger) { logger->flush(); });
 
-  // flush the file sink
-  m_fileSink->flush();
+  // write everything still queued for the file sink
+  m_fileSink->Drain();
+
+  const CAsyncLogSink::Stats stats = m_fileSink->GetStats();
+  if (stats.m_dropped > 0 || stats.m_blocked > 0)
+    m_defaultLogger->info("Log writer dropped {} and blocked on {} of {} messages",
+                          stats.m_dropped, stats.m_blocked, stats.m_written);
 
-  // remove and destroy the file sink
+  // remove and destroy the file sink, which writes anything still queued
+  m_writeThroughSink->SetSink(nullptr);
   m_sinks->remove_sink(m_fileSink);
   m_fileSink.reset();
 }
 
+void CLog::SetDropOnOverflow(bool drop)
+{
+  m_dropOnOverflow = drop;
+  if (m_fileSink != nullptr)
+    m_fileSink->SetOverflowPolicy(drop ? CAsyncLogSink::OverflowPolicy::DROP
+                                       : CAsyncLogSink::OverflowPolicy::BLOCK);
+}
+
 void CLog::SetLogLevel(int level)
 {
   if (level < LOG_LEVEL_NONE || level > LOG_LEVEL_MAX)
@@ -277,7 +300,9 @@ spdlog::level::level_enum CLog::MapLogLevel(int level)
 Logger CLog::CreateLogger(const std::string& loggerName)
 {
   // create the logger
-  auto logger = std::make_shared<spdlog::logger>(loggerName, m_sinks);
+  // errors are written through outside of the lock of the distributing sink
+  auto logger = std::make_shared<spdlog::logger>(
+      loggerName, spdlog::sinks_init_list{m_sinks, m_writeThroughSink});
 
   // initialize the logger
   spdlog::initialize_logger(logger);
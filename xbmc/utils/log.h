@@ -35,6 +35,9 @@
 
 #include <spdlog/spdlog.h>
 
+class CAsyncLogSink;
+class CAsyncLogWriteThroughSink;
+
 namespace spdlog
 {
 namespace sinks
@@ -64,6 +67,10 @@ public:
 
   void SetLogLevel(int level);
   int GetLogLevel() { return m_logLevel; }
+  /*!
+   \brief Whether to drop messages rather than wait when the log file writer falls behind.
+   */
+  void SetDropOnOverflow(bool drop);
   bool IsLogLevelLogged(int loglevel);
 
   bool CanLogComponent(uint32_t component) const;
@@ -142,9 +149,11 @@ private:
 
   std::unique_ptr<IPlatformLog> m_platform;
   std::shared_ptr<spdlog::sinks::dist_sink<std::mutex>> m_sinks;
+  std::shared_ptr<CAsyncLogWriteThroughSink> m_writeThroughSink;
   Logger m_defaultLogger;
 
-  std::shared_ptr<spdlog::sinks::sink> m_fileSink;
+  std::shared_ptr<CAsyncLogSink> m_fileSink;
+  bool m_dropOnOverflow = false;
 
   int m_logLevel;
 
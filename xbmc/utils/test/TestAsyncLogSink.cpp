@@ -0,0 +1,152 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "utils/AsyncLogSink.h"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <spdlog/common.h>
+#include <spdlog/logger.h>
+#include <spdlog/sinks/base_sink.h>
+#include <spdlog/sinks/dist_sink.h>
+
+namespace
+{
+class CTestSink : public spdlog::sinks::base_sink<std::mutex>
+{
+public:
+  std::vector<std::string> m_messages;
+  std::atomic<bool> m_slow{false};
+
+protected:
+  void sink_it_(const spdlog::details::log_msg& msg) override
+  {
+    if (m_slow)
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    m_messages.emplace_back(msg.payload.data(), msg.payload.size());
+  }
+  void flush_() override {}
+};
+
+class CFailingSink : public spdlog::sinks::base_sink<std::mutex>
+{
+protected:
+  void sink_it_(const spdlog::details::log_msg& msg) override
+  {
+    throw spdlog::spdlog_ex("No space left on device");
+  }
+  void flush_() override {}
+};
+
+void Log(CAsyncLogSink& sink, spdlog::level::level_enum level, const std::string& message)
+{
+  sink.log(spdlog::details::log_msg("test", level, message));
+}
+} // namespace
+
+TEST(TestAsyncLogSink, WritesInOrder)
+{
+  auto target = std::make_shared<CTestSink>();
+  {
+    CAsyncLogSink sink(target, 16);
+    for (int i = 0; i < 1000; ++i)
+      Log(sink, spdlog::level::debug, std::to_string(i));
+    sink.Drain();
+
+    EXPECT_EQ(1000U, sink.GetStats().m_written);
+    EXPECT_EQ(0U, sink.GetStats().m_dropped);
+  }
+
+  ASSERT_EQ(1000U, target->m_messages.size());
+  for (int i = 0; i < 1000; ++i)
+    EXPECT_EQ(std::to_string(i), target->m_messages[i]);
+}
+
+TEST(TestAsyncLogSink, ErrorsAreWrittenThrough)
+{
+  auto target = std::make_shared<CTestSink>();
+  auto sink = std::make_shared<CAsyncLogSink>(target, 16);
+  auto sinks = std::make_shared<spdlog::sinks::dist_sink_mt>();
+  sinks->add_sink(sink);
+  auto writeThroughSink = std::make_shared<CAsyncLogWriteThroughSink>();
+  writeThroughSink->SetSink(sink);
+  spdlog::logger logger("test", spdlog::sinks_init_list{sinks, writeThroughSink});
+  logger.set_level(spdlog::level::trace);
+
+  logger.debug("debug");
+  logger.error("error");
+
+  // no Drain() needed
+  EXPECT_EQ(2U, sink->GetStats().m_written);
+
+  writeThroughSink->SetSink(nullptr);
+}
+
+TEST(TestAsyncLogSink, SurvivesFailingSink)
+{
+  auto target = std::make_shared<CFailingSink>();
+  CAsyncLogSink sink(target, 16);
+  Log(sink, spdlog::level::debug, "debug");
+  Log(sink, spdlog::level::err, "error");
+  sink.Drain();
+
+  const CAsyncLogSink::Stats stats = sink.GetStats();
+  EXPECT_EQ(0U, stats.m_written);
+  EXPECT_GT(stats.m_failed, 0U);
+}
+
+TEST(TestAsyncLogSink, DropsOnOverflow)
+{
+  auto target = std::make_shared<CTestSink>();
+  target->m_slow = true;
+  {
+    CAsyncLogSink sink(target, 4, CAsyncLogSink::OverflowPolicy::DROP);
+    for (int i = 0; i < 100; ++i)
+      Log(sink, spdlog::level::debug, "message");
+    sink.Drain();
+
+    const CAsyncLogSink::Stats stats = sink.GetStats();
+    EXPECT_GT(stats.m_dropped, 0U);
+    EXPECT_EQ(100U, stats.m_written + stats.m_dropped);
+  }
+
+  // the number of dropped messages is reported in the log
+  bool reported = false;
+  for (const auto& message : target->m_messages)
+    reported |= message.find("log messages dropped") != std::string::npos;
+  EXPECT_TRUE(reported);
+}
+
+TEST(TestAsyncLogSink, ReportsDropsWhenStopped)
+{
+  auto target = std::make_shared<CTestSink>();
+  target->m_slow = true;
+  uint64_t dropped = 0;
+  {
+    CAsyncLogSink sink(target, 4, CAsyncLogSink::OverflowPolicy::DROP);
+    for (int i = 0; i < 100; ++i)
+      Log(sink, spdlog::level::debug, "message");
+    dropped = sink.GetStats().m_dropped;
+  }
+
+  // every dropped message is reported, even without draining the sink
+  uint64_t reported = 0;
+  for (const auto& message : target->m_messages)
+  {
+    if (message.find("log messages dropped") != std::string::npos)
+      reported += std::stoull(message);
+  }
+  EXPECT_GT(dropped, 0U);
+  EXPECT_EQ(dropped, reported);
+}
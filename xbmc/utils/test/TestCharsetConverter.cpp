@@ -12,6 +12,9 @@
 #include "utils/CharsetConverter.h"
 #include "utils/Utf8Utils.h"
 
+#include <thread>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #if 0
@@ -399,3 +402,64 @@ TEST_F(TestCharsetConverter, fromW)
   g_charsetConverter.fromW(refstrw1, varstra1, "UTF-16LE");
   EXPECT_STREQ(refstra1.c_str(), varstra1.c_str());
 }
+
+TEST_F(TestCharsetConverter, utf8ToUtf32_ASCII)
+{
+  refstra1 = "test utf8ToUtf32 with\ta tab and an embedded";
+  refstra1.push_back('\0');
+  refstra1 += "null";
+  std::u32string utf32;
+  EXPECT_TRUE(g_charsetConverter.utf8ToUtf32(refstra1, utf32));
+  ASSERT_EQ(refstra1.length(), utf32.length());
+  for (size_t i = 0; i < refstra1.length(); i++)
+    EXPECT_EQ(static_cast<char32_t>(refstra1[i]), utf32[i]);
+
+  varstra1.clear();
+  EXPECT_TRUE(g_charsetConverter.utf32ToUtf8(utf32, varstra1));
+  EXPECT_EQ(refstra1, varstra1);
+}
+
+TEST_F(TestCharsetConverter, utf8ToUtf32_NonASCIIAfterASCII)
+{
+  // the first non ASCII character only shows up after the first eight bytes
+  refstra1 = "abcdefghij\xC3\xA9";
+  EXPECT_EQ(U"abcdefghij\u00E9", g_charsetConverter.utf8ToUtf32(refstra1));
+}
+
+TEST_F(TestCharsetConverter, ConcurrentConversions)
+{
+  const std::string ascii = "Some Movie Title (2024) - S01E01.mkv";
+  const std::string nonAscii = u8"ｔｅｓｔ＿ｃｏｎｃｕｒｒｅｎｔ Amélie (2001).mkv";
+  std::wstring asciiW;
+  std::wstring nonAsciiW;
+  ASSERT_TRUE(g_charsetConverter.utf8ToW(ascii, asciiW, false));
+  ASSERT_TRUE(g_charsetConverter.utf8ToW(nonAscii, nonAsciiW, false));
+
+  // every thread has its own iconv descriptors, which must not mix up the conversions
+  const unsigned int threads = 4;
+  const int iterations = 1000;
+  std::vector<int> failures(threads, 0);
+
+  std::vector<std::thread> workers;
+  for (unsigned int t = 0; t < threads; t++)
+  {
+    workers.emplace_back([&, t]() {
+      std::wstring wide;
+      std::string utf8;
+      for (int i = 0; i < iterations; i++)
+      {
+        const bool useAscii = (i % 2) == 0;
+        if (!g_charsetConverter.utf8ToW(useAscii ? ascii : nonAscii, wide, false) ||
+            wide != (useAscii ? asciiW : nonAsciiW))
+          failures[t]++;
+        if (!g_charsetConverter.wToUTF8(wide, utf8) || utf8 != (useAscii ? ascii : nonAscii))
+          failures[t]++;
+      }
+    });
+  }
+  for (auto& worker : workers)
+    worker.join();
+
+  for (unsigned int t = 0; t < threads; t++)
+    EXPECT_EQ(0, failures[t]) << "thread " << t;
+}
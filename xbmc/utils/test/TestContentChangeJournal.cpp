@@ -0,0 +1,130 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "filesystem/Directory.h"
+#include "filesystem/File.h"
+#include "test/TestUtils.h"
+#include "utils/ContentChangeJournal.h"
+#include "utils/URIUtils.h"
+
+#include <chrono>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#if defined(HAVE_INOTIFY)
+namespace
+{
+bool WaitForHashDropped(const CContentChangeJournal& journal, const std::string& path)
+{
+  // changes are picked up asynchronously
+  for (int i = 0; i < 50 && !journal.GetHash(path).empty(); ++i)
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  return journal.GetHash(path).empty();
+}
+} // namespace
+
+class TestContentChangeJournal : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    ASSERT_NE(nullptr, (m_tmpfile = XBMC_CREATETEMPFILE("")));
+    const std::string tmpfilepath = XBMC_TEMPFILEPATH(m_tmpfile);
+    m_tmpfile->Close();
+
+    m_dir = URIUtils::AddFileToFolder(URIUtils::GetDirectory(tmpfilepath), "journal");
+    URIUtils::AddSlashAtEnd(m_dir);
+    ASSERT_TRUE(XFILE::CDirectory::Create(m_dir));
+    m_subDir = URIUtils::AddFileToFolder(m_dir, "sub");
+    URIUtils::AddSlashAtEnd(m_subDir);
+    ASSERT_TRUE(XFILE::CDirectory::Create(m_subDir));
+  }
+
+  void TearDown() override
+  {
+    XFILE::CDirectory::RemoveRecursive(m_dir);
+    if (m_tmpfile)
+      XBMC_DELETETEMPFILE(m_tmpfile);
+  }
+
+  void CreateFile(const std::string& dir)
+  {
+    XFILE::CFile newFile;
+    ASSERT_TRUE(newFile.OpenForWrite(URIUtils::AddFileToFolder(dir, "file"), true));
+    newFile.Close();
+  }
+
+  XFILE::CFile* m_tmpfile = nullptr;
+  std::string m_dir;
+  std::string m_subDir;
+};
+
+TEST_F(TestContentChangeJournal, ForgetsHashOnChange)
+{
+  CContentChangeJournal journal;
+  journal.Start();
+
+  ASSERT_TRUE(journal.Track(m_dir));
+  journal.SetHash(m_dir, "hash");
+  EXPECT_EQ("hash", journal.GetHash(m_dir));
+
+  CreateFile(m_dir);
+  EXPECT_TRUE(WaitForHashDropped(journal, m_dir));
+}
+
+TEST_F(TestContentChangeJournal, ForgetsHashOfOtherOptions)
+{
+  CContentChangeJournal journal;
+  journal.Start();
+
+  ASSERT_TRUE(journal.Track(m_dir));
+  journal.SetHash(m_dir, "hash", "excludes");
+  EXPECT_EQ("hash", journal.GetHash(m_dir, "excludes"));
+  EXPECT_EQ("", journal.GetHash(m_dir, "other excludes"));
+  EXPECT_EQ("", journal.GetHash(m_dir));
+}
+
+TEST_F(TestContentChangeJournal, LimitsWatches)
+{
+  CContentChangeJournal journal(1);
+  journal.Start();
+
+  EXPECT_FALSE(journal.Track(m_dir, {m_subDir}));
+  ASSERT_TRUE(journal.Track(m_subDir));
+  journal.SetHash(m_subDir, "hash");
+  EXPECT_FALSE(journal.Track(m_dir));
+
+  // dropping the hash removes its watch
+  CreateFile(m_subDir);
+  EXPECT_TRUE(WaitForHashDropped(journal, m_subDir));
+  EXPECT_TRUE(journal.Track(m_dir));
+}
+
+TEST_F(TestContentChangeJournal, StopForgetsHashes)
+{
+  CContentChangeJournal journal;
+  journal.Start();
+
+  ASSERT_TRUE(journal.Track(m_dir));
+  journal.SetHash(m_dir, "hash");
+  journal.Stop();
+  EXPECT_EQ("", journal.GetHash(m_dir));
+  EXPECT_FALSE(journal.Track(m_dir));
+}
+#endif
+
+TEST(TestContentChangeJournalRemote, IgnoresRemotePaths)
+{
+  CContentChangeJournal journal;
+  journal.Start();
+
+  EXPECT_FALSE(journal.Track("smb://server/share/movies/"));
+  journal.SetHash("smb://server/share/movies/", "hash");
+  EXPECT_EQ("", journal.GetHash("smb://server/share/movies/"));
+}
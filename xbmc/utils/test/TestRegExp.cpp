@@ -17,6 +17,11 @@
 #include "utils/StringUtils.h"
 #include "utils/log.h"
 
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 TEST(TestRegExp, RegFind)
@@ -123,6 +128,97 @@ TEST(TestRegExp, operatorEqual)
   EXPECT_STREQ("string", match.c_str());
 }
 
+TEST(TestRegExp, SharedCompiledPattern)
+{
+  CRegExp first(true, CRegExp::autoUtf8);
+  CRegExp second(true, CRegExp::autoUtf8);
+
+  EXPECT_TRUE(first.RegComp("s([0-9]+)e([0-9]+)", CRegExp::StudyWithJitComp));
+  EXPECT_TRUE(second.RegComp("s([0-9]+)e([0-9]+)", CRegExp::StudyWithJitComp));
+  EXPECT_EQ(5, first.RegFind("Show.S01E02.mkv"));
+  EXPECT_EQ(5, second.RegFind("Show.S03E04.mkv"));
+  // the objects share the compiled pattern, but not their matches
+  EXPECT_STREQ("01", first.GetMatch(1).c_str());
+  EXPECT_STREQ("04", second.GetMatch(2).c_str());
+
+  // same pattern with different options must not share the compiled pattern
+  CRegExp caseSensitive(false, CRegExp::autoUtf8);
+  EXPECT_TRUE(caseSensitive.RegComp("s([0-9]+)e([0-9]+)", CRegExp::StudyWithJitComp));
+  EXPECT_EQ(-1, caseSensitive.RegFind("Show.S01E02.mkv"));
+
+  CRegExp::ClearCache();
+  EXPECT_EQ(5, first.RegFind("Show.S05E06.mkv"));
+  EXPECT_STREQ("06", first.GetMatch(2).c_str());
+}
+
+TEST(TestRegExp, ConcurrentMatching)
+{
+  CRegExp regex(true, CRegExp::autoUtf8, "s([0-9]+)e([0-9]+)", CRegExp::StudyWithJitComp);
+  ASSERT_TRUE(regex.IsCompiled());
+
+  std::vector<std::thread> threads;
+  std::vector<int> failures(4, 0);
+  for (int t = 0; t < 4; t++)
+  {
+    threads.emplace_back([&, t]() {
+      CRegExp copy(regex);
+      for (int i = 0; i < 10000; i++)
+      {
+        const std::string name = "Show.S" + std::to_string(t) + "E" + std::to_string(i) + ".mkv";
+        if (copy.RegFind(name) != 5 || copy.GetMatch(2) != std::to_string(i))
+          failures[t]++;
+      }
+    });
+  }
+  for (auto& thread : threads)
+    thread.join();
+
+  for (int t = 0; t < 4; t++)
+    EXPECT_EQ(0, failures[t]);
+}
+
+TEST(TestRegExp, EpisodeMatching)
+{
+  // a subset of the default tv show episode expressions from advancedsettings
+  const std::vector<std::string> expressions = {
+      "s([0-9]+)[ ._x-]*e([0-9]+(?:(?:[a-i]|\\.[1-9])(?![0-9]))?)([^\\\\/]*)$",
+      "([0-9]{4})[\\.-]([0-9]{2})[\\.-]([0-9]{2})",
+      "[\\\\/\\._ \\[\\(-]([0-9]+)x([0-9]+(?:(?:[a-i]|\\.[1-9])(?![0-9]))?)([^\\\\/]*)$",
+  };
+  // name, index of the first matching expression, first and second match
+  const std::vector<std::tuple<std::string, size_t, std::string, std::string>> files = {
+      {"/tv/Show/Show.S01E02.720p.mkv", 0, "01", "02"},
+      {"/tv/Show/Show.s3e14a.mkv", 0, "3", "14a"},
+      {"/tv/Show/Show.2024.05.17.mkv", 1, "2024", "05"},
+      {"/tv/Show/Show.4x07.mkv", 2, "4", "07"},
+      {"/tv/Show/Show.10x1.5.mkv", 2, "10", "1.5"},
+  };
+
+  // compile the expressions for every file, the way the library scanner does, which is served
+  // by the pattern cache after the first file
+  for (int pass = 0; pass < 2; pass++)
+  {
+    for (const auto& [name, expected, first, second] : files)
+    {
+      size_t matched = expressions.size();
+      CRegExp reg(true, CRegExp::autoUtf8);
+      for (size_t i = 0; i < expressions.size(); i++)
+      {
+        ASSERT_TRUE(reg.RegComp(expressions[i], CRegExp::StudyWithJitComp));
+        if (reg.RegFind(name) >= 0)
+        {
+          matched = i;
+          break;
+        }
+      }
+
+      ASSERT_EQ(expected, matched) << name;
+      EXPECT_EQ(first, reg.GetMatch(1)) << name;
+      EXPECT_EQ(second, reg.GetMatch(2)) << name;
+    }
+  }
+}
+
 class TestRegExpLog : public testing::Test
 {
 protected:
@@ -8,6 +8,10 @@
 
 #include "utils/Variant.h"
 
+#include <map>
+#include <string>
+#include <utility>
+
 #include <gtest/gtest.h>
 
 TEST(TestVariant, VariantTypeInteger)
@@ -332,3 +336,71 @@ TEST(TestVariant, isMember)
   EXPECT_TRUE(a.isMember("key1"));
   EXPECT_FALSE(a.isMember("key2"));
 }
+
+TEST(TestVariant, SmallAndLongStrings)
+{
+  const std::string small("short");
+  const std::string embeddedNull("a\0b", 3);
+  const std::string longString("a string too long to be stored inline");
+
+  CVariant a(small), b(embeddedNull), c(longString);
+  EXPECT_EQ(small, a.asString());
+  EXPECT_EQ(embeddedNull, b.asString());
+  EXPECT_EQ(3u, b.size());
+  EXPECT_EQ(longString, c.asString());
+  EXPECT_STREQ(longString.c_str(), c.c_str());
+
+  CVariant d(a);
+  d.swap(c);
+  EXPECT_EQ(longString, d.asString());
+  EXPECT_EQ(small, c.asString());
+  EXPECT_EQ(small, std::move(c).asString());
+
+  c = std::string("12");
+  EXPECT_EQ(12, c.asInteger());
+  c.clear();
+  EXPECT_TRUE(c.empty());
+  EXPECT_STREQ("", c.c_str());
+}
+
+TEST(TestVariant, MembersInAnyOrder)
+{
+  CVariant a;
+  for (const char* key : {"m", "c", "x", "a", "c", "z", "b"})
+    a[key] = key;
+
+  EXPECT_EQ(6u, a.size());
+  std::string keys;
+  for (auto it = a.begin_map(); it != a.end_map(); ++it)
+  {
+    EXPECT_EQ(it->first, it->second.asString());
+    keys += it->first;
+  }
+  EXPECT_EQ("abcmxz", keys);
+
+  std::map<std::string, CVariant> variantMap;
+  variantMap["x"] = "x";
+  variantMap["a"] = "a";
+  CVariant b(std::move(variantMap));
+  b["m"] = "m";
+  b["c"] = "c";
+  b["z"] = "z";
+  b["b"] = "b";
+  EXPECT_EQ(a, b);
+  b.erase("x");
+  EXPECT_NE(a, b);
+  EXPECT_FALSE(b.isMember("x"));
+}
+
+TEST(TestVariant, MemberReferencesStayValid)
+{
+  // results are commonly built through references to members added before their siblings
+  CVariant a;
+  CVariant& member = a["b"];
+  for (const char* key : {"a", "c", "d"})
+    a[key] = key;
+  member = "b";
+
+  EXPECT_EQ(4u, a.size());
+  EXPECT_EQ("b", a["b"].asString());
+}
@@ -1513,6 +1513,20 @@ int CVideoDatabase::AddToTable(const std::string& table, const std::string& firs
     if (nullptr == m_pDS)
       return -1;
 
+    // tags are deleted by a trigger as soon as they are no longer linked, so don't cache them
+    const bool cacheable = table != "tag";
+    if (cacheable)
+    {
+      const auto tableCache = m_lookupCache.find(table);
+      if (tableCache != m_lookupCache.end())
+      {
+        const auto it = tableCache->second.find(value);
+        if (it != tableCache->second.end())
+          return it->second;
+      }
+    }
+
+    int id;
     std::string strSQL = PrepareSQL("select %s from %s where %s like '%s'", firstField.c_str(), table.c_str(), secondField.c_str(), value.substr(0, 255).c_str());
     m_pDS->query(strSQL);
     if (m_pDS->num_rows() == 0)
@@ -1521,15 +1535,17 @@ int CVideoDatabase::AddToTable(const std::string& table, const std::string& firs
       // doesn't exists, add it
       strSQL = PrepareSQL("insert into %s (%s, %s) values(NULL, '%s')", table.c_str(), firstField.c_str(), secondField.c_str(), value.substr(0, 255).c_str());
       m_pDS->exec(strSQL);
-      int id = (int)m_pDS->lastinsertid();
-      return id;
+      id = (int)m_pDS->lastinsertid();
     }
     else
     {
-      int id = m_pDS->fv(firstField.c_str()).get_asInt();
+      id = m_pDS->fv(firstField.c_str()).get_asInt();
       m_pDS->close();
-      return id;
     }
+
+    if (cacheable)
+      m_lookupCache[table][value] = id;
+    return id;
   }
   catch (...)
   {
@@ -1798,17 +1814,52 @@ void CVideoDatabase::RemoveFromLinkTable(int mediaId, const std::string& mediaTy
   ExecuteQuery(sql);
 }
 
+void CVideoDatabase::AddToLinkTable(int mediaId, const std::string& mediaType, const std::string& table, const std::vector<int>& valueIds, const char *foreignKey)
+{
+  if (valueIds.empty())
+    return;
+
+  const char *key = foreignKey ? foreignKey : table.c_str();
+  std::set<int> linked;
+  std::string sql = PrepareSQL("SELECT %s_id FROM %s_link WHERE media_id=%i AND media_type='%s'", key, table.c_str(), mediaId, mediaType.c_str());
+  m_pDS->query(sql);
+  while (!m_pDS->eof())
+  {
+    linked.insert(m_pDS->fv(0).get_asInt());
+    m_pDS->next();
+  }
+  m_pDS->close();
+
+  std::string values;
+  for (int valueId : valueIds)
+  {
+    if (!linked.insert(valueId).second)
+      continue;
+    if (!values.empty())
+      values += ",";
+    values += PrepareSQL("(%i,%i,'%s')", valueId, mediaId, mediaType.c_str());
+  }
+
+  if (!values.empty())
+  {
+    sql = PrepareSQL("INSERT INTO %s_link (%s_id,media_id,media_type) VALUES ", table.c_str(), key) + values;
+    ExecuteQuery(sql);
+  }
+}
+
 void CVideoDatabase::AddLinksToItem(int mediaId, const std::string& mediaType, const std::string& field, const std::vector<std::string>& values)
 {
+  std::vector<int> valueIds;
   for (const auto &i : values)
   {
     if (!i.empty())
     {
       int idValue = AddToTable(field, field + "_id", "name", i);
       if (idValue > -1)
-        AddToLinkTable(mediaId, mediaType, field, idValue);
+        valueIds.push_back(idValue);
     }
   }
+  AddToLinkTable(mediaId, mediaType, field, valueIds);
 }
 
 void CVideoDatabase::UpdateLinksToItem(int mediaId, const std::string& mediaType, const std::string& field, const std::vector<std::string>& values)
@@ -1821,15 +1872,17 @@ void CVideoDatabase::UpdateLinksToItem(int mediaId, const std::string& mediaType
 
 void CVideoDatabase::AddActorLinksToItem(int mediaId, const std::string& mediaType, const std::string& field, const std::vector<std::string>& values)
 {
+  std::vector<int> actorIds;
   for (const auto &i : values)
   {
     if (!i.empty())
     {
       int idValue = AddActor(i, "");
       if (idValue > -1)
-        AddToLinkTable(mediaId, mediaType, field, idValue, "actor");
+        actorIds.push_back(idValue);
     }
   }
+  AddToLinkTable(mediaId, mediaType, field, actorIds, "actor");
 }
 
 void CVideoDatabase::UpdateActorLinksToItem(int mediaId, const std::string& mediaType, const std::string& field, const std::vector<std::string>& values)
@@ -9402,6 +9455,8 @@ void CVideoDatabase::CleanDatabase(CGUIDialogProgressBarHandle* handle,
     if (nullptr == m_pDS2)
       return;
 
+    m_lookupCache.clear();
+
     auto start = std::chrono::steady_clock::now();
     CLog::Log(LOGINFO, "{}: Starting videodatabase cleanup ..", __FUNCTION__);
     CServiceBroker::GetAnnouncementManager()->Announce(ANNOUNCEMENT::VideoLibrary,
@@ -10823,6 +10878,20 @@ void CVideoDatabase::InvalidatePathHash(const std::string& strPath)
   }
 }
 
+void CVideoDatabase::Close()
+{
+  CDatabase::Close();
+  if (!IsOpen())
+    m_lookupCache.clear();
+}
+
+void CVideoDatabase::RollbackTransaction()
+{
+  CDatabase::RollbackTransaction();
+  // ids inserted within the transaction are gone
+  m_lookupCache.clear();
+}
+
 bool CVideoDatabase::CommitTransaction()
 {
   if (CDatabase::CommitTransaction())
@@ -15,6 +15,7 @@
 #include "utils/SortUtils.h"
 #include "utils/UrlOptions.h"
 
+#include <map>
 #include <memory>
 #include <set>
 #include <utility>
@@ -425,7 +426,9 @@ public:
   ~CVideoDatabase(void) override;
 
   bool Open() override;
+  void Close() override;
   bool CommitTransaction() override;
+  void RollbackTransaction() override;
 
   int AddNewEpisode(int idShow, CVideoInfoTag& details);
 
@@ -1037,6 +1040,10 @@ protected:
   // link functions - these two do all the work
   void AddLinkToActor(int mediaId, const char *mediaType, int actorId, const std::string &role, int order);
   void AddToLinkTable(int mediaId, const std::string& mediaType, const std::string& table, int valueId, const char *foreignKey = NULL);
+  /*! \brief Link several values to an item using a single multi-row insert.
+   Values that are already linked to the item are skipped.
+   */
+  void AddToLinkTable(int mediaId, const std::string& mediaType, const std::string& table, const std::vector<int>& valueIds, const char *foreignKey = NULL);
   void RemoveFromLinkTable(int mediaId, const std::string& mediaType, const std::string& table, int valueId, const char *foreignKey = NULL);
 
   void AddLinksToItem(int mediaId, const std::string& mediaType, const std::string& field, const std::vector<std::string>& values);
@@ -1151,4 +1158,10 @@ private:
   static void AnnounceUpdate(const std::string& content, int id);
 
   static CDateTime GetDateAdded(const std::string& filename, CDateTime dateAdded = CDateTime());
+
+  /*! \brief Ids of the values of the genre, studio, country etc. lookup tables added or found by
+   AddToTable(), per table. Cleared when the database is closed, cleaned or a transaction is
+   rolled back.
+   */
+  std::map<std::string, std::map<std::string, int>> m_lookupCache;
 };
@@ -37,6 +37,7 @@
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
 #include "tags/VideoInfoTagLoaderFactory.h"
+#include "utils/ContentChangeJournal.h"
 #include "utils/Digest.h"
 #include "utils/FileExtensionProvider.h"
 #include "utils/RegExp.h"
@@ -47,6 +48,7 @@
 #include "video/VideoThumbLoader.h"
 
 #include <algorithm>
+#include <ctime>
 #include <utility>
 
 using namespace XFILE;
@@ -1120,7 +1122,7 @@ namespace VIDEO
 
   bool CVideoInfoScanner::EnumerateEpisodeItem(const CFileItem *item, EPISODELIST& episodeList)
   {
-    SETTINGS_TVSHOWLIST expression = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_tvshowEnumRegExps;
+    const SETTINGS_TVSHOWLIST& expression = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_tvshowEnumRegExps;
 
     std::string strLabel;
 
@@ -1138,8 +1140,9 @@ namespace VIDEO
 
     for (unsigned int i=0;i<expression.size();++i)
     {
+      // compiled patterns are cached, so the expressions are only compiled and studied once
       CRegExp reg(true, CRegExp::autoUtf8);
-      if (!reg.RegComp(expression[i].regexp))
+      if (!reg.RegComp(expression[i].regexp, CRegExp::StudyWithJitComp))
         continue;
 
       int regexppos, regexp2pos;
@@ -1220,7 +1223,7 @@ namespace VIDEO
 
       CRegExp reg2(true, CRegExp::autoUtf8);
       // check the remainder of the string for any further episodes.
-      if (!byDate && reg2.RegComp(CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_tvshowMultiPartEnumRegExp))
+      if (!byDate && reg2.RegComp(CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_tvshowMultiPartEnumRegExp, CRegExp::StudyWithJitComp))
       {
         int offset = 0;
 
@@ -2029,6 +2032,16 @@ namespace VIDEO
   std::string CVideoInfoScanner::GetFastHash(const std::string &directory,
       const std::vector<std::string> &excludes) const
   {
+    // reuse the hash of a local directory that didn't change since it was last computed with the
+    // same excludes
+    const std::shared_ptr<CContentChangeJournal> journal = CServiceBroker::GetContentChangeJournal();
+    const std::string options = "fast|" + StringUtils::Join(excludes, "|");
+    std::string hash = journal ? journal->GetHash(directory, options) : "";
+    if (!hash.empty())
+      return hash;
+
+    const bool tracked = journal && journal->Track(directory);
+
     CDigest digest{CDigest::Type::MD5};
 
     if (excludes.size())
@@ -2043,7 +2056,10 @@ namespace VIDEO
       if (time)
       {
         digest.Update((unsigned char *)&time, sizeof(time));
-        return digest.Finalize();
+        hash = digest.Finalize();
+        if (tracked)
+          journal->SetHash(directory, hash, options);
+        return hash;
       }
     }
     return "";
@@ -2052,10 +2068,24 @@ namespace VIDEO
   std::string CVideoInfoScanner::GetRecursiveFastHash(const std::string &directory,
       const std::vector<std::string> &excludes) const
   {
+    // reuse the hash of a local directory tree that didn't change since it was last computed with
+    // the same excludes
+    const std::shared_ptr<CContentChangeJournal> journal = CServiceBroker::GetContentChangeJournal();
+    const std::string options = "recursive|" + StringUtils::Join(excludes, "|");
+    std::string hash = journal ? journal->GetHash(directory, options) : "";
+    if (!hash.empty())
+      return hash;
+
+    const int64_t listingStart = static_cast<int64_t>(std::time(nullptr));
     CFileItemList items;
     items.Add(CFileItemPtr(new CFileItem(directory, true)));
     CUtil::GetRecursiveDirsListing(directory, items, DIR_FLAG_NO_FILE_DIRS | DIR_FLAG_NO_FILE_INFO);
 
+    std::vector<std::string> subDirs;
+    for (int i = 1; i < items.Size(); ++i)
+      subDirs.push_back(items[i]->GetPath());
+    bool tracked = journal && journal->Track(directory, subDirs);
+
     CDigest digest{CDigest::Type::MD5};
 
     if (excludes.size())
@@ -2076,12 +2106,19 @@ namespace VIDEO
 
       if (!stat_time)
         return "";
+
+      // changed while being listed, a subdirectory created meanwhile might not be watched
+      if (stat_time >= listingStart - 1)
+        tracked = false;
     }
 
     if (time)
     {
       digest.Update((unsigned char *)&time, sizeof(time));
-      return digest.Finalize();
+      hash = digest.Finalize();
+      if (tracked)
+        journal->SetHash(directory, hash, options);
+      return hash;
     }
     return "";
   }